@@ -2100,6 +2100,8 @@ static void blackboxLogIteration(timeUs_t currentTimeUs)
 #endif
     }
 
+    blackboxDeviceEndIteration();
+
     //Flush every iteration so that our runtime variance is minimized
     blackboxDeviceFlush();
 }
@@ -35,6 +35,8 @@
 #include "config/parameter_group.h"
 #include "config/parameter_group_ids.h"
 
+#include "drivers/time.h"
+
 #include "io/asyncfatfs/asyncfatfs.h"
 #include "io/flashfs.h"
 #include "io/serial.h"
@@ -52,6 +54,9 @@ static uint8_t blackboxMaxHeaderBytesPerIteration;
 // How many bytes can we write *this* iteration without overflowing transmit buffers or overstressing the OpenLog?
 int32_t blackboxHeaderBudget;
 
+static blackboxDeviceStats_t blackboxDeviceStats;
+static uint32_t blackboxBytesDroppedBeforeIteration;
+
 STATIC_UNIT_TESTED serialPort_t *blackboxPort = NULL;
 #ifndef UNIT_TEST
 static portSharing_e blackboxPortSharing;
@@ -97,7 +102,10 @@ void blackboxWrite(uint8_t value)
 #endif
 #ifdef USE_SDCARD
     case BLACKBOX_DEVICE_SDCARD:
-        afatfs_fputc(blackboxSDCard.logFile, value);
+        if (!afatfs_fputc(blackboxSDCard.logFile, value)) {
+            blackboxDeviceStats.bytesDropped++;
+            return;
+        }
         break;
 #endif
     case BLACKBOX_DEVICE_SERIAL:
@@ -105,12 +113,15 @@ void blackboxWrite(uint8_t value)
         serialWrite(blackboxPort, value);
         break;
     }
+
+    blackboxDeviceStats.bytesWritten++;
 }
 
 // Print the null-terminated string 's' to the blackbox device and return the number of bytes written
 int blackboxPrint(const char *s)
 {
     int length;
+    int dropped = 0;
     const uint8_t *pos;
 
     switch (blackboxConfig()->device) {
@@ -125,7 +136,7 @@ int blackboxPrint(const char *s)
 #ifdef USE_SDCARD
     case BLACKBOX_DEVICE_SDCARD:
         length = strlen(s);
-        afatfs_fwrite(blackboxSDCard.logFile, (const uint8_t*) s, length); // Ignore failures due to buffers filling up
+        dropped = length - afatfs_fwrite(blackboxSDCard.logFile, (const uint8_t*) s, length); // Failures due to buffers filling up are only counted
         break;
 #endif
 
@@ -141,9 +152,31 @@ int blackboxPrint(const char *s)
         break;
     }
 
+    blackboxDeviceStats.bytesWritten += length - dropped;
+    blackboxDeviceStats.bytesDropped += dropped;
+
     return length;
 }
 
+/**
+ * Call at the end of each logging iteration to account for iterations that lost data.
+ */
+void blackboxDeviceEndIteration(void)
+{
+    if (blackboxDeviceStats.bytesDropped != blackboxBytesDroppedBeforeIteration) {
+        blackboxDeviceStats.iterationsDropped++;
+        blackboxBytesDroppedBeforeIteration = blackboxDeviceStats.bytesDropped;
+    }
+}
+
+/**
+ * Write statistics of the current log, or of the last one once logging stopped.
+ */
+const blackboxDeviceStats_t *blackboxDeviceGetStats(void)
+{
+    return &blackboxDeviceStats;
+}
+
 /**
  * If there is data waiting to be written to the blackbox device, attempt to write (a portion of) that now.
  *
@@ -203,6 +236,10 @@ bool blackboxDeviceFlushForce(void)
 #ifndef UNIT_TEST
 bool blackboxDeviceOpen(void)
 {
+    memset(&blackboxDeviceStats, 0, sizeof(blackboxDeviceStats));
+    blackboxDeviceStats.logStartMs = millis();
+    blackboxBytesDroppedBeforeIteration = 0;
+
     switch (blackboxConfig()->device) {
     case BLACKBOX_DEVICE_SERIAL:
         {
@@ -251,6 +288,11 @@ bool blackboxDeviceOpen(void)
             return false;
         }
 
+        {
+            dateTime_t startTime;
+            flashfsLogIndexBegin(rtcGetDateTimeLocal(&startTime) ? &startTime : NULL);
+        }
+
         blackboxMaxHeaderBytesPerIteration = BLACKBOX_TARGET_HEADER_BUDGET_PER_ITERATION;
 
         return true;
@@ -279,6 +321,8 @@ bool blackboxDeviceOpen(void)
 #ifndef UNIT_TEST
 void blackboxDeviceClose(void)
 {
+    blackboxDeviceStats.logEndMs = millis();
+
     switch (blackboxConfig()->device) {
     case BLACKBOX_DEVICE_SERIAL:
         // Since the serial port could be shared with other processes, we have to give it back here
@@ -297,6 +341,7 @@ void blackboxDeviceClose(void)
     case BLACKBOX_DEVICE_FLASH:
         // Some flash device, e.g., NAND devices, require explicit close to flush internally buffered data.
         flashfsClose();
+        flashfsLogIndexEnd();
         break;
 #endif
     default:
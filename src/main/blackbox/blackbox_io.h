@@ -22,6 +22,8 @@
 
 #include "platform.h"
 
+#include "common/time.h"
+
 typedef enum BlackboxDevice {
     BLACKBOX_DEVICE_SERIAL = 0,
 
@@ -53,12 +55,22 @@ typedef enum {
  */
 #define BLACKBOX_TARGET_HEADER_BUDGET_PER_ITERATION 64
 
+typedef struct blackboxDeviceStats_s {
+    uint32_t bytesWritten;
+    uint32_t bytesDropped;          // Bytes the device had no room for, only known for SD cards
+    uint32_t iterationsDropped;     // Logging iterations that lost some of their data
+    timeMs_t logStartMs;
+    timeMs_t logEndMs;              // 0 while the log is open
+} blackboxDeviceStats_t;
+
 extern int32_t blackboxHeaderBudget;
 
 void blackboxOpen(void);
 void blackboxWrite(uint8_t value);
 
 void blackboxDeviceFlush(void);
+void blackboxDeviceEndIteration(void);
+const blackboxDeviceStats_t *blackboxDeviceGetStats(void);
 bool blackboxDeviceFlushForce(void);
 bool blackboxDeviceOpen(void);
 void blackboxDeviceClose(void);
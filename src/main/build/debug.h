@@ -72,5 +72,11 @@ typedef enum {
     DEBUG_RATE_DYNAMICS,
     DEBUG_LANDING,
     DEBUG_POS_EST,
+    DEBUG_MSP_DISPLAYPORT,
+    DEBUG_MAVLINK_TELEMETRY,
+    DEBUG_RX_LATENCY,
+    DEBUG_LOGIC_CONDITIONS,
+    DEBUG_MOTOR_UPDATE,
+    DEBUG_LOOP_PROFILE,
     DEBUG_COUNT
 } debugType_e;
@@ -47,19 +47,11 @@
 #ifdef USE_FLASHFS
 static long cmsx_EraseFlash(displayPort_t *pDisplay, const void *ptr)
 {
+    UNUSED(pDisplay);
     UNUSED(ptr);
 
-    displayClearScreen(pDisplay);
-    displayWrite(pDisplay, 5, 3, "ERASING FLASH...");
-    displayResync(pDisplay); // Was max7456RefreshAll(); Why at this timing?
-
-    flashfsEraseCompletely();
-    while (!flashIsReady()) {
-        delay(100);
-    }
-
-    displayClearScreen(pDisplay);
-    displayResync(pDisplay); // Was max7456RefreshAll(); wedges during heavy SPI?
+    // Erases in the background, logging can start right away
+    flashfsEraseAsync();
 
     return 0;
 }
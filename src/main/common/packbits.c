@@ -0,0 +1,96 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "packbits.h"
+
+#define PACKBITS_MAX_BLOCK      128
+#define PACKBITS_MIN_RUN        3   // Shorter runs are cheaper to keep in a literal block
+
+int packbitsEncode(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstSize)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < srcLen) {
+        size_t run = 1;
+        while (in + run < srcLen && run < PACKBITS_MAX_BLOCK && src[in + run] == src[in]) {
+            run++;
+        }
+
+        if (run >= PACKBITS_MIN_RUN) {
+            if (out + 2 > dstSize) {
+                return -1;
+            }
+            dst[out++] = (uint8_t)(257 - run);
+            dst[out++] = src[in];
+            in += run;
+            continue;
+        }
+
+        // Collect literals up to the start of the next run worth encoding
+        size_t literals = 0;
+        while (in + literals < srcLen && literals < PACKBITS_MAX_BLOCK) {
+            const uint8_t *p = &src[in + literals];
+            if (in + literals + 2 < srcLen && p[0] == p[1] && p[0] == p[2]) {
+                break;
+            }
+            literals++;
+        }
+
+        if (out + 1 + literals > dstSize) {
+            return -1;
+        }
+        dst[out++] = (uint8_t)(literals - 1);
+        memcpy(&dst[out], &src[in], literals);
+        out += literals;
+        in += literals;
+    }
+
+    return out;
+}
+
+int packbitsDecode(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstSize)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < srcLen) {
+        const int8_t control = (int8_t)src[in++];
+
+        if (control >= 0) {
+            const size_t count = control + 1;
+            if (in + count > srcLen || out + count > dstSize) {
+                return -1;
+            }
+            memcpy(&dst[out], &src[in], count);
+            in += count;
+            out += count;
+        } else if (control != -128) {
+            const size_t count = 1 - control;
+            if (in >= srcLen || out + count > dstSize) {
+                return -1;
+            }
+            memset(&dst[out], src[in++], count);
+            out += count;
+        }
+    }
+
+    return out;
+}
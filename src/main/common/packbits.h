@@ -0,0 +1,35 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * PackBits run-length coding. Each block starts with a signed control byte n:
+ *  0..127   - n + 1 literal bytes follow
+ *  -1..-127 - the next byte is repeated 1 - n times
+ *  -128     - no operation
+ * Worst case output is one byte longer per 128 bytes of input.
+ */
+
+#define PACKBITS_MAX_ENCODED_SIZE(len)  ((len) + ((len) + 127) / 128)
+
+// Return the number of bytes written to dst, or -1 if the output doesn't fit in dstSize
+int packbitsEncode(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstSize);
+int packbitsDecode(const uint8_t *src, size_t srcLen, uint8_t *dst, size_t dstSize);
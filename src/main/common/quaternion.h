@@ -151,15 +151,46 @@ static inline fpQuaternion_t * quaternionNormalize(fpQuaternion_t * result, cons
         result->q3 = 0;
     }
     else {
-        result->q0 = q->q0 / mod;
-        result->q1 = q->q1 / mod;
-        result->q2 = q->q2 / mod;
-        result->q3 = q->q3 / mod;
+        const float invMod = 1.0f / mod;
+        result->q0 = q->q0 * invMod;
+        result->q1 = q->q1 * invMod;
+        result->q2 = q->q2 * invMod;
+        result->q3 = q->q3 * invMod;
     }
 
     return result;
 }
 
+static inline void quaternionToRotationMatrix(float rmat[3][3], const fpQuaternion_t * q)
+{
+    // Doubled components let every matrix element be built from a single product
+    const float q1x2 = 2.0f * q->q1;
+    const float q2x2 = 2.0f * q->q2;
+    const float q3x2 = 2.0f * q->q3;
+
+    const float q0q1x2 = q->q0 * q1x2;
+    const float q0q2x2 = q->q0 * q2x2;
+    const float q0q3x2 = q->q0 * q3x2;
+    const float q1q1x2 = q->q1 * q1x2;
+    const float q1q2x2 = q->q1 * q2x2;
+    const float q1q3x2 = q->q1 * q3x2;
+    const float q2q2x2 = q->q2 * q2x2;
+    const float q2q3x2 = q->q2 * q3x2;
+    const float q3q3x2 = q->q3 * q3x2;
+
+    rmat[0][0] = 1.0f - q2q2x2 - q3q3x2;
+    rmat[0][1] = q1q2x2 - q0q3x2;
+    rmat[0][2] = q1q3x2 + q0q2x2;
+
+    rmat[1][0] = q1q2x2 + q0q3x2;
+    rmat[1][1] = 1.0f - q1q1x2 - q3q3x2;
+    rmat[1][2] = q2q3x2 - q0q1x2;
+
+    rmat[2][0] = q1q3x2 - q0q2x2;
+    rmat[2][1] = q2q3x2 + q0q1x2;
+    rmat[2][2] = 1.0f - q1q1x2 - q2q2x2;
+}
+
 static inline fpVector3_t * quaternionRotateVector(fpVector3_t * result, const fpVector3_t * vect, const fpQuaternion_t * ref)
 {
     fpQuaternion_t vectQuat, refConj;
@@ -121,7 +121,9 @@
 #define PG_OSD_COMMON_CONFIG 1031
 #define PG_TIMER_OVERRIDE_CONFIG 1032
 #define PG_EZ_TUNE 1033
-#define PG_INAV_END PG_EZ_TUNE
+#define PG_SYSTEM_ID_CONFIG 1034
+#define PG_GAIN_SCHEDULE_CONFIG 1035
+#define PG_INAV_END PG_GAIN_SCHEDULE_CONFIG
 
 // OSD configuration (subject to change)
 //#define PG_OSD_FONT_CONFIG 2047
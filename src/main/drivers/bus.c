@@ -31,6 +31,7 @@
 
 #include "drivers/bus.h"
 #include "drivers/io.h"
+#include "drivers/time.h"
 
 #define BUSDEV_MAX_DEVICES 16
 
@@ -132,6 +133,8 @@ busDevice_t * busDeviceInit(busType_e bus, devHardwareType_e hw, uint8_t tag, re
                 dev->busType = descriptor->busType;
                 dev->flags = descriptor->flags;
                 dev->param = descriptor->param;
+                dev->owner = owner;
+                dev->stats = descriptor->statsPtr;
 
                 switch (descriptor->busType) {
                     default:
@@ -439,3 +442,35 @@ bool busIsBusy(const busDevice_t * dev)
             return false;
     }
 }
+
+void busDeviceAccountTransfer(const busDevice_t * dev, uint32_t startTicks)
+{
+    busDeviceStats_t * stats = dev->stats;
+    stats->transfers++;
+    stats->busyTicks += ticks() - startTicks;
+}
+
+int busDeviceRegistrySize(void)
+{
+#if defined(SITL_BUILD)
+    return 0;
+#else
+    return __busdev_registry_end - __busdev_registry_start;
+#endif
+}
+
+const busDevice_t * busDeviceByRegistryIndex(int index)
+{
+#if defined(SITL_BUILD)
+    UNUSED(index);
+#else
+    if (index >= 0 && index < busDeviceRegistrySize()) {
+        const busDeviceDescriptor_t * descriptor = &__busdev_registry_start[index];
+        const busDevice_t * dev = descriptor->devicePtr;
+        if (dev && dev->descriptorPtr == descriptor && dev->busType != BUSTYPE_NONE) {
+            return dev;
+        }
+    }
+#endif
+    return NULL;
+}
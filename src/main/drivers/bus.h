@@ -156,8 +156,15 @@ typedef enum {
     DEVFLAGS_SPI_MODE_0                 = (1 << 2),     // (SPI only) Use CPOL=0/CPHA=0 (if unset MODE3 is used - CPOL=1/CPHA=1)
 } deviceFlags_e;
 
+typedef struct busDeviceStats_s {
+    uint32_t transfers;             // Number of transactions (SPI chip select cycles, I2C transfers)
+    uint64_t busyTicks;             // Total time the device held the bus, in cycle counter ticks
+    uint32_t transferStartTicks;
+} busDeviceStats_t;
+
 typedef struct busDeviceDescriptor_s {
     void *              devicePtr;
+    busDeviceStats_t *  statsPtr;
     busType_e           busType;
     devHardwareType_e   devHwType;
     uint8_t             flags;
@@ -203,6 +210,8 @@ typedef struct busDevice_s {
     uint32_t * scratchpad;          // Memory where device driver can store persistent data. Zeroed out when initializing the device
                                     // for the first time. Useful when once device is shared between several sensors
                                     // (like MPU/ICM acc-gyro sensors)
+    resourceOwner_e owner;          // Owner the device was initialized for
+    busDeviceStats_t * stats;       // Bus usage accounting, kept outside of the device so it can be updated through a const device pointer
 } busDevice_t;
 
 #ifdef __APPLE__
@@ -219,8 +228,10 @@ extern const busDeviceDescriptor_t __busdev_registry_end[];
 #define BUSDEV_REGISTER_SPI_F(_name, _devHw, _spiBus, _csnPin, _irqPin, _tag, _flags, _param)   \
     extern const busDeviceDescriptor_t _name ## _registry;                                      \
     static busDevice_t _name ## _memory;                                                        \
+    static busDeviceStats_t _name ## _stats;                                                    \
     const busDeviceDescriptor_t _name ## _registry BUSDEV_REGISTER_ATTRIBUTES = {               \
         .devicePtr = (void *) & _name ## _memory,                                               \
+        .statsPtr = & _name ## _stats,                                                          \
         .busType = BUSTYPE_SPI,                                                                 \
         .devHwType = _devHw,                                                                    \
         .flags = _flags,                                                                        \
@@ -249,8 +260,10 @@ extern const busDeviceDescriptor_t __busdev_registry_end[];
 #define BUSDEV_REGISTER_I2C_F(_name, _devHw, _i2cBus, _devAddr, _irqPin, _tag, _flags, _param)  \
     extern const busDeviceDescriptor_t _name ## _registry;                                      \
     static busDevice_t _name ## _memory;                                                        \
+    static busDeviceStats_t _name ## _stats;                                                    \
     const busDeviceDescriptor_t _name ## _registry BUSDEV_REGISTER_ATTRIBUTES = {               \
         .devicePtr = (void *) & _name ## _memory,                                               \
+        .statsPtr = & _name ## _stats,                                                          \
         .busType = BUSTYPE_I2C,                                                                 \
         .devHwType = _devHw,                                                                    \
         .flags = _flags,                                                                        \
@@ -329,3 +342,8 @@ bool busTransfer(const busDevice_t * dev, uint8_t * rxBuf, const uint8_t * txBuf
 bool busTransferMultiple(const busDevice_t * dev, busTransferDescriptor_t * buffers, int count);
 
 bool busIsBusy(const busDevice_t * dev);
+
+/* Bus usage accounting */
+void busDeviceAccountTransfer(const busDevice_t * dev, uint32_t startTicks);
+int busDeviceRegistrySize(void);
+const busDevice_t * busDeviceByRegistryIndex(int index);   // NULL if the device is not initialized
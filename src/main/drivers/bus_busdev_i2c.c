@@ -29,29 +29,42 @@
 
 #include "drivers/bus.h"
 #include "drivers/bus_i2c.h"
+#include "drivers/time.h"
 
 bool i2cBusWriteBuffer(const busDevice_t * dev, uint8_t reg, const uint8_t * data, uint8_t length)
 {
     const bool allowRawAccess = (dev->flags & DEVFLAGS_USE_RAW_REGISTERS);
-    return i2cWriteBuffer(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, length, data, allowRawAccess);
+    const uint32_t startTicks = ticks();
+    const bool ack = i2cWriteBuffer(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, length, data, allowRawAccess);
+    busDeviceAccountTransfer(dev, startTicks);
+    return ack;
 }
 
 bool i2cBusWriteRegister(const busDevice_t * dev, uint8_t reg, uint8_t data)
 {
     const bool allowRawAccess = (dev->flags & DEVFLAGS_USE_RAW_REGISTERS);
-    return i2cWrite(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, data, allowRawAccess);
+    const uint32_t startTicks = ticks();
+    const bool ack = i2cWrite(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, data, allowRawAccess);
+    busDeviceAccountTransfer(dev, startTicks);
+    return ack;
 }
 
 bool i2cBusReadBuffer(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t length)
 {
     const bool allowRawAccess = (dev->flags & DEVFLAGS_USE_RAW_REGISTERS);
-    return i2cRead(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, length, data, allowRawAccess);
+    const uint32_t startTicks = ticks();
+    const bool ack = i2cRead(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, length, data, allowRawAccess);
+    busDeviceAccountTransfer(dev, startTicks);
+    return ack;
 }
 
 bool i2cBusReadRegister(const busDevice_t * dev, uint8_t reg, uint8_t * data)
 {
     const bool allowRawAccess = (dev->flags & DEVFLAGS_USE_RAW_REGISTERS);
-    return i2cRead(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, 1, data, allowRawAccess);
+    const uint32_t startTicks = ticks();
+    const bool ack = i2cRead(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, 1, data, allowRawAccess);
+    busDeviceAccountTransfer(dev, startTicks);
+    return ack;
 }
 bool i2cBusBusy(const busDevice_t *dev, bool *error)
 {   
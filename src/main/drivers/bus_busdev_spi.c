@@ -49,6 +49,7 @@ bool spiBusInitHost(const busDevice_t * dev)
 
 void spiBusSelectDevice(const busDevice_t * dev)
 {
+    dev->stats->transferStartTicks = ticks();
     IOLo(dev->busdev.spi.csnPin);
     spiChipSelectSetupDelay();
 }
@@ -57,6 +58,8 @@ void spiBusDeselectDevice(const busDevice_t * dev)
 {
     spiChipSelectHoldTime();
     IOHi(dev->busdev.spi.csnPin);
+    // The bus is occupied for as long as the chip select is held
+    busDeviceAccountTransfer(dev, dev->stats->transferStartTicks);
 }
 
 void spiBusSetSpeed(const busDevice_t * dev, busSpeed_e speed)
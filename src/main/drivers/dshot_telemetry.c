@@ -0,0 +1,201 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#include "common/maths.h"
+
+#ifdef USE_DSHOT_TELEMETRY
+
+#include "drivers/dshot_telemetry.h"
+
+#define GCR_INVALID     0xFF
+
+// 5 bit GCR symbol to nibble
+static const uint8_t gcrDecodeTable[32] = {
+    GCR_INVALID, GCR_INVALID, GCR_INVALID, GCR_INVALID, GCR_INVALID, GCR_INVALID, GCR_INVALID, GCR_INVALID,
+    GCR_INVALID, 0x9,         0xA,         0xB,         GCR_INVALID, 0xD,         0xE,         0xF,
+    GCR_INVALID, GCR_INVALID, 0x2,         0x3,         GCR_INVALID, 0x5,         0x6,         0x7,
+    GCR_INVALID, 0x0,         0x8,         0x1,         GCR_INVALID, 0x4,         0xC,         GCR_INVALID,
+};
+
+typedef struct dshotTelemetryMotor_s {
+    bool valid;
+    uint32_t erpm;
+    timeUs_t lastFrameUs;
+    dshotTelemetryStats_t stats;
+} dshotTelemetryMotor_t;
+
+static dshotTelemetryMotor_t dshotTelemetryMotors[DSHOT_TELEMETRY_MAX_MOTORS];
+static bool dshotTelemetryEnabled;
+
+/*
+ * Each edge is a transition and starts a run of bits: a 1 followed by as many 0 as the run is long.
+ * The timer counter may wrap during the frame, 16 bit differences take care of that.
+ * The frame ends after 21 bits. A run reaching past that is the line going back to idle after the
+ * reply, it is cut at the frame end and any later edges are ignored.
+ */
+uint32_t dshotTelemetryEdgesToGcr(const uint16_t *edgeTicks, int edgeCount, uint16_t bitTicks)
+{
+    if (edgeCount < 1 || edgeCount > DSHOT_TELEMETRY_MAX_EDGES || bitTicks == 0) {
+        return DSHOT_TELEMETRY_INVALID;
+    }
+
+    uint32_t value = 0;
+    int bits = 0;
+
+    for (int i = 1; i <= edgeCount; i++) {
+        int runLength;
+
+        if (i < edgeCount) {
+            const uint16_t deltaTicks = edgeTicks[i] - edgeTicks[i - 1];
+            runLength = (deltaTicks + bitTicks / 2) / bitTicks;
+        } else {
+            // No transitions after the last edge, the line holds its level to the end of the frame
+            runLength = DSHOT_TELEMETRY_FRAME_BITS - bits;
+        }
+
+        if (runLength < 1) {
+            return DSHOT_TELEMETRY_INVALID;
+        }
+
+        runLength = MIN(runLength, DSHOT_TELEMETRY_FRAME_BITS - bits);
+        value = (value << runLength) | (1 << (runLength - 1));
+        bits += runLength;
+
+        if (bits == DSHOT_TELEMETRY_FRAME_BITS) {
+            break;
+        }
+    }
+
+    return value;
+}
+
+bool dshotTelemetryGcrToFrame(uint32_t gcr, uint16_t *frame)
+{
+    uint16_t value = 0;
+
+    for (int nibble = 0; nibble < 4; nibble++) {
+        const uint8_t decoded = gcrDecodeTable[(gcr >> (nibble * 5)) & 0x1F];
+        if (decoded == GCR_INVALID) {
+            return false;
+        }
+        value |= decoded << (nibble * 4);
+    }
+
+    // Bidirectional DShot uses an inverted checksum, all four nibbles XOR to 0xF
+    const uint16_t checksum = value ^ (value >> 4) ^ (value >> 8) ^ (value >> 12);
+    if ((checksum & 0x0F) != 0x0F) {
+        return false;
+    }
+
+    *frame = value;
+    return true;
+}
+
+uint32_t dshotTelemetryFrameToErpm(uint16_t frame)
+{
+    const uint16_t value = frame >> 4;
+
+    // Longest possible period, the motor is not turning
+    if (value == 0x0FFF) {
+        return 0;
+    }
+
+    const uint32_t periodUs = (value & 0x01FF) << (value >> 9);
+    if (periodUs == 0) {
+        return DSHOT_TELEMETRY_INVALID;
+    }
+
+    return (60000000 + periodUs / 2) / periodUs;
+}
+
+uint32_t dshotTelemetryDecodeEdges(const uint16_t *edgeTicks, int edgeCount, uint16_t bitTicks)
+{
+    const uint32_t gcr = dshotTelemetryEdgesToGcr(edgeTicks, edgeCount, bitTicks);
+    if (gcr == DSHOT_TELEMETRY_INVALID) {
+        return DSHOT_TELEMETRY_INVALID;
+    }
+
+    uint16_t frame;
+    if (!dshotTelemetryGcrToFrame(gcr, &frame)) {
+        return DSHOT_TELEMETRY_INVALID;
+    }
+
+    return dshotTelemetryFrameToErpm(frame);
+}
+
+void dshotTelemetryProcessEdges(uint8_t motor, const uint16_t *edgeTicks, int edgeCount, uint16_t bitTicks, timeUs_t currentTimeUs)
+{
+    if (motor >= DSHOT_TELEMETRY_MAX_MOTORS) {
+        return;
+    }
+
+    dshotTelemetryMotor_t *state = &dshotTelemetryMotors[motor];
+    const uint32_t erpm = dshotTelemetryDecodeEdges(edgeTicks, edgeCount, bitTicks);
+
+    if (erpm == DSHOT_TELEMETRY_INVALID) {
+        state->stats.invalidFrames++;
+        return;
+    }
+
+    state->erpm = erpm;
+    state->lastFrameUs = currentTimeUs;
+    state->valid = true;
+    state->stats.validFrames++;
+}
+
+void dshotTelemetryEnable(bool enabled)
+{
+    dshotTelemetryEnabled = enabled;
+    memset(dshotTelemetryMotors, 0, sizeof(dshotTelemetryMotors));
+}
+
+bool dshotTelemetryIsEnabled(void)
+{
+    return dshotTelemetryEnabled;
+}
+
+bool dshotTelemetryGetErpm(uint8_t motor, timeUs_t currentTimeUs, uint32_t *erpm)
+{
+    if (!dshotTelemetryEnabled || motor >= DSHOT_TELEMETRY_MAX_MOTORS) {
+        return false;
+    }
+
+    const dshotTelemetryMotor_t *state = &dshotTelemetryMotors[motor];
+    if (!state->valid || cmpTimeUs(currentTimeUs, state->lastFrameUs) > DSHOT_TELEMETRY_TIMEOUT_US) {
+        return false;
+    }
+
+    *erpm = state->erpm;
+    return true;
+}
+
+void dshotTelemetryGetStats(uint8_t motor, dshotTelemetryStats_t *stats)
+{
+    if (motor < DSHOT_TELEMETRY_MAX_MOTORS) {
+        *stats = dshotTelemetryMotors[motor].stats;
+    } else {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+/*
+ * Bidirectional DShot telemetry. After each (inverted) DShot frame the ESC replies on the same wire
+ * with a 21 bit frame at 5/4 of the DShot bitrate: a start transition followed by 20 GCR bits, where
+ * a transition encodes a 1. The GCR bits carry 16 bits: a 12 bit eRPM period (3 bit exponent, 9 bit
+ * mantissa, in microseconds) and an inverted 4 bit checksum.
+ */
+
+#define DSHOT_TELEMETRY_FRAME_BITS      21
+#define DSHOT_TELEMETRY_MAX_EDGES       DSHOT_TELEMETRY_FRAME_BITS
+#define DSHOT_TELEMETRY_INVALID         UINT32_MAX
+#define DSHOT_TELEMETRY_MAX_MOTORS      12
+#define DSHOT_TELEMETRY_TIMEOUT_US      100000
+
+typedef struct dshotTelemetryStats_s {
+    uint32_t validFrames;
+    uint32_t invalidFrames;
+} dshotTelemetryStats_t;
+
+// Decoding steps, each returns DSHOT_TELEMETRY_INVALID (or false) on a malformed frame
+uint32_t dshotTelemetryEdgesToGcr(const uint16_t *edgeTicks, int edgeCount, uint16_t bitTicks);
+bool dshotTelemetryGcrToFrame(uint32_t gcr, uint16_t *frame);
+uint32_t dshotTelemetryFrameToErpm(uint16_t frame);
+uint32_t dshotTelemetryDecodeEdges(const uint16_t *edgeTicks, int edgeCount, uint16_t bitTicks);
+
+/*
+ * Called by the output driver with the capture timestamps of all transitions of one reply,
+ * before it sends the next frame on that motor.
+ */
+void dshotTelemetryProcessEdges(uint8_t motor, const uint16_t *edgeTicks, int edgeCount, uint16_t bitTicks, timeUs_t currentTimeUs);
+
+void dshotTelemetryEnable(bool enabled);
+bool dshotTelemetryIsEnabled(void);
+bool dshotTelemetryGetErpm(uint8_t motor, timeUs_t currentTimeUs, uint32_t *erpm);
+void dshotTelemetryGetStats(uint8_t motor, dshotTelemetryStats_t *stats);
@@ -38,6 +38,8 @@
 #include "drivers/io.h"
 #include "drivers/time.h"
 
+#include "io/flashfs.h"
+
 static flashDriver_t flashDrivers[] = {
 
 #ifdef USE_SPI
@@ -214,6 +216,7 @@ static void flashConfigurePartitions(void)
 #endif
 
 #ifdef USE_FLASHFS
+    createPartition(FLASH_PARTITION_TYPE_FLASHFS_INDEX, flashfsLogIndexPartitionSize(flashGeometry), &endSector);
     flashPartitionSet(FLASH_PARTITION_TYPE_FLASHFS, startSector, endSector);
 #endif
 }
@@ -263,9 +266,14 @@ static const char *flashPartitionNames[] = {
     "BBMGMT   ",
     "FIRMWARE ",
     "CONFIG   ",
+    "BACKUP   ",
+    "FW META  ",
     "FW UPDT  ",
+    "LOGINDEX ",
 };
 
+STATIC_ASSERT(ARRAYLEN(flashPartitionNames) == FLASH_MAX_PARTITIONS, flash_partition_names_out_of_sync);
+
 const char *flashPartitionGetTypeName(flashPartitionType_e type)
 {
     if (type < ARRAYLEN(flashPartitionNames)) {
@@ -190,10 +190,14 @@
 // is faster than redrawing the whole screen on each frame.
 static BITARRAY_DECLARE(screenIsDirty, MAX7456_BUFFER_CHARS_PAL);
 
-//max chars to update in one idle
+//max chars to update in one idle, when each one is written individually
 #define MAX_CHARS2UPDATE        10
 #define BYTES_PER_CHAR2UPDATE   (7 * 2) // SPI regs + values for them
 
+// A run costs DMAH, DMAL, DMM, the terminator and restoring DMM on top of 2 bytes
+// per character, individual writes cost 6 bytes each. Runs pay off from 3 characters on.
+#define MAX7456_MIN_AUTOINCREMENT_RUN 3
+
 typedef struct max7456Registers_s {
     uint8_t vm0;
     uint8_t dmm;
@@ -483,6 +487,24 @@ void max7456Write(uint8_t x, uint8_t y, const char *buff, uint8_t mode)
     }
 }
 
+// Returns how many dirty characters starting at pos can be sent as a single
+// auto-increment run: consecutive, non-extended, same attributes and not
+// END_STRING (which would terminate the run).
+static unsigned max7456DirtyRunLength(size_t pos, uint8_t charMode, unsigned maxLength)
+{
+    unsigned len = 0;
+
+    while (len < maxLength && pos + len < ARRAYLEN(osdCharacterGridBuffer) && bitArrayGet(screenIsDirty, pos + len)) {
+        const uint16_t val = osdCharacterGridBuffer[pos + len];
+        if (MODE_BYTE(val) != charMode || CHAR_BYTE(val) == END_STRING) {
+            break;
+        }
+        len++;
+    }
+
+    return len;
+}
+
 // Must be called with the lock held. Returns whether any new characters
 // were drawn.
 static bool max7456DrawScreenPartial(void)
@@ -490,11 +512,12 @@ static bool max7456DrawScreenPartial(void)
     uint8_t spiBuff[MAX_CHARS2UPDATE * BYTES_PER_CHAR2UPDATE];
     int bufPtr = 0;
     size_t pos;
-    uint_fast16_t updatedCharCount;
     uint8_t charMode;
     int next;
 
-    for (pos = 0, updatedCharCount = 0; pos < ARRAYLEN(osdCharacterGridBuffer);) {
+    // Fill the SPI buffer up to its size rather than up to a fixed number of
+    // characters, runs sent in auto-increment mode only take 2 bytes per character.
+    for (pos = 0; pos < ARRAYLEN(osdCharacterGridBuffer) && bufPtr + BYTES_PER_CHAR2UPDATE <= (int)sizeof(spiBuff);) {
         next = BITARRAY_FIND_FIRST_SET(screenIsDirty, pos);
         if (next < 0) {
             // No more dirty chars.
@@ -511,6 +534,11 @@ static bool max7456DrawScreenPartial(void)
 
         charMode = MODE_BYTE(osdCharacterGridBuffer[pos]);
         uint8_t chr = CHAR_BYTE(osdCharacterGridBuffer[pos]);
+
+        // Room left for run characters once DMAH, DMAL, DMM, the terminator and the DMM restore are in
+        const int runRoom = ((int)sizeof(spiBuff) - bufPtr - 5 * 2) / 2;
+        const unsigned runLength = CHAR_MODE_IS_EXT(charMode) ? 0 : max7456DirtyRunLength(pos, charMode, runRoom);
+
         if (CHAR_MODE_IS_EXT(charMode)) {
             if (!DMM_IS_8BIT_MODE(state.registers.dmm)) {
                 state.registers.dmm |= DMM_8BIT_MODE;
@@ -530,6 +558,29 @@ static bool max7456DrawScreenPartial(void)
             bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAL, pl);
             bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, chr);
 
+            bitArrayClr(screenIsDirty, pos);
+            pos++;
+
+        } else if (runLength >= MAX7456_MIN_AUTOINCREMENT_RUN) {
+            // Auto-increment mode: the start address is loaded first, then DMM enables
+            // auto-increment and the display memory address advances after each DMDI
+            // write, until END_STRING is written.
+            state.registers.dmm &= ~DMM_8BIT_MODE;
+            state.registers.dmm = (state.registers.dmm & ~DMM_CHAR_MODE_MASK) | charMode;
+            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAH, ph);
+            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAL, pl);
+            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMM, state.registers.dmm | DMM_AUTOINCREMENT);
+
+            for (unsigned ii = 0; ii < runLength; ii++, pos++) {
+                bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, CHAR_BYTE(osdCharacterGridBuffer[pos]));
+                bitArrayClr(screenIsDirty, pos);
+            }
+
+            // Leaves auto-increment mode, then DMM is written again so the chip matches
+            // the cached value before the next single character write
+            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, END_STRING);
+            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMM, state.registers.dmm);
+
         } else {
             if (DMM_IS_8BIT_MODE(state.registers.dmm) || (DMM_CHAR_MODE_MASK & state.registers.dmm) != charMode) {
                 state.registers.dmm &= ~DMM_8BIT_MODE;
@@ -543,14 +594,10 @@ static bool max7456DrawScreenPartial(void)
             bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAH, ph);
             bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAL, pl);
             bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, chr);
-        }
 
-        bitArrayClr(screenIsDirty, pos);
-        if (++updatedCharCount == MAX_CHARS2UPDATE) {
-            break;
+            bitArrayClr(screenIsDirty, pos);
+            pos++;
         }
-        // Start next search at next bit
-        pos++;
     }
 
     if (bufPtr) {
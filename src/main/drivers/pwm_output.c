@@ -31,6 +31,8 @@
 #include "common/circular_queue.h"
 
 #include "drivers/io.h"
+#include "drivers/dshot_telemetry.h"
+#include "drivers/time.h"
 #include "drivers/timer.h"
 #include "drivers/pwm_mapping.h"
 #include "drivers/pwm_output.h"
@@ -59,6 +61,7 @@
 #define DSHOT_MOTOR_BITLENGTH   20
 
 #define DSHOT_DMA_BUFFER_SIZE   18 /* resolution + frame reset (2us) */
+#define DSHOT_TELEMETRY_BIT_TICKS   (DSHOT_MOTOR_BITLENGTH * 4 / 5) /* reply runs at 5/4 of the DShot bitrate */
 #define MAX_DMA_TIMERS          8
 
 #define DSHOT_COMMAND_DELAY_US 1000
@@ -89,6 +92,10 @@ typedef struct {
 #ifdef USE_DSHOT_DMAR
     timerDMASafeType_t *dmaBurstBuffer;
 #endif
+#ifdef USE_DSHOT_TELEMETRY
+    bool bidir;
+    timerDMASafeType_t captureBuffer[DSHOT_TELEMETRY_MAX_EDGES];
+#endif
 #endif
 } pwmOutputPort_t;
 
@@ -307,43 +314,67 @@ static pwmOutputPort_t * motorConfigDshot(const timerHardware_t * timerHardware,
         // Only mark as DSHOT channel if DMA was set successfully
         ZERO_FARRAY(port->dmaBuffer);
         port->configured = true;
+
+#ifdef USE_DSHOT_TELEMETRY
+        if (motorConfig()->dshotBidir && enableOutput &&
+                timerPWMConfigChannelDMABidir(port->tch, port->captureBuffer, DSHOT_TELEMETRY_MAX_EDGES)) {
+            // The line idles high between frames, the ESC pulls it low to reply
+            IOConfigGPIOAF(IOGetByTag(timerHardware->tag), IOCFG_AF_PP_UP, timerHardware->alternateFunction);
+            port->bidir = true;
+            dshotTelemetryEnable(true);
+        }
+#endif
     }
 #endif
 
     return port;
 }
 
+#define DSHOT_BIT(nibble, bit)  (((nibble) & (1 << (bit))) ? DSHOT_MOTOR_BIT_1 : DSHOT_MOTOR_BIT_0)
+#define DSHOT_NIBBLE(nibble)    { DSHOT_BIT(nibble, 3), DSHOT_BIT(nibble, 2), DSHOT_BIT(nibble, 1), DSHOT_BIT(nibble, 0) }
+
+// Compare values for the four bits of a nibble, MSB first
+static const timerDMASafeType_t dshotNibbleBits[16][4] = {
+    DSHOT_NIBBLE(0x0), DSHOT_NIBBLE(0x1), DSHOT_NIBBLE(0x2), DSHOT_NIBBLE(0x3),
+    DSHOT_NIBBLE(0x4), DSHOT_NIBBLE(0x5), DSHOT_NIBBLE(0x6), DSHOT_NIBBLE(0x7),
+    DSHOT_NIBBLE(0x8), DSHOT_NIBBLE(0x9), DSHOT_NIBBLE(0xA), DSHOT_NIBBLE(0xB),
+    DSHOT_NIBBLE(0xC), DSHOT_NIBBLE(0xD), DSHOT_NIBBLE(0xE), DSHOT_NIBBLE(0xF),
+};
+
 #ifdef USE_DSHOT_DMAR
 static void loadDmaBufferDshotStride(timerDMASafeType_t *dmaBuffer, int stride, uint16_t packet)
 {
-    int i;
-    for (i = 0; i < 16; i++) {
-        dmaBuffer[i * stride] = (packet & 0x8000) ? DSHOT_MOTOR_BIT_1 : DSHOT_MOTOR_BIT_0;  // MSB first
-        packet <<= 1;
+    for (int nibble = 0; nibble < 4; nibble++) {
+        const timerDMASafeType_t *bits = dshotNibbleBits[(packet >> 12) & 0x0F];
+        timerDMASafeType_t *dst = &dmaBuffer[nibble * 4 * stride];
+        dst[0 * stride] = bits[0];
+        dst[1 * stride] = bits[1];
+        dst[2 * stride] = bits[2];
+        dst[3 * stride] = bits[3];
+        packet <<= 4;
     }
-    dmaBuffer[i++ * stride] = 0;
-    dmaBuffer[i++ * stride] = 0;
+    dmaBuffer[16 * stride] = 0;
+    dmaBuffer[17 * stride] = 0;
 }
 #else
 static void loadDmaBufferDshot(timerDMASafeType_t *dmaBuffer, uint16_t packet)
 {
-    for (int i = 0; i < 16; i++) {
-        dmaBuffer[i] = (packet & 0x8000) ? DSHOT_MOTOR_BIT_1 : DSHOT_MOTOR_BIT_0;  // MSB first
-        packet <<= 1;
+    for (int nibble = 0; nibble < 4; nibble++) {
+        memcpy(&dmaBuffer[nibble * 4], dshotNibbleBits[(packet >> 12) & 0x0F], sizeof(dshotNibbleBits[0]));
+        packet <<= 4;
     }
 }
 #endif
 
-static uint16_t prepareDshotPacket(const uint16_t value, bool requestTelemetry)
+static uint16_t prepareDshotPacket(const uint16_t value, bool requestTelemetry, bool bidir)
 {
     uint16_t packet = (value << 1) | (requestTelemetry ? 1 : 0);
 
-    // compute checksum
-    int csum = 0;
-    int csum_data = packet;
-    for (int i = 0; i < 3; i++) {
-        csum ^=  csum_data;   // xor data by nibbles
-        csum_data >>= 4;
+    // compute checksum, xor of the three data nibbles
+    int csum = packet ^ (packet >> 4) ^ (packet >> 8);
+    // Bidirectional DShot ESCs expect an inverted checksum and answer with eRPM telemetry
+    if (bidir) {
+        csum = ~csum;
     }
     csum &= 0xf;
 
@@ -354,6 +385,24 @@ static uint16_t prepareDshotPacket(const uint16_t value, bool requestTelemetry)
 }
 #endif
 
+#ifdef USE_DSHOT_TELEMETRY
+// Switch the channel back to output and decode the reply captured since the previous frame
+static void pwmDshotTelemetryDecode(int motorIndex, pwmOutputPort_t *port, timeUs_t currentTimeUs)
+{
+    const int edgeCount = timerPWMSetDMAOutput(port->tch);
+    if (edgeCount < 0) {
+        return;
+    }
+
+    uint16_t edgeTicks[DSHOT_TELEMETRY_MAX_EDGES];
+    for (int i = 0; i < edgeCount; i++) {
+        edgeTicks[i] = port->captureBuffer[i];
+    }
+
+    dshotTelemetryProcessEdges(motorIndex, edgeTicks, edgeCount, DSHOT_TELEMETRY_BIT_TICKS, currentTimeUs);
+}
+#endif
+
 #if defined(USE_DSHOT)
 static void motorConfigDigitalUpdateInterval(uint16_t motorPwmRateHz)
 {
@@ -481,15 +530,19 @@ void pwmCompleteMotorUpdate(void) {
             return;
         }
 
+        const uint32_t startTicks = ticks();
+
 #ifdef USE_DSHOT_DMAR
         for (int index = 0; index < motorCount; index++) {
             if (motors[index].pwmPort && motors[index].pwmPort->configured) {
-                uint16_t packet = prepareDshotPacket(motors[index].value, motors[index].requestTelemetry);
+                uint16_t packet = prepareDshotPacket(motors[index].value, motors[index].requestTelemetry, false);
                 loadDmaBufferDshotStride(&motors[index].pwmPort->dmaBurstBuffer[motors[index].pwmPort->tch->timHw->channelIndex], 4, packet);
                 motors[index].requestTelemetry = false;
             }
         }
 
+        DEBUG_SET(DEBUG_MOTOR_UPDATE, 0, ticks() - startTicks);
+
         for (int burstDmaTimerIndex = 0; burstDmaTimerIndex < burstDmaTimersCount; burstDmaTimerIndex++) {
             burstDmaTimer_t *burstDmaTimer = &burstDmaTimers[burstDmaTimerIndex];
             pwmBurstDMAStart(burstDmaTimer, DSHOT_DMA_BUFFER_SIZE * 4);
@@ -498,13 +551,22 @@ void pwmCompleteMotorUpdate(void) {
         // Generate DMA buffers
         for (int index = 0; index < motorCount; index++) {
             if (motors[index].pwmPort && motors[index].pwmPort->configured) {
-                uint16_t packet = prepareDshotPacket(motors[index].value, motors[index].requestTelemetry);
+                bool bidir = false;
+#ifdef USE_DSHOT_TELEMETRY
+                if (motors[index].pwmPort->bidir) {
+                    pwmDshotTelemetryDecode(index, motors[index].pwmPort, currentTimeUs);
+                    bidir = true;
+                }
+#endif
+                uint16_t packet = prepareDshotPacket(motors[index].value, motors[index].requestTelemetry, bidir);
                 loadDmaBufferDshot(motors[index].pwmPort->dmaBuffer, packet);
                 timerPWMPrepareDMA(motors[index].pwmPort->tch, DSHOT_DMA_BUFFER_SIZE);
                 motors[index].requestTelemetry = false;
             }
         }
 
+        DEBUG_SET(DEBUG_MOTOR_UPDATE, 0, ticks() - startTicks);
+
         // Start DMA on all timers
         for (int index = 0; index < motorCount; index++) {
             if (motors[index].pwmPort && motors[index].pwmPort->configured) {
@@ -512,6 +574,9 @@ void pwmCompleteMotorUpdate(void) {
             }
         }
 #endif
+
+        DEBUG_SET(DEBUG_MOTOR_UPDATE, 1, ticks() - startTicks);
+        DEBUG_SET(DEBUG_MOTOR_UPDATE, 2, motorCount);
     }
 #endif
 }
@@ -298,6 +298,18 @@ bool timerPWMDMAInProgress(TCH_t * tch)
     return tch->dmaState != TCH_DMA_IDLE;
 }
 
+#ifdef USE_DSHOT_TELEMETRY
+bool timerPWMConfigChannelDMABidir(TCH_t * tch, void * captureBuffer, uint32_t captureBufferElementCount)
+{
+    return impl_timerPWMConfigChannelDMABidir(tch, captureBuffer, captureBufferElementCount);
+}
+
+int timerPWMSetDMAOutput(TCH_t * tch)
+{
+    return impl_timerPWMSetDMAOutput(tch);
+}
+#endif
+
 #ifdef USE_DSHOT_DMAR
 bool timerPWMConfigDMABurst(burstDmaTimer_t *burstDmaTimer, TCH_t * tch, void * dmaBuffer, uint8_t dmaBufferElementSize, uint32_t dmaBufferElementCount)
 {
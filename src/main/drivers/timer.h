@@ -160,6 +160,13 @@ typedef struct TCH_s {
     DMA_t                           dma;            // Timer channel DMA handle
     volatile tchDmaState_e          dmaState;
     void *                          dmaBuffer;
+#ifdef USE_DSHOT_TELEMETRY
+    bool                            dmaBidir;       // Capture the reply on the same pin after each DMA output transfer
+    volatile bool                   dmaInput;       // Channel is currently capturing
+    void *                          captureBuffer;
+    uint16_t                        captureBufferElementCount;
+    uint16_t                        outputPeriod;   // Timer period of the output, restored when switching back from capture
+#endif
 } TCH_t;
 
 // Run-time timer context (dynamically allocated), includes 4x TCH
@@ -257,6 +264,14 @@ void timerPWMStartDMA(TCH_t * tch);
 void timerPWMStopDMA(TCH_t * tch);
 bool timerPWMDMAInProgress(TCH_t * tch);
 
+#ifdef USE_DSHOT_TELEMETRY
+// Bidirectional DShot. The output is inverted and once the DMA output transfer completes the channel captures the
+// timestamps of both edges into captureBuffer. timerPWMSetDMAOutput() switches the channel back to output and
+// returns the number of captured edges, -1 if the channel was not capturing.
+bool timerPWMConfigChannelDMABidir(TCH_t * tch, void * captureBuffer, uint32_t captureBufferElementCount);
+int timerPWMSetDMAOutput(TCH_t * tch);
+#endif
+
 volatile timCCR_t *timerCCR(TCH_t * tch);
 
 uint8_t timer2id(const HAL_Timer_t *tim);
@@ -202,7 +202,14 @@ void impl_timerCaptureCompareHandler(TIM_TypeDef *tim, timHardwareContext_t *tim
 
 void impl_timerPWMConfigChannel(TCH_t * tch, uint16_t value)
 {
-    const bool inverted = tch->timHw->output & TIMER_OUTPUT_INVERTED;
+    bool inverted = tch->timHw->output & TIMER_OUTPUT_INVERTED;
+
+#ifdef USE_DSHOT_TELEMETRY
+    // Bidirectional DShot idles high so that the ESC can answer by pulling the line low
+    if (tch->dmaBidir) {
+        inverted = !inverted;
+    }
+#endif
 
     TIM_OCInitTypeDef  TIM_OCInitStructure;
 
@@ -266,6 +273,37 @@ void impl_timerChCaptureCompareEnable(TCH_t * tch, bool enable)
     TIM_CCxCmd(tch->timHw->tim, lookupTIMChannelTable[tch->timHw->channelIndex], (enable ? TIM_CCx_Enable : TIM_CCx_Disable));
 }
 
+#ifdef USE_DSHOT_TELEMETRY
+static void impl_timerPWMStartDMAInput(TCH_t * tch)
+{
+    TIM_TypeDef * timer = tch->timHw->tim;
+    DMA_Stream_TypeDef * stream = tch->dma->ref;
+    TIM_ICInitTypeDef TIM_ICInitStructure;
+
+    tch->dmaInput = true;
+
+    // Let the counter run over the whole reply. ARR is preloaded, the output period ends first
+    timer->ARR = 0xFFFF;
+
+    TIM_ICStructInit(&TIM_ICInitStructure);
+    TIM_ICInitStructure.TIM_Channel = lookupTIMChannelTable[tch->timHw->channelIndex];
+    TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_BothEdge;
+    TIM_ICInitStructure.TIM_ICSelection = TIM_ICSelection_DirectTI;
+    TIM_ICInitStructure.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_ICInitStructure.TIM_ICFilter = getFilter(4);
+    TIM_ICInit(timer, &TIM_ICInitStructure);
+
+    // Same stream and CCR address as the output, only the direction and the memory side change
+    stream->CR = (stream->CR & ~DMA_SxCR_DIR) | DMA_DIR_PeripheralToMemory;
+    DMA_MemoryTargetConfig(stream, (uint32_t)tch->captureBuffer, DMA_Memory_0);
+    DMA_SetCurrDataCounter(stream, tch->captureBufferElementCount);
+    DMA_Cmd(stream, ENABLE);
+
+    tch->dmaState = TCH_DMA_ACTIVE;
+    TIM_DMACmd(timer, lookupDMASourceTable[tch->timHw->channelIndex], ENABLE);
+}
+#endif
+
 static void impl_timerDMA_IRQHandler(DMA_t descriptor)
 {
     if (DMA_GET_FLAG_STATUS(descriptor, DMA_IT_TCIF)) {
@@ -276,6 +314,13 @@ static void impl_timerDMA_IRQHandler(DMA_t descriptor)
         TIM_DMACmd(tch->timHw->tim, lookupDMASourceTable[tch->timHw->channelIndex], DISABLE);
 
         DMA_CLEAR_FLAG(descriptor, DMA_IT_TCIF);
+
+#ifdef USE_DSHOT_TELEMETRY
+        // Output frame is out, the ESC replies on the same pin. A completed capture just stops
+        if (tch->dmaBidir && !tch->dmaInput) {
+            impl_timerPWMStartDMAInput(tch);
+        }
+#endif
     }
 }
 
@@ -309,6 +354,8 @@ bool impl_timerPWMConfigChannelDMA(TCH_t * tch, void * dmaBuffer, uint8_t dmaBuf
     
     TIM_Cmd(timer, ENABLE);
 
+    tch->dmaBuffer = dmaBuffer;
+
     dmaInit(tch->dma, OWNER_TIMER, 0);
     dmaSetHandler(tch->dma, impl_timerDMA_IRQHandler, NVIC_PRIO_TIMER_DMA, (uint32_t)tch);
 
@@ -518,3 +565,61 @@ void impl_timerPWMStopDMA(TCH_t * tch)
     TIM_DMACmd(tch->timHw->tim, lookupDMASourceTable[tch->timHw->channelIndex], DISABLE);
     TIM_Cmd(tch->timHw->tim, ENABLE);
 }
+
+#ifdef USE_DSHOT_TELEMETRY
+bool impl_timerPWMConfigChannelDMABidir(TCH_t * tch, void * captureBuffer, uint32_t captureBufferElementCount)
+{
+    // The reply is captured on the TIx input, a complementary output has no input path
+    if (tch->dma == NULL || (tch->timHw->output & TIMER_OUTPUT_N_CHANNEL)) {
+        return false;
+    }
+
+    tch->dmaBidir = true;
+    tch->dmaInput = false;
+    tch->captureBuffer = captureBuffer;
+    tch->captureBufferElementCount = captureBufferElementCount;
+    tch->outputPeriod = tch->timHw->tim->ARR;
+
+    // Reconfigure the output with the polarity bidirectional DShot uses
+    impl_timerPWMConfigChannel(tch, 0);
+
+    return true;
+}
+
+int impl_timerPWMSetDMAOutput(TCH_t * tch)
+{
+    if (!tch->dmaInput) {
+        return -1;
+    }
+
+    TIM_TypeDef * timer = tch->timHw->tim;
+    DMA_Stream_TypeDef * stream = tch->dma->ref;
+
+    // Stop the capture. Clear a completion that may be pending too, the IRQ handler
+    // would otherwise take it for the end of an output transfer and start capturing again
+    ATOMIC_BLOCK(NVIC_PRIO_MAX) {
+        DMA_Cmd(stream, DISABLE);
+        TIM_DMACmd(timer, lookupDMASourceTable[tch->timHw->channelIndex], DISABLE);
+        while (DMA_GetCmdStatus(stream) != DISABLE);
+        DMA_CLEAR_FLAG(tch->dma, DMA_IT_TCIF);
+        tch->dmaInput = false;
+        tch->dmaState = TCH_DMA_IDLE;
+    }
+
+    const int edgeCount = tch->captureBufferElementCount - DMA_GetCurrDataCounter(stream);
+
+    // CCxNP was set for capturing both edges and must be cleared on an output channel
+    timer->CCER &= ~(TIM_CCER_CC1NP << (tch->timHw->channelIndex * 4));
+    impl_timerPWMConfigChannel(tch, 0);
+
+    stream->CR = (stream->CR & ~DMA_SxCR_DIR) | DMA_DIR_MemoryToPeripheral;
+    DMA_MemoryTargetConfig(stream, (uint32_t)tch->dmaBuffer, DMA_Memory_0);
+
+    // Restore the bit period right away, the counter is reset when the next frame starts
+    TIM_ARRPreloadConfig(timer, DISABLE);
+    timer->ARR = tch->outputPeriod;
+    TIM_ARRPreloadConfig(timer, ENABLE);
+
+    return edgeCount;
+}
+#endif
@@ -28,6 +28,7 @@
 bool cliMode = false;
 
 #include "blackbox/blackbox.h"
+#include "blackbox/blackbox_io.h"
 
 #include "build/assert.h"
 #include "build/build_config.h"
@@ -53,6 +54,7 @@ bool cliMode = false;
 #include "drivers/accgyro/accgyro.h"
 #include "drivers/pwm_mapping.h"
 #include "drivers/buf_writer.h"
+#include "drivers/bus.h"
 #include "drivers/bus_i2c.h"
 #include "drivers/compass/compass.h"
 #include "drivers/flash.h"
@@ -70,6 +72,7 @@ bool cliMode = false;
 #include "drivers/vtx_common.h"
 
 #include "fc/fc_core.h"
+#include "fc/loop_profile.h"
 #include "fc/cli.h"
 #include "fc/config.h"
 #include "fc/controlrate_profile.h"
@@ -80,6 +83,7 @@ bool cliMode = false;
 #include "fc/settings.h"
 
 #include "flight/failsafe.h"
+#include "flight/gain_schedule.h"
 #include "flight/imu.h"
 #include "flight/mixer_profile.h"
 #include "flight/pid.h"
@@ -1368,6 +1372,95 @@ static void cliSafeHomes(char *cmdline)
     }
 }
 
+#endif
+
+#ifdef USE_GAIN_SCHEDULE
+STATIC_ASSERT(GAIN_SCHEDULE_POINTS == 5, gainsched_cli_format_expects_5_points);
+
+static void printGainSchedule(uint8_t dumpMask, const gainScheduleConfig_t *config, const gainScheduleConfig_t *defaultConfig)
+{
+    static const char * const inputNames[GAIN_SCHEDULE_INPUT_COUNT] = { "x", "y" };
+    bool equalsDefault = false;
+
+    for (int input = 0; input < GAIN_SCHEDULE_INPUT_COUNT; input++) {
+        const char *format = "gainsched %s %d %d %d %d %d";
+        const int16_t *bp = config->breakpoints[input];
+        if (defaultConfig) {
+            const int16_t *defaultBp = defaultConfig->breakpoints[input];
+            equalsDefault = memcmp(bp, defaultBp, sizeof(config->breakpoints[input])) == 0;
+            cliDefaultPrintLinef(dumpMask, equalsDefault, format, inputNames[input],
+                defaultBp[0], defaultBp[1], defaultBp[2], defaultBp[3], defaultBp[4]);
+        }
+        cliDumpPrintLinef(dumpMask, equalsDefault, format, inputNames[input], bp[0], bp[1], bp[2], bp[3], bp[4]);
+    }
+
+    for (int row = 0; row < GAIN_SCHEDULE_POINTS; row++) {
+        const char *format = "gainsched %d %u %u %u %u %u";
+        const uint8_t *factor = config->factor[row];
+        if (defaultConfig) {
+            const uint8_t *defaultFactor = defaultConfig->factor[row];
+            equalsDefault = memcmp(factor, defaultFactor, sizeof(config->factor[row])) == 0;
+            cliDefaultPrintLinef(dumpMask, equalsDefault, format, row,
+                defaultFactor[0], defaultFactor[1], defaultFactor[2], defaultFactor[3], defaultFactor[4]);
+        }
+        cliDumpPrintLinef(dumpMask, equalsDefault, format, row, factor[0], factor[1], factor[2], factor[3], factor[4]);
+    }
+}
+
+// Reads exactly GAIN_SCHEDULE_POINTS values following the first argument
+static bool parseGainScheduleValues(const char *ptr, int min, int max, int *values)
+{
+    for (int i = 0; i < GAIN_SCHEDULE_POINTS; i++) {
+        ptr = nextArg(ptr);
+        if (!ptr) {
+            return false;
+        }
+        values[i] = fastA2I(ptr);
+        if (values[i] < min || values[i] > max) {
+            return false;
+        }
+    }
+
+    return nextArg(ptr) == NULL;
+}
+
+static void cliGainSchedule(char *cmdline)
+{
+    int values[GAIN_SCHEDULE_POINTS];
+
+    if (isEmpty(cmdline)) {
+        printGainSchedule(DUMP_MASTER, gainScheduleConfig(), NULL);
+    } else if (sl_strcasecmp(cmdline, "reset") == 0) {
+        gainScheduleResetConfig(gainScheduleConfigMutable());
+    } else if (sl_strncasecmp(cmdline, "x ", 2) == 0 || sl_strncasecmp(cmdline, "y ", 2) == 0) {
+        const int input = (sl_toupper(cmdline[0]) == 'X') ? GAIN_SCHEDULE_INPUT_X : GAIN_SCHEDULE_INPUT_Y;
+
+        if (!parseGainScheduleValues(cmdline, INT16_MIN, INT16_MAX, values)) {
+            cliShowParseError();
+            return;
+        }
+        for (int i = 1; i < GAIN_SCHEDULE_POINTS; i++) {
+            if (values[i] <= values[i - 1]) {
+                cliPrintErrorLinef("Breakpoints must be increasing");
+                return;
+            }
+        }
+        for (int i = 0; i < GAIN_SCHEDULE_POINTS; i++) {
+            gainScheduleConfigMutable()->breakpoints[input][i] = values[i];
+        }
+    } else {
+        const int row = fastA2I(cmdline);
+        if (row < 0 || row >= GAIN_SCHEDULE_POINTS) {
+            cliShowArgumentRangeError("row", 0, GAIN_SCHEDULE_POINTS - 1);
+        } else if (!parseGainScheduleValues(cmdline, GAIN_SCHEDULE_FACTOR_MIN, GAIN_SCHEDULE_FACTOR_MAX, values)) {
+            cliShowArgumentRangeError("factor", GAIN_SCHEDULE_FACTOR_MIN, GAIN_SCHEDULE_FACTOR_MAX);
+        } else {
+            for (int i = 0; i < GAIN_SCHEDULE_POINTS; i++) {
+                gainScheduleConfigMutable()->factor[row][i] = values[i];
+            }
+        }
+    }
+}
 #endif
 #if defined(NAV_NON_VOLATILE_WAYPOINT_STORAGE) && defined(NAV_NON_VOLATILE_WAYPOINT_CLI)
 static void printWaypoints(uint8_t dumpMask, const navWaypoint_t *navWaypoint, const navWaypoint_t *defaultNavWaypoint)
@@ -1891,7 +1984,7 @@ static void cliServoMix(char *cmdline)
             args[INPUT] >= 0 && args[INPUT] < INPUT_SOURCE_COUNT &&
             args[RATE] >= -1000 && args[RATE] <= 1000 &&
             args[SPEED] >= 0 && args[SPEED] <= MAX_SERVO_SPEED &&
-            args[CONDITION] >= -1 && args[CONDITION] < MAX_LOGIC_CONDITIONS
+            args[CONDITION] >= -1 && args[CONDITION] < MIN(MAX_LOGIC_CONDITIONS, INT8_MAX + 1)
         ) {
             customServoMixersMutable(i)->targetChannel = args[TARGET];
             customServoMixersMutable(i)->inputSource = args[INPUT];
@@ -2322,6 +2415,9 @@ static void cliFlashInfo(char *cmdline)
             FLASH_PARTITION_SECTOR_COUNT(flashPartition) * layout->sectorSize,
             flashfsGetOffset()
     );
+    if (flashfsIsErasing()) {
+        cliPrintLinef("Erasing in background: %u%%", flashfsGetEraseProgress());
+    }
 #endif
 }
 
@@ -2717,11 +2813,37 @@ static void printBlackbox(uint8_t dumpMask, const blackboxConfig_t *config, cons
 
 }
 
+static void printBlackboxStatus(void)
+{
+    const blackboxDeviceStats_t *stats = blackboxDeviceGetStats();
+    const timeMs_t endMs = stats->logEndMs ? stats->logEndMs : millis();
+    const uint32_t elapsedMs = stats->logStartMs ? endMs - stats->logStartMs : 0;
+
+    cliPrintLinef("Log: %u bytes in %u s, %u B/s", stats->bytesWritten, elapsedMs / 1000,
+        elapsedMs ? (uint32_t)((uint64_t)stats->bytesWritten * 1000 / elapsedMs) : 0);
+    cliPrintLinef("Dropped: %u bytes in %u iterations", stats->bytesDropped, stats->iterationsDropped);
+
+#ifdef USE_SDCARD
+    if (blackboxConfig()->device == BLACKBOX_DEVICE_SDCARD) {
+        const afatfsStats_t *fsStats = afatfs_getStats();
+
+        cliPrintLinef("SD card: %u sectors written in %u runs, %u read, %u cache sectors, %u cache full stalls",
+            fsStats->sectorsWritten, fsStats->writeRuns, fsStats->sectorsRead, fsStats->cacheSectors, fsStats->cacheFullStalls);
+        cliPrintLinef("SD card read-ahead: %u of %u used", fsStats->readAheadHits, fsStats->readAheadIssued);
+    }
+#endif
+}
+
 static void cliBlackbox(char *cmdline)
 {
     uint32_t len = strlen(cmdline);
     uint32_t mask = blackboxConfig()->includeFlags;
 
+    if (sl_strcasecmp(cmdline, "status") == 0) {
+        printBlackboxStatus();
+        return;
+    }
+
     if (len == 0) {
         cliPrint("Enabled: ");
         for (uint8_t i = 0; ; i++) {
@@ -3637,6 +3759,30 @@ static void cliTasks(char *cmdline)
     cliPrintLinef("Total (excluding SERIAL) %21d.%1d%% %4d.%1d%%", maxLoadSum/10, maxLoadSum%10, averageLoadSum/10, averageLoadSum%10);
 }
 
+static void cliLoopProfile(char *cmdline)
+{
+    if (sl_strcasecmp(cmdline, "reset") == 0) {
+        loopProfileReset();
+        return;
+    } else if (!isEmpty(cmdline)) {
+        cliShowParseError();
+        return;
+    }
+
+    cliPrintLinef("PID loop %d us, %u loops, %u overruns", (int)getLooptime(), loopProfileGetLoopCount(), loopProfileGetOverrunCount());
+    cliPrintLinef("Stage            min/us    avg/us    p99/us    max/us  worst loop/us");
+    for (int i = 0; i < LOOP_PROFILE_ENTRY_COUNT; i++) {
+        loopStageStats_t stats;
+        loopProfileGetStats(i, &stats);
+        cliPrintLinef("%-12s %6u.%02u %6u.%02u %6u.%02u %6u.%02u      %6u.%02u", loopProfileStageName(i),
+            stats.minNs / 1000, stats.minNs % 1000 / 10,
+            stats.avgNs / 1000, stats.avgNs % 1000 / 10,
+            stats.p99Ns / 1000, stats.p99Ns % 1000 / 10,
+            stats.maxNs / 1000, stats.maxNs % 1000 / 10,
+            stats.worstLoopNs / 1000, stats.worstLoopNs % 1000 / 10);
+    }
+}
+
 static void cliVersion(char *cmdline)
 {
     UNUSED(cmdline);
@@ -3668,6 +3814,61 @@ static void cliMemory(char *cmdline)
     }
 }
 
+static void cliBusStats(char *cmdline)
+{
+    UNUSED(cmdline);
+
+    const timeMs_t uptimeMs = MAX(millis(), 1U);
+    uint64_t busyTimeUs[BUSTYPE_SDIO + 1][4] = { { 0 } };
+
+    cliPrintLine("Device       Bus   transfers   busy/ms    load");
+    for (int i = 0; i < busDeviceRegistrySize(); i++) {
+        const busDevice_t *dev = busDeviceByRegistryIndex(i);
+        if (!dev) {
+            continue;
+        }
+
+        const char *busName;
+        int busIndex;
+        switch (dev->busType) {
+#ifdef USE_SPI
+            case BUSTYPE_SPI:
+                busName = "SPI";
+                busIndex = dev->busdev.spi.spiBus;
+                break;
+#endif
+#ifdef USE_I2C
+            case BUSTYPE_I2C:
+                busName = "I2C";
+                busIndex = dev->busdev.i2c.i2cBus;
+                break;
+#endif
+            default:
+                continue;
+        }
+
+        const uint64_t deviceBusyTimeUs = dev->stats->busyTicks / usTicks;
+        if (busIndex >= 0 && busIndex < 4) {
+            busyTimeUs[dev->busType][busIndex] += deviceBusyTimeUs;
+        }
+
+        // Busy time in microseconds over uptime in milliseconds gives the load in 0.1%
+        const uint32_t load = deviceBusyTimeUs / uptimeMs;
+        cliPrintLinef("%-12s %s%d %11u %9u %5u.%u%%", ownerNames[dev->owner], busName, busIndex + 1,
+                dev->stats->transfers, (uint32_t)(deviceBusyTimeUs / 1000), load / 10, load % 10);
+    }
+
+    for (int busType = BUSTYPE_I2C; busType <= BUSTYPE_SPI; busType++) {
+        for (int busIndex = 0; busIndex < 4; busIndex++) {
+            if (busyTimeUs[busType][busIndex]) {
+                const uint32_t load = busyTimeUs[busType][busIndex] / uptimeMs;
+                cliPrintLinef("Total        %s%d %21u %5u.%u%%", busType == BUSTYPE_SPI ? "SPI" : "I2C", busIndex + 1,
+                        (uint32_t)(busyTimeUs[busType][busIndex] / 1000), load / 10, load % 10);
+            }
+        }
+    }
+}
+
 static void cliResource(char *cmdline)
 {
     UNUSED(cmdline);
@@ -3784,6 +3985,11 @@ static void printConfig(const char *cmdline, bool doDiff)
         printSafeHomes(dumpMask, safeHomeConfig_CopyArray, safeHomeConfig(0));
 #endif
 
+#ifdef USE_GAIN_SCHEDULE
+        cliPrintHashLine("gain schedule");
+        printGainSchedule(dumpMask, &gainScheduleConfig_Copy, gainScheduleConfig());
+#endif
+
         cliPrintHashLine("features");
         printFeature(dumpMask, &featureConfig_Copy, featureConfig());
 
@@ -3997,6 +4203,7 @@ const clicmd_t cmdTable[] = {
 #if defined(USE_BOOTLOG)
     CLI_COMMAND_DEF("bootlog", "show boot events", NULL, cliBootlog),
 #endif
+    CLI_COMMAND_DEF("bus_stats", "show bus usage per device", NULL, cliBusStats),
 #ifdef USE_LED_STRIP
     CLI_COMMAND_DEF("color", "configure colors", NULL, cliColor),
     CLI_COMMAND_DEF("mode_color", "configure mode and special colors", NULL, cliModeColor),
@@ -4018,6 +4225,7 @@ const clicmd_t cmdTable[] = {
 #ifdef USE_BLACKBOX
     CLI_COMMAND_DEF("blackbox", "configure blackbox fields",
         "list\r\n"
+        "\tstatus\r\n"
         "\t<+|->[name]", cliBlackbox),
 #endif
 #ifdef USE_FLASHFS
@@ -4027,6 +4235,11 @@ const clicmd_t cmdTable[] = {
     CLI_COMMAND_DEF("flash_read", NULL, "<length> <address>", cliFlashRead),
     CLI_COMMAND_DEF("flash_write", NULL, "<address> <message>", cliFlashWrite),
 #endif
+#endif
+#ifdef USE_GAIN_SCHEDULE
+    CLI_COMMAND_DEF("gainsched", "configure the gain schedule table", "x|y <5 breakpoints>\r\n"
+        "\t<row> <5 factors in %>\r\n"
+        "\treset", cliGainSchedule),
 #endif
     CLI_COMMAND_DEF("get", "get variable value", "[name]", cliGet),
 #ifdef USE_GPS
@@ -4036,6 +4249,7 @@ const clicmd_t cmdTable[] = {
 #ifdef USE_LED_STRIP
     CLI_COMMAND_DEF("led", "configure leds", NULL, cliLed),
 #endif
+    CLI_COMMAND_DEF("loop_profile", "show PID loop stage timing", "[reset]", cliLoopProfile),
     CLI_COMMAND_DEF("map", "configure rc channel order", "[<map>]", cliMap),
     CLI_COMMAND_DEF("memory", "view memory usage", NULL, cliMemory),
     CLI_COMMAND_DEF("mmix", "custom motor mixer", NULL, cliMotorMix),
@@ -65,6 +65,7 @@
 #include "flight/imu.h"
 #include "flight/failsafe.h"
 #include "flight/ez_tune.h"
+#include "flight/gain_schedule.h"
 
 #include "fc/config.h"
 #include "fc/controlrate_profile.h"
@@ -77,6 +78,8 @@
 
 #include "navigation/navigation.h"
 
+#include "programming/logic_condition.h"
+
 #ifndef DEFAULT_FEATURES
 #define DEFAULT_FEATURES 0
 #endif
@@ -239,6 +242,10 @@ void validateAndFixConfig(void)
     // Ensure sane values of navConfig settings
     validateNavConfig();
 
+#ifdef USE_GAIN_SCHEDULE
+    gainScheduleValidateConfig(gainScheduleConfigMutable());
+#endif
+
     // Limitations of different protocols
 #if !defined(USE_DSHOT)
     if (motorConfig()->motorPwmProtocol > PWM_TYPE_BRUSHED) {
@@ -322,6 +329,8 @@ static void activateConfig(void)
     pidInit();
 
     navigationUsePIDs();
+
+    logicConditionCompile();
 }
 
 void readEEPROM(void)
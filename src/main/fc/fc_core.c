@@ -54,6 +54,7 @@
 #include "fc/cli.h"
 #include "fc/config.h"
 #include "fc/controlrate_profile.h"
+#include "fc/loop_profile.h"
 #include "fc/multifunction.h"
 #include "fc/rc_adjustments.h"
 #include "fc/rc_smoothing.h"
@@ -876,14 +877,18 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
         processDelayedSave();
     }
 
+    loopProfileBegin();
+
 #if defined(SITL_BUILD)
     if (lockMainPID()) {
 #endif
 
     gyroFilter();
+    loopProfileMark(LOOP_STAGE_GYRO);
 
     imuUpdateAccelerometer();
     imuUpdateAttitude(currentTimeUs);
+    loopProfileMark(LOOP_STAGE_ATTITUDE);
 
 #if defined(SITL_BUILD)
     }
@@ -897,12 +902,16 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
         rcInterpolationApply(isRXDataNew, currentTimeUs);
     }
 
+    const bool rxDataUsedThisCycle = isRXDataNew;
     if (isRXDataNew) {
         updateWaypointsAndNavigationMode();
     }
     isRXDataNew = false;
+    loopProfileMark(LOOP_STAGE_PILOT);
 
     updatePositionEstimator();
+    loopProfileMark(LOOP_STAGE_POSITION);
+
     applyWaypointNavigationAndAltitudeHold();
 
     // Apply throttle tilt compensation
@@ -911,16 +920,26 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
 #ifdef USE_POWER_LIMITS
     powerLimiterApply(&rcCommand[THROTTLE]);
 #endif
+    loopProfileMark(LOOP_STAGE_NAVIGATION);
 
     // Calculate stabilisation
     pidController(dT);
 
+    if (rxDataUsedThisCycle) {
+        // Stick to PID latency, from the end of the RC frame to the first PID run that uses it
+        DEBUG_SET(DEBUG_RX_LATENCY, 3, cmpTimeUs(micros(), rxGetFrameTimeUs()));
+    }
+
+    loopProfileMark(LOOP_STAGE_PID);
+
     mixTable();
+    loopProfileMark(LOOP_STAGE_MIXER);
 
     if (isMixerUsingServos()) {
         servoMixer(dT);
         processServoAutotrim(dT);
     }
+    loopProfileMark(LOOP_STAGE_SERVOS);
 
     //Servos should be filtered or written only when mixer is using servos or special feaures are enabled
 
@@ -943,16 +962,22 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
         writeMotors();
     }
 #endif
+    loopProfileMark(LOOP_STAGE_OUTPUT);
+
     // Check if landed, FW and MR
     if (STATE(ALTITUDE_CONTROL)) {
         updateLandingStatus(US2MS(currentTimeUs));
     }
+    loopProfileMark(LOOP_STAGE_NAVIGATION);
 
 #ifdef USE_BLACKBOX
     if (!cliMode && feature(FEATURE_BLACKBOX)) {
         blackboxUpdate(micros());
     }
 #endif
+    loopProfileMark(LOOP_STAGE_BLACKBOX);
+
+    loopProfileEnd();
 }
 
 // This function is called in a busy-loop, everything called from here should do it's own
@@ -50,6 +50,7 @@
 #include "drivers/compass/compass.h"
 #include "drivers/bus.h"
 #include "drivers/dma.h"
+#include "drivers/dshot_telemetry.h"
 #include "drivers/exti.h"
 #include "drivers/io.h"
 #include "drivers/flash.h"
@@ -701,7 +702,11 @@ void init(void)
 
 #ifdef USE_RPM_FILTER
     disableRpmFilters();
-    if (STATE(ESC_SENSOR_ENABLED) && (rpmFilterConfig()->gyro_filter_enabled || rpmFilterConfig()->dterm_filter_enabled)) {
+    bool rpmSourceAvailable = STATE(ESC_SENSOR_ENABLED);
+#ifdef USE_DSHOT_TELEMETRY
+    rpmSourceAvailable = rpmSourceAvailable || dshotTelemetryIsEnabled();
+#endif
+    if (rpmSourceAvailable && (rpmFilterConfig()->gyro_filter_enabled || rpmFilterConfig()->dterm_filter_enabled)) {
         rpmFiltersInit();
         setTaskEnabled(TASK_RPM_FILTER, true);
     }
@@ -65,7 +65,9 @@
 #include "fc/controlrate_profile.h"
 #include "fc/fc_msp.h"
 #include "fc/fc_msp_box.h"
+#include "fc/fc_msp_dataflash.h"
 #include "fc/firmware_update.h"
+#include "fc/loop_profile.h"
 #include "fc/rc_adjustments.h"
 #include "fc/rc_controls.h"
 #include "fc/rc_modes.h"
@@ -79,6 +81,7 @@
 #include "flight/pid.h"
 #include "flight/servos.h"
 #include "flight/ez_tune.h"
+#include "flight/system_identification.h"
 
 #include "config/config_eeprom.h"
 #include "config/feature.h"
@@ -124,6 +127,8 @@
 #include "sensors/esc_sensor.h"
 
 #include "telemetry/telemetry.h"
+#include "telemetry/crsf.h"
+#include "telemetry/crsf_scheduler.h"
 
 #ifdef USE_HARDWARE_REVISION_DETECTION
 #include "hardware_revision.h"
@@ -305,15 +310,18 @@ static void serializeDataflashSummaryReply(sbuf_t *dst)
 {
 #ifdef USE_FLASHFS
     const flashGeometry_t *geometry = flashGetGeometry();
-    sbufWriteU8(dst, flashIsReady() ? 1 : 0);
+    // Not ready until a background erase is done, so tools waiting for the erase still see it finish
+    sbufWriteU8(dst, (flashIsReady() && !flashfsIsErasing()) ? 1 : 0);
     sbufWriteU32(dst, geometry->sectors);
     sbufWriteU32(dst, geometry->totalSize);
     sbufWriteU32(dst, flashfsGetOffset()); // Effectively the current number of bytes stored on the volume
+    sbufWriteU8(dst, flashfsGetEraseProgress());
 #else
     sbufWriteU8(dst, 0);
     sbufWriteU32(dst, 0);
     sbufWriteU32(dst, 0);
     sbufWriteU32(dst, 0);
+    sbufWriteU8(dst, 0);
 #endif
 }
 
@@ -525,23 +533,6 @@ static bool mspFcProcessOutCommand(uint16_t cmdMSP, sbuf_t *dst, mspPostProcessF
         }
         break;
 #ifdef USE_PROGRAMMING_FRAMEWORK
-    case MSP2_INAV_LOGIC_CONDITIONS:
-        for (int i = 0; i < MAX_LOGIC_CONDITIONS; i++) {
-            sbufWriteU8(dst, logicConditions(i)->enabled);
-            sbufWriteU8(dst, logicConditions(i)->activatorId);
-            sbufWriteU8(dst, logicConditions(i)->operation);
-            sbufWriteU8(dst, logicConditions(i)->operandA.type);
-            sbufWriteU32(dst, logicConditions(i)->operandA.value);
-            sbufWriteU8(dst, logicConditions(i)->operandB.type);
-            sbufWriteU32(dst, logicConditions(i)->operandB.value);
-            sbufWriteU8(dst, logicConditions(i)->flags);
-        }
-        break;
-    case MSP2_INAV_LOGIC_CONDITIONS_STATUS:
-        for (int i = 0; i < MAX_LOGIC_CONDITIONS; i++) {
-            sbufWriteU32(dst, logicConditionGetValue(i));
-        }
-        break;
     case MSP2_INAV_GVAR_STATUS:
         for (int i = 0; i < MAX_GLOBAL_VARIABLES; i++) {
             sbufWriteU32(dst, gvGet(i));
@@ -1586,6 +1577,42 @@ static bool mspFcProcessOutCommand(uint16_t cmdMSP, sbuf_t *dst, mspPostProcessF
         break;
 #endif
 
+#ifdef USE_SYSTEM_IDENTIFICATION
+    case MSP2_INAV_SYSTEM_ID:
+        sbufWriteU8(dst, systemIdGetState());
+        sbufWriteU8(dst, systemIdGetAxis());
+        sbufWriteU8(dst, systemIdGetProgress());
+        sbufWriteU8(dst, SYSTEM_ID_BIN_COUNT);
+        for (int i = 0; i < SYSTEM_ID_BIN_COUNT; i++) {
+            systemIdBinResult_t result;
+            if (!systemIdGetBin(i, &result)) {
+                memset(&result, 0, sizeof(result));
+            }
+            // Frequency in 0.1Hz, gains in 0.01dB, phases in 0.1deg
+            sbufWriteU16(dst, lrintf(result.frequencyHz * 10));
+            sbufWriteU16(dst, (int16_t)constrainf(result.closedLoopGain > 0 ? 2000 * log10f(result.closedLoopGain) : INT16_MIN, INT16_MIN, INT16_MAX));
+            sbufWriteU16(dst, (int16_t)lrintf(result.closedLoopPhase * 10));
+            sbufWriteU16(dst, (int16_t)constrainf(result.plantGain > 0 ? 2000 * log10f(result.plantGain) : INT16_MIN, INT16_MIN, INT16_MAX));
+            sbufWriteU16(dst, (int16_t)lrintf(result.plantPhase * 10));
+        }
+        break;
+#endif
+
+#if defined(USE_TELEMETRY) && defined(USE_SERIALRX_CRSF) && defined(USE_TELEMETRY_CRSF)
+    case MSP2_INAV_CRSF_TELEMETRY_STATS:
+        sbufWriteU32(dst, crsfGetTelemetrySlotInterval());
+        for (uint8_t i = 0; i < CRSF_SCHEDULER_MAX_FRAMES; i++) {
+            crsfTelemetryFrameStats_t stats;
+            if (crsfGetTelemetryFrameStats(i, &stats)) {
+                sbufWriteU8(dst, stats.frameType);
+                sbufWriteU8(dst, stats.priority);
+                sbufWriteU16(dst, stats.targetRateDeciHz);
+                sbufWriteU16(dst, stats.achievedRateDeciHz);
+            }
+        }
+        break;
+#endif
+
 #ifdef USE_EZ_TUNE
 
     case MSP2_INAV_EZ_TUNE:
@@ -1641,23 +1668,53 @@ static mspResult_e mspFcSafeHomeOutCommand(sbuf_t *dst, sbuf_t *src)
 #endif
 
 
+#define MSP_LOGIC_CONDITION_SIZE    14
+
+static void mspFcSerializeLogicCondition(sbuf_t *dst, int idx)
+{
+    sbufWriteU8(dst, logicConditions(idx)->enabled);
+    sbufWriteU8(dst, logicConditions(idx)->activatorId);
+    sbufWriteU8(dst, logicConditions(idx)->operation);
+    sbufWriteU8(dst, logicConditions(idx)->operandA.type);
+    sbufWriteU32(dst, logicConditions(idx)->operandA.value);
+    sbufWriteU8(dst, logicConditions(idx)->operandB.type);
+    sbufWriteU32(dst, logicConditions(idx)->operandB.value);
+    sbufWriteU8(dst, logicConditions(idx)->flags);
+}
+
 static mspResult_e mspFcLogicConditionCommand(sbuf_t *dst, sbuf_t *src) {
     const uint8_t idx = sbufReadU8(src);
     if (idx < MAX_LOGIC_CONDITIONS) {
-        sbufWriteU8(dst, logicConditions(idx)->enabled);
-        sbufWriteU8(dst, logicConditions(idx)->activatorId);
-        sbufWriteU8(dst, logicConditions(idx)->operation);
-        sbufWriteU8(dst, logicConditions(idx)->operandA.type);
-        sbufWriteU32(dst, logicConditions(idx)->operandA.value);
-        sbufWriteU8(dst, logicConditions(idx)->operandB.type);
-        sbufWriteU32(dst, logicConditions(idx)->operandB.value);
-        sbufWriteU8(dst, logicConditions(idx)->flags);
+        mspFcSerializeLogicCondition(dst, idx);
         return MSP_RESULT_ACK;
     } else {
         return MSP_RESULT_ERROR;
     }
 }
 
+/*
+ * Not all logic conditions fit one reply. The bulk commands take an optional start index and return
+ * as many conditions from there as fit. Clients page through the list by asking again from the next
+ * index until the reply is empty. Without a start index the reply starts at condition 0.
+ */
+static void mspFcLogicConditionsCommand(sbuf_t *dst, sbuf_t *src)
+{
+    const int start = sbufBytesRemaining(src) >= 1 ? sbufReadU8(src) : 0;
+
+    for (int i = start; i < MAX_LOGIC_CONDITIONS && sbufBytesRemaining(dst) >= MSP_LOGIC_CONDITION_SIZE; i++) {
+        mspFcSerializeLogicCondition(dst, i);
+    }
+}
+
+static void mspFcLogicConditionsStatusCommand(sbuf_t *dst, sbuf_t *src)
+{
+    const int start = sbufBytesRemaining(src) >= 1 ? sbufReadU8(src) : 0;
+
+    for (int i = start; i < MAX_LOGIC_CONDITIONS && sbufBytesRemaining(dst) >= 4; i++) {
+        sbufWriteU32(dst, logicConditionGetValue(i));
+    }
+}
+
 static void mspFcWaypointOutCommand(sbuf_t *dst, sbuf_t *src)
 {
     const uint8_t msp_wp_no = sbufReadU8(src);    // get the wp number
@@ -2091,13 +2148,15 @@ static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
         sbufReadU8Safe(&tmp_u8, src);
         if ((dataSize == 15) && (tmp_u8 < MAX_LOGIC_CONDITIONS)) {
             logicConditionsMutable(tmp_u8)->enabled = sbufReadU8(src);
-            logicConditionsMutable(tmp_u8)->activatorId = sbufReadU8(src);
+            tmp_u16 = sbufReadU8(src);
+            logicConditionsMutable(tmp_u8)->activatorId = (tmp_u16 == 0xFF) ? -1 : tmp_u16;
             logicConditionsMutable(tmp_u8)->operation = sbufReadU8(src);
             logicConditionsMutable(tmp_u8)->operandA.type = sbufReadU8(src);
             logicConditionsMutable(tmp_u8)->operandA.value = sbufReadU32(src);
             logicConditionsMutable(tmp_u8)->operandB.type = sbufReadU8(src);
             logicConditionsMutable(tmp_u8)->operandB.value = sbufReadU32(src);
             logicConditionsMutable(tmp_u8)->flags = sbufReadU8(src);
+            logicConditionCompile();
         } else
             return MSP_RESULT_ERROR;
         break;
@@ -2572,7 +2631,7 @@ static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
 
 #ifdef USE_FLASHFS
     case MSP_DATAFLASH_ERASE:
-        flashfsEraseCompletely();
+        flashfsEraseAsync();
         break;
 #endif
 
@@ -3574,7 +3633,38 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
     case MSP2_INAV_LOGIC_CONDITIONS_SINGLE:
         *ret = mspFcLogicConditionCommand(dst, src);
         break;
+
+    case MSP2_INAV_LOGIC_CONDITIONS:
+        mspFcLogicConditionsCommand(dst, src);
+        *ret = MSP_RESULT_ACK;
+        break;
+
+    case MSP2_INAV_LOGIC_CONDITIONS_STATUS:
+        mspFcLogicConditionsStatusCommand(dst, src);
+        *ret = MSP_RESULT_ACK;
+        break;
 #endif
+
+    case MSP2_INAV_LOOP_PROFILE:
+        // Optional flags byte, bit 0 resets the statistics after the reply
+        sbufWriteU8(dst, LOOP_PROFILE_ENTRY_COUNT);
+        sbufWriteU32(dst, loopProfileGetLoopCount());
+        sbufWriteU32(dst, loopProfileGetOverrunCount());
+        sbufWriteU16(dst, getLooptime());
+        for (int i = 0; i < LOOP_PROFILE_ENTRY_COUNT; i++) {
+            loopStageStats_t stats;
+            loopProfileGetStats(i, &stats);
+            sbufWriteU32(dst, stats.minNs);
+            sbufWriteU32(dst, stats.avgNs);
+            sbufWriteU32(dst, stats.p99Ns);
+            sbufWriteU32(dst, stats.maxNs);
+            sbufWriteU32(dst, stats.worstLoopNs);
+        }
+        if (sbufBytesRemaining(src) >= 1 && (sbufReadU8(src) & 0x01)) {
+            loopProfileReset();
+        }
+        *ret = MSP_RESULT_ACK;
+        break;
 #ifdef USE_SAFE_HOME
     case MSP2_INAV_SAFEHOME:
         *ret = mspFcSafeHomeOutCommand(dst, src);
@@ -3871,6 +3961,10 @@ mspResult_e mspFcProcessCommand(mspPacket_t *cmd, mspPacket_t *reply, mspPostPro
     } else if (cmdMSP == MSP_SET_PASSTHROUGH) {
         mspFcSetPassthroughCommand(dst, src, mspPostProcessFn);
         ret = MSP_RESULT_ACK;
+#ifdef USE_FLASHFS
+    } else if (cmdMSP == MSP2_INAV_DATAFLASH_STREAM) {
+        ret = mspDataflashStreamCommand(dst, src, mspPostProcessFn);
+#endif
     } else {
         if (!mspFCProcessInOutCommand(cmdMSP, dst, src, &ret)) {
             ret = mspFcProcessInCommand(cmdMSP, src);
@@ -31,6 +31,7 @@
 #include "fc/runtime_config.h"
 #include "flight/mixer.h"
 #include "flight/mixer_profile.h"
+#include "flight/system_identification.h"
 
 #include "io/osd.h"
 
@@ -102,6 +103,7 @@ static const box_t boxes[CHECKBOX_ITEM_COUNT + 1] = {
     { .boxId = BOXMULTIFUNCTION,    .boxName = "MULTI FUNCTION",    .permanentId = 61 },
     { .boxId = BOXMIXERPROFILE,     .boxName = "MIXER PROFILE 2",   .permanentId = 62 },
     { .boxId = BOXMIXERTRANSITION,  .boxName = "MIXER TRANSITION",  .permanentId = 63 },
+    { .boxId = BOXSYSTEMID,         .boxName = "SYSTEM ID",         .permanentId = 64 },
     { .boxId = CHECKBOX_ITEM_COUNT, .boxName = NULL,                .permanentId = 0xFF }
 };
 
@@ -359,6 +361,10 @@ void initActiveBoxIds(void)
     ADD_ACTIVE_BOX(BOXMIXERPROFILE);
     ADD_ACTIVE_BOX(BOXMIXERTRANSITION);
 #endif
+
+#ifdef USE_SYSTEM_IDENTIFICATION
+    ADD_ACTIVE_BOX(BOXSYSTEMID);
+#endif
 }
 
 #define IS_ENABLED(mask) ((mask) == 0 ? 0 : 1)
@@ -431,6 +437,9 @@ void packBoxModeFlags(boxBitmask_t * mspBoxModeFlags)
 #if (MAX_MIXER_PROFILE_COUNT > 1)
     CHECK_ACTIVE_BOX(IS_ENABLED(currentMixerProfileIndex),              BOXMIXERPROFILE);
     CHECK_ACTIVE_BOX(IS_ENABLED(IS_RC_MODE_ACTIVE(BOXMIXERTRANSITION)), BOXMIXERTRANSITION);
+#endif
+#ifdef USE_SYSTEM_IDENTIFICATION
+    CHECK_ACTIVE_BOX(IS_ENABLED(systemIdGetState() == SYSTEM_ID_RUNNING),  BOXSYSTEMID);
 #endif
     memset(mspBoxModeFlags, 0, sizeof(boxBitmask_t));
     for (uint32_t i = 0; i < activeBoxIdCount; i++) {
@@ -0,0 +1,283 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Streaming dataflash download. Instead of one MSP_DATAFLASH_READ round trip per chunk the host
+ * starts a stream and the FC pushes consecutive chunks, keeping up to `window` of them unacknowledged.
+ *
+ * MSP2_INAV_DATAFLASH_STREAM request:
+ *  uint8_t     - op (mspDataflashStreamOp_e)
+ *  START:
+ *   uint32_t   - address
+ *   uint32_t   - length
+ *   uint16_t   - chunk size
+ *   uint8_t    - window, in chunks
+ *   uint8_t    - flags (mspDataflashStreamFlags_e)
+ *   The reply echoes these fields after clamping them to what the FC accepts.
+ *  ACK:
+ *   uint16_t   - sequence number of the next chunk the host expects, acknowledges everything before it.
+ *                No reply is sent.
+ *  STOP:
+ *   No payload, ends the stream.
+ *
+ * MSP2_INAV_DATAFLASH_STREAM_DATA push:
+ *  uint16_t    - sequence number
+ *  uint32_t    - address of the first byte
+ *  uint16_t    - length of the data before encoding, 0 marks the end of the stream
+ *  uint8_t     - encoding (mspDataflashStreamEncoding_e)
+ *  ...         - data
+ *
+ * Lost chunks are recovered go-back-N style: when no acknowledgement arrives for a while, sending
+ * restarts from the oldest unacknowledged chunk. Acknowledging the end marker closes the stream.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef USE_FLASHFS
+
+#include "common/maths.h"
+#include "common/packbits.h"
+#include "common/streambuf.h"
+
+#include "drivers/flash.h"
+#include "drivers/serial.h"
+#include "drivers/time.h"
+
+#include "fc/fc_msp_dataflash.h"
+#include "fc/runtime_config.h"
+
+#include "io/flashfs.h"
+
+#include "msp/msp_protocol.h"
+#include "msp/msp_serial.h"
+
+#define DATAFLASH_STREAM_DEFAULT_CHUNK      256
+#define DATAFLASH_STREAM_MIN_CHUNK          32
+#define DATAFLASH_STREAM_DEFAULT_WINDOW     4
+#define DATAFLASH_STREAM_ACK_TIMEOUT_MS     250
+#define DATAFLASH_STREAM_MAX_TIMEOUTS       8
+
+#define DATAFLASH_STREAM_DATA_HEADER_SIZE   9
+#define DATAFLASH_STREAM_MSP_OVERHEAD       9   // MSPv2 native header and checksum
+
+typedef struct {
+    serialPort_t *port;     // NULL when no stream is running
+    uint32_t startAddress;
+    uint32_t length;
+    uint16_t chunkSize;
+    uint8_t window;
+    uint8_t flags;
+    uint32_t endSeq;        // Sequence number of the end marker
+    uint32_t nextSeq;       // Next chunk to send
+    uint32_t ackedSeq;      // Oldest chunk not acknowledged yet
+    timeMs_t lastAckMs;
+    uint8_t timeouts;
+} dataflashStream_t;
+
+static dataflashStream_t stream;
+static uint8_t streamChunk[MSP_DATAFLASH_STREAM_MAX_CHUNK];
+static uint8_t streamFrame[DATAFLASH_STREAM_DATA_HEADER_SIZE + MSP_DATAFLASH_STREAM_MAX_CHUNK];
+
+static void mspDataflashStreamStop(void)
+{
+    stream.port = NULL;
+}
+
+static void mspDataflashStreamAttachFn(serialPort_t *serialPort)
+{
+    stream.port = serialPort;
+    stream.lastAckMs = millis();
+}
+
+static mspResult_e mspDataflashStreamStart(sbuf_t *dst, sbuf_t *src, mspPostProcessFnPtr *mspPostProcessFn)
+{
+    if (sbufBytesRemaining(src) < 12 || !flashfsIsReady() || ARMING_FLAG(ARMED)) {
+        return MSP_RESULT_ERROR;
+    }
+
+    mspDataflashStreamStop();
+
+    const uint32_t volumeSize = flashfsGetSize();
+    const uint32_t address = sbufReadU32(src);
+    uint32_t length = sbufReadU32(src);
+    uint16_t chunkSize = sbufReadU16(src);
+    uint8_t window = sbufReadU8(src);
+    const uint8_t flags = sbufReadU8(src) & MSP_DATAFLASH_STREAM_FLAG_COMPRESS;
+
+    if (address > volumeSize) {
+        return MSP_RESULT_ERROR;
+    }
+
+    length = MIN(length, volumeSize - address);
+    chunkSize = chunkSize ? constrain(chunkSize, DATAFLASH_STREAM_MIN_CHUNK, MSP_DATAFLASH_STREAM_MAX_CHUNK) : DATAFLASH_STREAM_DEFAULT_CHUNK;
+    window = window ? MIN(window, MSP_DATAFLASH_STREAM_MAX_WINDOW) : DATAFLASH_STREAM_DEFAULT_WINDOW;
+
+    stream.startAddress = address;
+    stream.length = length;
+    stream.chunkSize = chunkSize;
+    stream.window = window;
+    stream.flags = flags;
+    stream.endSeq = (length + chunkSize - 1) / chunkSize;
+    stream.nextSeq = 0;
+    stream.ackedSeq = 0;
+    stream.timeouts = 0;
+
+    sbufWriteU32(dst, address);
+    sbufWriteU32(dst, length);
+    sbufWriteU16(dst, chunkSize);
+    sbufWriteU8(dst, window);
+    sbufWriteU8(dst, flags);
+
+    // The port is only known once the reply has gone out
+    *mspPostProcessFn = mspDataflashStreamAttachFn;
+
+    return MSP_RESULT_ACK;
+}
+
+static void mspDataflashStreamAck(uint16_t ackSeq)
+{
+    // Only the low 16 bits of the sequence go over the wire, ignore anything outside the window
+    const uint32_t delta = (uint16_t)(ackSeq - (uint16_t)stream.ackedSeq);
+    if (delta == 0 || delta > stream.nextSeq - stream.ackedSeq) {
+        return;
+    }
+
+    stream.ackedSeq += delta;
+    stream.lastAckMs = millis();
+    stream.timeouts = 0;
+}
+
+mspResult_e mspDataflashStreamCommand(sbuf_t *dst, sbuf_t *src, mspPostProcessFnPtr *mspPostProcessFn)
+{
+    if (sbufBytesRemaining(src) < 1) {
+        return MSP_RESULT_ERROR;
+    }
+
+    switch (sbufReadU8(src)) {
+    case MSP_DATAFLASH_STREAM_START:
+        return mspDataflashStreamStart(dst, src, mspPostProcessFn);
+
+    case MSP_DATAFLASH_STREAM_ACK:
+        if (sbufBytesRemaining(src) < 2) {
+            return MSP_RESULT_ERROR;
+        }
+        if (stream.port) {
+            mspDataflashStreamAck(sbufReadU16(src));
+        }
+        return MSP_RESULT_NO_REPLY;
+
+    case MSP_DATAFLASH_STREAM_STOP:
+        mspDataflashStreamStop();
+        return MSP_RESULT_ACK;
+
+    default:
+        return MSP_RESULT_ERROR;
+    }
+}
+
+static int mspDataflashStreamBuildFrame(uint32_t seq)
+{
+    const uint32_t offset = seq * stream.chunkSize;
+    const uint32_t address = stream.startAddress + offset;
+    const uint16_t rawLength = (seq < stream.endSeq) ? MIN(stream.chunkSize, stream.length - offset) : 0;
+
+    sbuf_t buf = { .ptr = streamFrame, .end = ARRAYEND(streamFrame) };
+    sbufWriteU16(&buf, seq);
+    sbufWriteU32(&buf, address);
+    sbufWriteU16(&buf, rawLength);
+
+    if (rawLength == 0) {
+        sbufWriteU8(&buf, MSP_DATAFLASH_STREAM_ENCODING_RAW);
+        return DATAFLASH_STREAM_DATA_HEADER_SIZE;
+    }
+
+    const int bytesRead = flashfsReadAbs(address, streamChunk, rawLength);
+    if (bytesRead != rawLength) {
+        return -1;
+    }
+
+    if (stream.flags & MSP_DATAFLASH_STREAM_FLAG_COMPRESS) {
+        // Keep the encoded data only when it actually saves space
+        const int encodedLength = packbitsEncode(streamChunk, rawLength, sbufPtr(&buf) + 1, rawLength - 1);
+        if (encodedLength > 0) {
+            sbufWriteU8(&buf, MSP_DATAFLASH_STREAM_ENCODING_PACKBITS);
+            return DATAFLASH_STREAM_DATA_HEADER_SIZE + encodedLength;
+        }
+    }
+
+    sbufWriteU8(&buf, MSP_DATAFLASH_STREAM_ENCODING_RAW);
+    sbufWriteData(&buf, streamChunk, rawLength);
+    return DATAFLASH_STREAM_DATA_HEADER_SIZE + rawLength;
+}
+
+/*
+ * Called from the serial task. Pushes as many chunks as the window and the port's TX buffer allow.
+ */
+void mspDataflashStreamProcess(void)
+{
+    if (!stream.port) {
+        return;
+    }
+
+    // The port may have been taken over by the CLI, and the flash is needed for logging once armed
+    mspPort_t *mspPort = mspSerialPortFind(stream.port);
+    if (!mspPort || ARMING_FLAG(ARMED) || stream.ackedSeq > stream.endSeq) {
+        mspDataflashStreamStop();
+        return;
+    }
+
+    const timeMs_t currentTimeMs = millis();
+    if (stream.nextSeq != stream.ackedSeq && currentTimeMs - stream.lastAckMs > DATAFLASH_STREAM_ACK_TIMEOUT_MS) {
+        if (++stream.timeouts > DATAFLASH_STREAM_MAX_TIMEOUTS) {
+            mspDataflashStreamStop();
+            return;
+        }
+        stream.nextSeq = stream.ackedSeq;
+        stream.lastAckMs = currentTimeMs;
+    }
+
+    const int maxFrameLength = DATAFLASH_STREAM_MSP_OVERHEAD + DATAFLASH_STREAM_DATA_HEADER_SIZE + stream.chunkSize;
+
+    while (stream.nextSeq <= stream.endSeq && stream.nextSeq - stream.ackedSeq < stream.window) {
+        if (!isSerialTransmitBufferEmpty(stream.port) && (int)mspSerialTxBytesFree(stream.port) < maxFrameLength) {
+            break;
+        }
+
+        if (stream.nextSeq == stream.ackedSeq) {
+            // Nothing in flight, the timeout starts with the first chunk of the window
+            stream.lastAckMs = currentTimeMs;
+        }
+
+        const int frameLength = mspDataflashStreamBuildFrame(stream.nextSeq);
+        if (frameLength < 0) {
+            mspDataflashStreamStop();
+            return;
+        }
+
+        if (mspSerialPushPort(MSP2_INAV_DATAFLASH_STREAM_DATA, streamFrame, frameLength, mspPort, MSP_V2_NATIVE) <= 0) {
+            break;
+        }
+
+        stream.nextSeq++;
+    }
+}
+
+#endif
@@ -0,0 +1,43 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "common/streambuf.h"
+
+#include "msp/msp.h"
+
+#define MSP_DATAFLASH_STREAM_MAX_CHUNK      512
+#define MSP_DATAFLASH_STREAM_MAX_WINDOW     16
+
+typedef enum {
+    MSP_DATAFLASH_STREAM_START = 0,
+    MSP_DATAFLASH_STREAM_ACK   = 1,
+    MSP_DATAFLASH_STREAM_STOP  = 2,
+} mspDataflashStreamOp_e;
+
+typedef enum {
+    MSP_DATAFLASH_STREAM_FLAG_COMPRESS = 1 << 0,
+} mspDataflashStreamFlags_e;
+
+typedef enum {
+    MSP_DATAFLASH_STREAM_ENCODING_RAW      = 0,
+    MSP_DATAFLASH_STREAM_ENCODING_PACKBITS = 1,
+} mspDataflashStreamEncoding_e;
+
+mspResult_e mspDataflashStreamCommand(sbuf_t *dst, sbuf_t *src, mspPostProcessFnPtr *mspPostProcessFn);
+void mspDataflashStreamProcess(void);
@@ -39,6 +39,7 @@
 #include "fc/config.h"
 #include "fc/fc_core.h"
 #include "fc/fc_msp.h"
+#include "fc/fc_msp_dataflash.h"
 #include "fc/fc_tasks.h"
 #include "fc/rc_controls.h"
 #include "fc/runtime_config.h"
@@ -57,6 +58,7 @@
 #include "io/beeper.h"
 #include "io/lights.h"
 #include "io/dashboard.h"
+#include "io/flashfs.h"
 #include "io/gps.h"
 #include "io/ledstrip.h"
 #include "io/osd.h"
@@ -102,6 +104,10 @@ void taskHandleSerial(timeUs_t currentTimeUs)
     // Allow MSP processing even if in CLI mode
     mspSerialProcess(ARMING_FLAG(ARMED) ? MSP_SKIP_NON_MSP_DATA : MSP_EVALUATE_NON_MSP_DATA, mspFcProcessCommand);
 
+#ifdef USE_FLASHFS
+    mspDataflashStreamProcess();
+#endif
+
 #if defined(USE_DJI_HD_OSD)
     // DJI OSD uses a special flavour of MSP (subset of Betaflight 4.1.1 MSP) - process as part of serial task
     djiOsdSerialProcess();
@@ -308,6 +314,15 @@ void taskUpdateOsd(timeUs_t currentTimeUs)
 }
 #endif
 
+#ifdef USE_FLASHFS
+void taskFlashfs(timeUs_t currentTimeUs)
+{
+    UNUSED(currentTimeUs);
+
+    flashfsEraseUpdate();
+}
+#endif
+
 void taskUpdateAux(timeUs_t currentTimeUs)
 {
     updatePIDCoefficients();
@@ -404,6 +419,9 @@ void fcTasksInit(void)
 #if defined(USE_SMARTPORT_MASTER)
     setTaskEnabled(TASK_SMARTPORT_MASTER, true);
 #endif
+#ifdef USE_FLASHFS
+    setTaskEnabled(TASK_FLASHFS, flashfsIsReady());
+#endif
 }
 
 cfTask_t cfTasks[TASK_COUNT] = {
@@ -636,7 +654,7 @@ cfTask_t cfTasks[TASK_COUNT] = {
     [TASK_RPM_FILTER] = {
         .taskName = "RPM",
         .taskFunc = rpmFilterUpdateTask,
-        .desiredPeriod = TASK_PERIOD_HZ(RPM_FILTER_UPDATE_RATE_HZ),          // 300Hz @3,33ms
+        .desiredPeriod = TASK_PERIOD_HZ(RPM_FILTER_UPDATE_RATE_HZ),          // 500Hz @2ms, loop rate with bidirectional DShot
         .staticPriority = TASK_PRIORITY_LOW,
     },
 #endif
@@ -646,4 +664,12 @@ cfTask_t cfTasks[TASK_COUNT] = {
         .desiredPeriod = TASK_PERIOD_HZ(TASK_AUX_RATE_HZ),          // 100Hz @10ms
         .staticPriority = TASK_PRIORITY_HIGH,
     },
+#ifdef USE_FLASHFS
+    [TASK_FLASHFS] = {
+        .taskName = "FLASHFS",
+        .taskFunc = taskFlashfs,
+        .desiredPeriod = TASK_PERIOD_HZ(200),         // 200Hz @5ms, NAND blocks erase in a few ms
+        .staticPriority = TASK_PRIORITY_IDLE,
+    },
+#endif
 };
@@ -0,0 +1,239 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Stage times are taken from the cycle counter (DWT on the MCUs, a nanosecond clock on SITL) and
+ * aggregated without leaving the loop: min and max are exact since the last reset, the average and
+ * the 99th percentile come from a running sum and a log histogram with four buckets per octave. Both
+ * are halved every LOOP_PROFILE_DECAY_LOOPS loops, so they follow the recent behaviour of the loop.
+ * Turning the histograms into percentiles is left to the reader.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#include "build/debug.h"
+
+#include "common/maths.h"
+#include "common/utils.h"
+
+#include "drivers/time.h"
+
+#include "fc/config.h"
+#include "fc/loop_profile.h"
+
+#define LOOP_PROFILE_FIRST_OCTAVE       7       // Everything below 128 ticks goes to the first bucket
+#define LOOP_PROFILE_BUCKET_COUNT       48      // 12 octaves, up to 512k ticks
+#define LOOP_PROFILE_DECAY_LOOPS        32768
+
+typedef struct loopStageAccumulator_s {
+    uint32_t minTicks;
+    uint32_t maxTicks;
+    uint64_t sumTicks;
+    uint16_t histogram[LOOP_PROFILE_BUCKET_COUNT];
+} loopStageAccumulator_t;
+
+static struct {
+    uint32_t startTicks;
+    uint32_t markTicks;
+    uint32_t frame[LOOP_PROFILE_ENTRY_COUNT];
+
+    uint32_t loops;
+    uint32_t windowLoops;
+    uint32_t overruns;
+    uint32_t worstLoop[LOOP_PROFILE_ENTRY_COUNT];
+    loopStageAccumulator_t stage[LOOP_PROFILE_ENTRY_COUNT];
+} profile;
+
+static const char * const loopStageNames[LOOP_PROFILE_ENTRY_COUNT] = {
+    [LOOP_STAGE_GYRO]       = "GYRO",
+    [LOOP_STAGE_ATTITUDE]   = "ATTITUDE",
+    [LOOP_STAGE_PILOT]      = "PILOT",
+    [LOOP_STAGE_POSITION]   = "POSITION",
+    [LOOP_STAGE_NAVIGATION] = "NAVIGATION",
+    [LOOP_STAGE_PID]        = "PID",
+    [LOOP_STAGE_MIXER]      = "MIXER",
+    [LOOP_STAGE_SERVOS]     = "SERVOS",
+    [LOOP_STAGE_OUTPUT]     = "OUTPUT",
+    [LOOP_STAGE_BLACKBOX]   = "BLACKBOX",
+    [LOOP_STAGE_TOTAL]      = "TOTAL",
+};
+
+// Stages sharing a slot of DEBUG_LOOP_PROFILE add up
+static const uint8_t loopStageDebugSlot[LOOP_PROFILE_ENTRY_COUNT] = {
+    [LOOP_STAGE_GYRO]       = 0,
+    [LOOP_STAGE_ATTITUDE]   = 1,
+    [LOOP_STAGE_PILOT]      = 2,
+    [LOOP_STAGE_POSITION]   = 3,
+    [LOOP_STAGE_NAVIGATION] = 3,
+    [LOOP_STAGE_PID]        = 4,
+    [LOOP_STAGE_MIXER]      = 5,
+    [LOOP_STAGE_SERVOS]     = 5,
+    [LOOP_STAGE_OUTPUT]     = 5,
+    [LOOP_STAGE_BLACKBOX]   = 6,
+    [LOOP_STAGE_TOTAL]      = 7,
+};
+
+static uint32_t ticksToNs(uint32_t ticks)
+{
+    return usTicks ? (uint64_t)ticks * 1000 / usTicks : 0;
+}
+
+static int bucketIndex(uint32_t ticks)
+{
+    if (ticks < (1U << LOOP_PROFILE_FIRST_OCTAVE)) {
+        return 0;
+    }
+
+    const int octave = 31 - __builtin_clz(ticks);
+    const int quarter = (ticks >> (octave - 2)) & 0x03;
+    return MIN((octave - LOOP_PROFILE_FIRST_OCTAVE) * 4 + quarter, LOOP_PROFILE_BUCKET_COUNT - 1);
+}
+
+// Upper edge of a bucket, the next bucket starts there
+static uint32_t bucketLimit(int bucket)
+{
+    const int octave = LOOP_PROFILE_FIRST_OCTAVE + bucket / 4;
+    return (uint32_t)(5 + bucket % 4) << (octave - 2);
+}
+
+void loopProfileReset(void)
+{
+    memset(&profile, 0, sizeof(profile));
+}
+
+void loopProfileBegin(void)
+{
+    profile.startTicks = ticks();
+    profile.markTicks = profile.startTicks;
+    memset(profile.frame, 0, sizeof(profile.frame));
+}
+
+void loopProfileMark(loopStage_e stage)
+{
+    const uint32_t now = ticks();
+    profile.frame[stage] += now - profile.markTicks;
+    profile.markTicks = now;
+}
+
+static void loopProfileDecay(void)
+{
+    for (int i = 0; i < LOOP_PROFILE_ENTRY_COUNT; i++) {
+        loopStageAccumulator_t *acc = &profile.stage[i];
+        acc->sumTicks /= 2;
+        for (int b = 0; b < LOOP_PROFILE_BUCKET_COUNT; b++) {
+            acc->histogram[b] /= 2;
+        }
+    }
+    profile.windowLoops /= 2;
+}
+
+void loopProfileEnd(void)
+{
+    const uint32_t totalTicks = profile.markTicks - profile.startTicks;
+    profile.frame[LOOP_STAGE_TOTAL] = totalTicks;
+
+    if (profile.windowLoops >= LOOP_PROFILE_DECAY_LOOPS) {
+        loopProfileDecay();
+    }
+
+    for (int i = 0; i < LOOP_PROFILE_ENTRY_COUNT; i++) {
+        loopStageAccumulator_t *acc = &profile.stage[i];
+        const uint32_t stageTicks = profile.frame[i];
+
+        acc->minTicks = profile.loops ? MIN(acc->minTicks, stageTicks) : stageTicks;
+        acc->maxTicks = MAX(acc->maxTicks, stageTicks);
+        acc->sumTicks += stageTicks;
+        acc->histogram[bucketIndex(stageTicks)]++;
+    }
+
+    if (totalTicks > profile.worstLoop[LOOP_STAGE_TOTAL]) {
+        memcpy(profile.worstLoop, profile.frame, sizeof(profile.worstLoop));
+    }
+
+    if (totalTicks > getLooptime() * usTicks) {
+        profile.overruns++;
+    }
+
+    profile.loops++;
+    profile.windowLoops++;
+
+    // Shows up in the blackbox one loop later, the log of this loop has already been written
+    if (debugMode == DEBUG_LOOP_PROFILE) {
+        int32_t slots[DEBUG32_VALUE_COUNT] = { 0 };
+        for (int i = 0; i < LOOP_PROFILE_ENTRY_COUNT; i++) {
+            slots[loopStageDebugSlot[i]] += profile.frame[i];
+        }
+        for (int i = 0; i < DEBUG32_VALUE_COUNT; i++) {
+            debug[i] = ticksToNs(slots[i]);
+        }
+    }
+}
+
+const char *loopProfileStageName(loopStage_e stage)
+{
+    return stage < LOOP_PROFILE_ENTRY_COUNT ? loopStageNames[stage] : NULL;
+}
+
+uint32_t loopProfileGetLoopCount(void)
+{
+    return profile.loops;
+}
+
+uint32_t loopProfileGetOverrunCount(void)
+{
+    return profile.overruns;
+}
+
+void loopProfileGetStats(loopStage_e stage, loopStageStats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+
+    if (stage >= LOOP_PROFILE_ENTRY_COUNT || profile.loops == 0) {
+        return;
+    }
+
+    const loopStageAccumulator_t *acc = &profile.stage[stage];
+
+    uint32_t samples = 0;
+    for (int b = 0; b < LOOP_PROFILE_BUCKET_COUNT; b++) {
+        samples += acc->histogram[b];
+    }
+
+    stats->minNs = ticksToNs(acc->minTicks);
+    stats->maxNs = ticksToNs(acc->maxTicks);
+    stats->worstLoopNs = ticksToNs(profile.worstLoop[stage]);
+
+    if (samples) {
+        stats->avgNs = ticksToNs(acc->sumTicks / profile.windowLoops);
+
+        // Smallest bucket that leaves at most 1% of the samples above it
+        const uint32_t threshold = samples - samples / 100;
+        uint32_t cumulative = 0;
+        for (int b = 0; b < LOOP_PROFILE_BUCKET_COUNT; b++) {
+            cumulative += acc->histogram[b];
+            if (cumulative >= threshold) {
+                // The last bucket is open ended, the maximum is the better bound there
+                stats->p99Ns = (b == LOOP_PROFILE_BUCKET_COUNT - 1) ? stats->maxNs : MIN(ticksToNs(bucketLimit(b)), stats->maxNs);
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Per stage timing of the PID loop. The loop calls loopProfileBegin() and then loopProfileMark() after
+ * each stage, which charges the cycles since the previous mark to that stage. A stage may be marked more
+ * than once per loop, the times add up.
+ */
+
+typedef enum {
+    LOOP_STAGE_GYRO = 0,        // gyroFilter
+    LOOP_STAGE_ATTITUDE,        // imuUpdateAccelerometer, imuUpdateAttitude
+    LOOP_STAGE_PILOT,           // Pilot and failsafe actions, arming, RC interpolation, navigation modes
+    LOOP_STAGE_POSITION,        // updatePositionEstimator
+    LOOP_STAGE_NAVIGATION,      // Navigation controllers, throttle compensation, landing detection
+    LOOP_STAGE_PID,             // pidController
+    LOOP_STAGE_MIXER,           // mixTable
+    LOOP_STAGE_SERVOS,          // servoMixer, servo autotrim
+    LOOP_STAGE_OUTPUT,          // writeServos, writeMotors
+    LOOP_STAGE_BLACKBOX,        // blackboxUpdate
+    LOOP_STAGE_COUNT,
+    LOOP_STAGE_TOTAL = LOOP_STAGE_COUNT,    // Whole loop, only for the statistics
+} loopStage_e;
+
+#define LOOP_PROFILE_ENTRY_COUNT    (LOOP_STAGE_COUNT + 1)
+
+typedef struct loopStageStats_s {
+    uint32_t minNs;
+    uint32_t avgNs;
+    uint32_t p99Ns;             // Upper edge of the histogram bucket, up to 25% above the true value
+    uint32_t maxNs;
+    uint32_t worstLoopNs;       // Time of the stage in the longest loop seen
+} loopStageStats_t;
+
+void loopProfileBegin(void);
+void loopProfileMark(loopStage_e stage);
+void loopProfileEnd(void);
+
+void loopProfileReset(void);
+const char *loopProfileStageName(loopStage_e stage);
+uint32_t loopProfileGetLoopCount(void);
+uint32_t loopProfileGetOverrunCount(void);
+void loopProfileGetStats(loopStage_e stage, loopStageStats_t *stats);
@@ -81,6 +81,7 @@ typedef enum {
     BOXMULTIFUNCTION = 52,
     BOXMIXERPROFILE      = 53,
     BOXMIXERTRANSITION   = 54,
+    BOXSYSTEMID          = 55,
     CHECKBOX_ITEM_COUNT
 } boxId_e;
 
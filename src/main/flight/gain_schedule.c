@@ -0,0 +1,194 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Two input gain scheduling. The user sets a small table of rate PID gain factors over two flight
+ * variables with freely placed breakpoints. Looking that up directly needs a breakpoint search on each
+ * input, so the table is resampled on a dense uniform grid when the configuration is loaded and the
+ * lookup is reduced to a bilinear interpolation between four grid nodes.
+ *
+ * Grid nodes that fall on a breakpoint are exact, between them the grid follows the piecewise bilinear
+ * table, so the compiled schedule only differs from the table inside grid cells that contain a kink.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef USE_GAIN_SCHEDULE
+
+#include "common/maths.h"
+
+#include "config/parameter_group.h"
+#include "config/parameter_group_ids.h"
+
+#include "fc/settings.h"
+
+#include "flight/gain_schedule.h"
+
+PG_REGISTER_WITH_RESET_FN(gainScheduleConfig_t, gainScheduleConfig, PG_GAIN_SCHEDULE_CONFIG, 0);
+
+static gainScheduleGrid_t gainScheduleGrid;
+
+void gainScheduleResetConfig(gainScheduleConfig_t *config)
+{
+    config->source[GAIN_SCHEDULE_INPUT_X] = SETTING_GAIN_SCHED_X_SOURCE_DEFAULT;
+    config->source[GAIN_SCHEDULE_INPUT_Y] = SETTING_GAIN_SCHED_Y_SOURCE_DEFAULT;
+
+    for (int i = 0; i < GAIN_SCHEDULE_POINTS; i++) {
+        config->breakpoints[GAIN_SCHEDULE_INPUT_X][i] = 1000 + i * 1000 / (GAIN_SCHEDULE_POINTS - 1);
+        config->breakpoints[GAIN_SCHEDULE_INPUT_Y][i] = 1000 + i * 1000 / (GAIN_SCHEDULE_POINTS - 1);
+
+        for (int j = 0; j < GAIN_SCHEDULE_POINTS; j++) {
+            config->factor[i][j] = 100;
+        }
+    }
+}
+
+void pgResetFn_gainScheduleConfig(gainScheduleConfig_t *config)
+{
+    gainScheduleResetConfig(config);
+}
+
+void gainScheduleValidateConfig(gainScheduleConfig_t *config)
+{
+    for (int row = 0; row < GAIN_SCHEDULE_POINTS; row++) {
+        for (int col = 0; col < GAIN_SCHEDULE_POINTS; col++) {
+            config->factor[row][col] = constrain(config->factor[row][col], GAIN_SCHEDULE_FACTOR_MIN, GAIN_SCHEDULE_FACTOR_MAX);
+        }
+    }
+}
+
+static float tableFactor(const gainScheduleConfig_t *config, int row, int col)
+{
+    return constrain(config->factor[row][col], GAIN_SCHEDULE_FACTOR_MIN, GAIN_SCHEDULE_FACTOR_MAX);
+}
+
+// Finds the table segment a grid node falls in and the position of the node within it
+static void locateNode(const int16_t *breakpoints, int node, int *segment, float *fraction)
+{
+    const float value = breakpoints[0] + (float)(breakpoints[GAIN_SCHEDULE_POINTS - 1] - breakpoints[0]) * node / (GAIN_SCHEDULE_GRID - 1);
+
+    int k = 0;
+    while (k < GAIN_SCHEDULE_POINTS - 2 && value > breakpoints[k + 1]) {
+        k++;
+    }
+
+    *segment = k;
+    *fraction = constrainf((value - breakpoints[k]) / (breakpoints[k + 1] - breakpoints[k]), 0.0f, 1.0f);
+}
+
+bool gainScheduleCompile(gainScheduleGrid_t *grid, const gainScheduleConfig_t *config)
+{
+    int segment[GAIN_SCHEDULE_INPUT_COUNT][GAIN_SCHEDULE_GRID];
+    float fraction[GAIN_SCHEDULE_INPUT_COUNT][GAIN_SCHEDULE_GRID];
+    bool anyInput = false;
+
+    memset(grid, 0, sizeof(*grid));
+
+    for (int input = 0; input < GAIN_SCHEDULE_INPUT_COUNT; input++) {
+        const int16_t *breakpoints = config->breakpoints[input];
+
+        if (config->source[input] == GAIN_SCHEDULE_SOURCE_NONE) {
+            // Unused input, stays on the first row or column of the table
+            for (int n = 0; n < GAIN_SCHEDULE_GRID; n++) {
+                segment[input][n] = 0;
+                fraction[input][n] = 0.0f;
+            }
+            continue;
+        }
+
+        for (int k = 1; k < GAIN_SCHEDULE_POINTS; k++) {
+            if (breakpoints[k] <= breakpoints[k - 1]) {
+                return false;
+            }
+        }
+
+        grid->origin[input] = breakpoints[0];
+        grid->scale[input] = (GAIN_SCHEDULE_GRID - 1) / (float)(breakpoints[GAIN_SCHEDULE_POINTS - 1] - breakpoints[0]);
+
+        for (int n = 0; n < GAIN_SCHEDULE_GRID; n++) {
+            locateNode(breakpoints, n, &segment[input][n], &fraction[input][n]);
+        }
+        anyInput = true;
+    }
+
+    if (!anyInput) {
+        return false;
+    }
+
+    for (int ny = 0; ny < GAIN_SCHEDULE_GRID; ny++) {
+        const int ky = segment[GAIN_SCHEDULE_INPUT_Y][ny];
+        const float ty = fraction[GAIN_SCHEDULE_INPUT_Y][ny];
+
+        for (int nx = 0; nx < GAIN_SCHEDULE_GRID; nx++) {
+            const int kx = segment[GAIN_SCHEDULE_INPUT_X][nx];
+            const float tx = fraction[GAIN_SCHEDULE_INPUT_X][nx];
+
+            const float bottom = tableFactor(config, ky, kx) + (tableFactor(config, ky, kx + 1) - tableFactor(config, ky, kx)) * tx;
+            const float top = tableFactor(config, ky + 1, kx) + (tableFactor(config, ky + 1, kx + 1) - tableFactor(config, ky + 1, kx)) * tx;
+            grid->node[ny][nx] = (bottom + (top - bottom) * ty) / 100.0f;
+        }
+    }
+
+    grid->enabled = true;
+    return true;
+}
+
+static float gridPosition(const gainScheduleGrid_t *grid, int input, float value, int *index)
+{
+    const float position = constrainf((value - grid->origin[input]) * grid->scale[input], 0.0f, GAIN_SCHEDULE_GRID - 1);
+    *index = MIN((int)position, GAIN_SCHEDULE_GRID - 2);
+    return position - *index;
+}
+
+float gainScheduleLookup(const gainScheduleGrid_t *grid, float x, float y)
+{
+    if (!grid->enabled) {
+        return 1.0f;
+    }
+
+    int ix, iy;
+    const float tx = gridPosition(grid, GAIN_SCHEDULE_INPUT_X, x, &ix);
+    const float ty = gridPosition(grid, GAIN_SCHEDULE_INPUT_Y, y, &iy);
+
+    const float *row0 = grid->node[iy];
+    const float *row1 = grid->node[iy + 1];
+    const float bottom = row0[ix] + (row0[ix + 1] - row0[ix]) * tx;
+    const float top = row1[ix] + (row1[ix + 1] - row1[ix]) * tx;
+
+    return bottom + (top - bottom) * ty;
+}
+
+void gainScheduleInit(void)
+{
+    gainScheduleCompile(&gainScheduleGrid, gainScheduleConfig());
+}
+
+bool gainScheduleIsEnabled(void)
+{
+    return gainScheduleGrid.enabled;
+}
+
+float gainScheduleGetFactor(float x, float y)
+{
+    return gainScheduleLookup(&gainScheduleGrid, x, y);
+}
+
+#endif
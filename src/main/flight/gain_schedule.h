@@ -0,0 +1,73 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config/parameter_group.h"
+
+#define GAIN_SCHEDULE_POINTS    5       // Breakpoints per input in the configured table
+#define GAIN_SCHEDULE_GRID      17      // Nodes per input in the compiled grid
+
+// Factor limits [%]. Gains near zero leave the aircraft without stabilisation, so that's not a valid setting.
+#define GAIN_SCHEDULE_FACTOR_MIN    10
+#define GAIN_SCHEDULE_FACTOR_MAX    250
+
+typedef enum {
+    GAIN_SCHEDULE_INPUT_X = 0,
+    GAIN_SCHEDULE_INPUT_Y,
+    GAIN_SCHEDULE_INPUT_COUNT
+} gainScheduleInput_e;
+
+typedef enum {
+    GAIN_SCHEDULE_SOURCE_NONE = 0,
+    GAIN_SCHEDULE_SOURCE_THROTTLE,      // [us]
+    GAIN_SCHEDULE_SOURCE_AIRSPEED,      // [cm/s]
+    GAIN_SCHEDULE_SOURCE_ALTITUDE,      // [m]
+    GAIN_SCHEDULE_SOURCE_VOLTAGE,       // [0.01V]
+    GAIN_SCHEDULE_SOURCE_VOLTAGE_SAG,   // Sag compensated minus measured voltage [0.01V]
+} gainScheduleSource_e;
+
+typedef struct gainScheduleConfig_s {
+    uint8_t source[GAIN_SCHEDULE_INPUT_COUNT];
+    int16_t breakpoints[GAIN_SCHEDULE_INPUT_COUNT][GAIN_SCHEDULE_POINTS];  // Strictly increasing
+    uint8_t factor[GAIN_SCHEDULE_POINTS][GAIN_SCHEDULE_POINTS];            // [y][x], percent of the rate PID gains
+} gainScheduleConfig_t;
+
+PG_DECLARE(gainScheduleConfig_t, gainScheduleConfig);
+
+/*
+ * The configured table resampled on a uniform grid, so a lookup is a scale, a truncation and
+ * four reads whatever the breakpoints are.
+ */
+typedef struct gainScheduleGrid_s {
+    bool enabled;
+    float origin[GAIN_SCHEDULE_INPUT_COUNT];
+    float scale[GAIN_SCHEDULE_INPUT_COUNT];        // Grid cells per input unit, 0 for an unused input
+    float node[GAIN_SCHEDULE_GRID][GAIN_SCHEDULE_GRID];
+} gainScheduleGrid_t;
+
+bool gainScheduleCompile(gainScheduleGrid_t *grid, const gainScheduleConfig_t *config);
+float gainScheduleLookup(const gainScheduleGrid_t *grid, float x, float y);
+
+void gainScheduleInit(void);
+bool gainScheduleIsEnabled(void);
+float gainScheduleGetFactor(float x, float y);
+void gainScheduleResetConfig(gainScheduleConfig_t *config);
+void gainScheduleValidateConfig(gainScheduleConfig_t *config);
@@ -127,28 +127,30 @@ PG_RESET_TEMPLATE(imuConfig_t, imuConfig,
 
 STATIC_UNIT_TESTED void imuComputeRotationMatrix(void)
 {
-    float q1q1 = orientation.q1 * orientation.q1;
-    float q2q2 = orientation.q2 * orientation.q2;
-    float q3q3 = orientation.q3 * orientation.q3;
-
-    float q0q1 = orientation.q0 * orientation.q1;
-    float q0q2 = orientation.q0 * orientation.q2;
-    float q0q3 = orientation.q0 * orientation.q3;
-    float q1q2 = orientation.q1 * orientation.q2;
-    float q1q3 = orientation.q1 * orientation.q3;
-    float q2q3 = orientation.q2 * orientation.q3;
-
-    rMat[0][0] = 1.0f - 2.0f * q2q2 - 2.0f * q3q3;
-    rMat[0][1] = 2.0f * (q1q2 + -q0q3);
-    rMat[0][2] = 2.0f * (q1q3 - -q0q2);
-
-    rMat[1][0] = 2.0f * (q1q2 - -q0q3);
-    rMat[1][1] = 1.0f - 2.0f * q1q1 - 2.0f * q3q3;
-    rMat[1][2] = 2.0f * (q2q3 + -q0q1);
-
-    rMat[2][0] = 2.0f * (q1q3 + -q0q2);
-    rMat[2][1] = 2.0f * (q2q3 - -q0q1);
-    rMat[2][2] = 1.0f - 2.0f * q1q1 - 2.0f * q2q2;
+    quaternionToRotationMatrix(rMat, &orientation);
+}
+
+/*
+ * rMat is rebuilt every time orientation changes, so within a cycle it is the
+ * cached body <-> earth transform. Rotating through it costs 9 multiplies versus
+ * two full quaternion products for quaternionRotateVector[Inv]().
+ */
+static inline void imuRotateVectorBodyToEarth(fpVector3_t * result, const fpVector3_t * v)
+{
+    const fpVector3_t t = *v;
+
+    result->x = rMat[0][0] * t.x + rMat[0][1] * t.y + rMat[0][2] * t.z;
+    result->y = rMat[1][0] * t.x + rMat[1][1] * t.y + rMat[1][2] * t.z;
+    result->z = rMat[2][0] * t.x + rMat[2][1] * t.y + rMat[2][2] * t.z;
+}
+
+static inline void imuRotateVectorEarthToBody(fpVector3_t * result, const fpVector3_t * v)
+{
+    const fpVector3_t t = *v;
+
+    result->x = rMat[0][0] * t.x + rMat[1][0] * t.y + rMat[2][0] * t.z;
+    result->y = rMat[0][1] * t.x + rMat[1][1] * t.y + rMat[2][1] * t.z;
+    result->z = rMat[0][2] * t.x + rMat[1][2] * t.y + rMat[2][2] * t.z;
 }
 
 void imuConfigure(void)
@@ -208,7 +210,7 @@ void imuSetMagneticDeclination(float declinationDeg)
 void imuTransformVectorBodyToEarth(fpVector3_t * v)
 {
     // From body frame to earth frame
-    quaternionRotateVectorInv(v, v, &orientation);
+    imuRotateVectorBodyToEarth(v, v);
 
     // HACK: This is needed to correctly transform from NED (sensor frame) to NEU (navigation)
     v->y = -v->y;
@@ -220,7 +222,7 @@ void imuTransformVectorEarthToBody(fpVector3_t * v)
     v->y = -v->y;
 
     // From earth frame to body frame
-    quaternionRotateVector(v, v, &orientation);
+    imuRotateVectorEarthToBody(v, v);
 }
 
 #if defined(USE_GPS)
@@ -339,8 +341,6 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
     /* Step 1: Yaw correction */
     // Use measured magnetic field vector
     if (magBF || useCOG) {
-        static const fpVector3_t vForward = { .v = { 1.0f, 0.0f, 0.0f } };
-
         fpVector3_t vErr = { .v = { 0.0f, 0.0f, 0.0f } };
 
         if (magBF && vectorNormSquared(magBF) > 0.01f) {
@@ -351,7 +351,7 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
 
             // (hx; hy; 0) - measured mag field vector in EF (assuming Z-component is zero)
             // This should yield direction to magnetic North (1; 0; 0)
-            quaternionRotateVectorInv(&vMag, magBF, &orientation);    // BF -> EF
+            imuRotateVectorBodyToEarth(&vMag, magBF);    // BF -> EF
 
             // Ignore magnetic inclination
             vMag.z = 0.0f;
@@ -372,7 +372,7 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
                 vectorCrossProduct(&vErr, &vMag, &vCorrectedMagNorth);
 
                 // Rotate error back into body frame
-                quaternionRotateVector(&vErr, &vErr, &orientation);
+                imuRotateVectorEarthToBody(&vErr, &vErr);
             }
         }
         else if (useCOG) {
@@ -399,8 +399,10 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
             }
 #endif
 
-            // Rotate Forward vector from BF to EF - will yield Heading vector in Earth frame
-            quaternionRotateVectorInv(&vHeadingEF, &vForward, &orientation);
+            // Rotate Forward vector (1; 0; 0) from BF to EF - will yield Heading vector in Earth frame.
+            // This is the first column of the rotation matrix
+            vHeadingEF.x = rMat[0][0];
+            vHeadingEF.y = rMat[1][0];
             vHeadingEF.z = 0.0f;
 
             // We zeroed out vHeadingEF.z -  make sure the whole vector didn't go to zero
@@ -412,7 +414,7 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
                 vectorCrossProduct(&vErr, &vCoG, &vHeadingEF);
 
                 // Rotate error back into body frame
-                quaternionRotateVector(&vErr, &vErr, &orientation);
+                imuRotateVectorEarthToBody(&vErr, &vErr);
             }
         }
 
@@ -436,11 +438,12 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
 
     /* Step 2: Roll and pitch correction -  use measured acceleration vector */
     if (accBF) {
-        static const fpVector3_t vGravity = { .v = { 0.0f, 0.0f, 1.0f } };
         fpVector3_t vEstGravity, vAcc, vErr;
 
-        // Calculate estimated gravity vector in body frame
-        quaternionRotateVector(&vEstGravity, &vGravity, &orientation);    // EF -> BF
+        // Calculate estimated gravity vector in body frame: (0; 0; 1) EF -> BF is the last row of the rotation matrix
+        vEstGravity.x = rMat[2][0];
+        vEstGravity.y = rMat[2][1];
+        vEstGravity.z = rMat[2][2];
 
         // Error is sum of cross product between estimated direction and measured direction of gravity
         vectorNormalize(&vAcc, accBF);
@@ -621,7 +624,7 @@ static void imuCalculateGPSacceleration(fpVector3_t *vEstcentrifugalAccelBF, flo
         vGPSacc.y = (currentGPSvel.y - lastGPSvel.y) / (MS2S(time_delta_ms));
         vGPSacc.z = (currentGPSvel.z - lastGPSvel.z) / (MS2S(time_delta_ms));
         // Calculate estimated centrifugal accleration vector in body frame
-        quaternionRotateVector(vEstcentrifugalAccelBF, &vGPSacc, &orientation); // EF -> BF
+        imuRotateVectorEarthToBody(vEstcentrifugalAccelBF, &vGPSacc); // EF -> BF
         lastGPSNewDataTime = currenttime;
         lastGPSvel = currentGPSvel;
     }
@@ -819,7 +822,7 @@ bool isImuHeadingValid(void)
 
 float calculateCosTiltAngle(void)
 {
-    return 1.0f - 2.0f * sq(orientation.q1) - 2.0f * sq(orientation.q2);
+    return rMat[2][2];
 }
 
 #if defined(SITL_BUILD) || defined (USE_SIMULATOR)
@@ -48,6 +48,7 @@
 #include "flight/failsafe.h"
 #include "flight/imu.h"
 #include "flight/mixer.h"
+#include "flight/mixer_matrix.h"
 #include "flight/pid.h"
 #include "flight/servos.h"
 
@@ -62,6 +63,7 @@ FASTRAM int16_t motor_disarmed[MAX_SUPPORTED_MOTORS];
 static float motorMixRange;
 static float mixerScale = 1.0f;
 static EXTENDED_FASTRAM motorMixer_t currentMixer[MAX_SUPPORTED_MOTORS];
+static EXTENDED_FASTRAM mixerMatrix_t mixerMatrix;
 static EXTENDED_FASTRAM uint8_t motorCount = 0;
 EXTENDED_FASTRAM int mixerThrottleCommand;
 static EXTENDED_FASTRAM int throttleIdleValue = 0;
@@ -83,7 +85,7 @@ PG_RESET_TEMPLATE(reversibleMotorsConfig_t, reversibleMotorsConfig,
     .neutral = SETTING_3D_NEUTRAL_DEFAULT
 );
 
-PG_REGISTER_WITH_RESET_TEMPLATE(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 10);
+PG_REGISTER_WITH_RESET_TEMPLATE(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 11);
 
 PG_RESET_TEMPLATE(motorConfig_t, motorConfig,
     .motorPwmProtocol = SETTING_MOTOR_PWM_PROTOCOL_DEFAULT,
@@ -91,6 +93,9 @@ PG_RESET_TEMPLATE(motorConfig_t, motorConfig,
     .maxthrottle = SETTING_MAX_THROTTLE_DEFAULT,
     .mincommand = SETTING_MIN_COMMAND_DEFAULT,
     .motorPoleCount = SETTING_MOTOR_POLES_DEFAULT,            // Most brushless motors that we use are 14 poles
+#ifdef USE_DSHOT_TELEMETRY
+    .dshotBidir = SETTING_DSHOT_BIDIR_DEFAULT,
+#endif
 );
 PG_REGISTER_ARRAY_WITH_RESET_FN(timerOverride_t, HARDWARE_TIMER_DEFINITION_COUNT, timerOverrides, PG_TIMER_OVERRIDE_CONFIG, 0);
 
@@ -226,6 +231,8 @@ void mixerInit(void)
     } else {
         motorYawMultiplier = 1;
     }
+
+    mixerMatrixCompile(&mixerMatrix, currentMixer, motorCount, mixerScale, -motorYawMultiplier);
 }
 
 void mixerResetDisarmedMotors(void)
@@ -521,24 +528,11 @@ void FAST_CODE mixTable(void)
     }
 
     // Initial mixer concept by bdoiron74 reused and optimized for Air Mode
-    int16_t rpyMix[MAX_SUPPORTED_MOTORS];
-    int16_t rpyMixMax = 0; // assumption: symetrical about zero.
-    int16_t rpyMixMin = 0;
+    float rpyMix[MAX_SUPPORTED_MOTORS];
+    float rpyMixMin, rpyMixMax;
 
     // motors for non-servo mixes
-    for (int i = 0; i < motorCount; i++) {
-        rpyMix[i] =
-            (input[PITCH] * currentMixer[i].pitch +
-            input[ROLL] * currentMixer[i].roll +
-            -motorYawMultiplier * input[YAW] * currentMixer[i].yaw) * mixerScale;
-
-        if (rpyMix[i] > rpyMixMax) rpyMixMax = rpyMix[i];
-        if (rpyMix[i] < rpyMixMin) rpyMixMin = rpyMix[i];
-    }
-
-    int16_t rpyMixRange = rpyMixMax - rpyMixMin;
-    int16_t throttleRange;
-    int16_t throttleMin, throttleMax;
+    mixerMatrixApplyRPY(&mixerMatrix, input[ROLL], input[PITCH], input[YAW], rpyMix, &rpyMixMin, &rpyMixMax);
 
     // Find min and max throttle based on condition.
 #ifdef USE_PROGRAMMING_FRAMEWORK
@@ -598,29 +592,15 @@ void FAST_CODE mixTable(void)
         }
     }
 
-    throttleMin = throttleRangeMin;
-    throttleMax = throttleRangeMax;
-    throttleRange = throttleMax - throttleMin;
-
     #define THROTTLE_CLIPPING_FACTOR    0.33f
-    motorMixRange = (float)rpyMixRange / (float)throttleRange;
-    if (motorMixRange > 1.0f) {
-        for (int i = 0; i < motorCount; i++) {
-            rpyMix[i] /= motorMixRange;
-        }
-
-        // Allow some clipping on edges to soften correction response
-        throttleMin = throttleMin + (throttleRange / 2) - (throttleRange * THROTTLE_CLIPPING_FACTOR / 2);
-        throttleMax = throttleMin + (throttleRange / 2) + (throttleRange * THROTTLE_CLIPPING_FACTOR / 2);
-    } else {
-        throttleMin = MIN(throttleMin + (rpyMixRange / 2), throttleMin + (throttleRange / 2) - (throttleRange * THROTTLE_CLIPPING_FACTOR / 2));
-        throttleMax = MAX(throttleMax - (rpyMixRange / 2), throttleMin + (throttleRange / 2) + (throttleRange * THROTTLE_CLIPPING_FACTOR / 2));
-    }
+    mixerDesaturation_t desaturation;
+    mixerDesaturate(rpyMix, motorCount, rpyMixMin, rpyMixMax, throttleRangeMin, throttleRangeMax, THROTTLE_CLIPPING_FACTOR, &desaturation);
+    motorMixRange = desaturation.mixRange;
 
     // Now add in the desired throttle, but keep in a range that doesn't clip adjusted
     // roll/pitch/yaw. This could move throttle down, but also up for those low throttle flips.
     for (int i = 0; i < motorCount; i++) {
-        motor[i] = rpyMix[i] + constrain(mixerThrottleCommand * currentMixer[i].throttle, throttleMin, throttleMax);
+        motor[i] = rpyMix[i] + constrainf(mixerThrottleCommand * mixerMatrix.throttle[i], desaturation.throttleMin, desaturation.throttleMax);
 
         if (failsafeIsActive()) {
             motor[i] = constrain(motor[i], motorConfig()->mincommand, motorConfig()->maxthrottle);
@@ -21,11 +21,7 @@
 
 #include "drivers/timer.h"
 
-#if defined(TARGET_MOTOR_COUNT)
-#define MAX_SUPPORTED_MOTORS TARGET_MOTOR_COUNT
-#else
-#define MAX_SUPPORTED_MOTORS 12
-#endif
+#include "flight/mixer_matrix.h"
 
 // Digital protocol has fixed values
 #define DSHOT_DISARM_COMMAND      0
@@ -56,15 +52,6 @@ typedef struct motorAxisCorrectionLimits_s {
     int16_t max;
 } motorAxisCorrectionLimits_t;
 
-// Custom mixer data per motor
-typedef struct motorMixer_s {
-    float throttle;
-    float roll;
-    float pitch;
-    float yaw;
-} motorMixer_t;
-
-
 typedef struct timerOverride_s {
     uint8_t outputMode;
 } timerOverride_t;
@@ -87,6 +74,9 @@ typedef struct motorConfig_s {
     uint8_t  motorPwmProtocol;
     uint16_t digitalIdleOffsetValue;
     uint8_t motorPoleCount;                 // Magnetic poles in the motors for calculating actual RPM from eRPM provided by ESC telemetry
+#ifdef USE_DSHOT_TELEMETRY
+    bool dshotBidir;                        // Bidirectional DShot, ESCs report eRPM after every frame
+#endif
 } motorConfig_t;
 
 PG_DECLARE(motorConfig_t, motorConfig);
@@ -0,0 +1,82 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#include "common/maths.h"
+
+#include "flight/mixer_matrix.h"
+
+void mixerMatrixCompile(mixerMatrix_t *matrix, const motorMixer_t *rules, uint8_t motorCount, float rpyScale, float yawScale)
+{
+    memset(matrix, 0, sizeof(*matrix));
+    matrix->motorCount = MIN(motorCount, MAX_SUPPORTED_MOTORS);
+
+    for (int i = 0; i < matrix->motorCount; i++) {
+        matrix->throttle[i] = rules[i].throttle;
+        matrix->roll[i] = rules[i].roll * rpyScale;
+        matrix->pitch[i] = rules[i].pitch * rpyScale;
+        matrix->yaw[i] = rules[i].yaw * rpyScale * yawScale;
+    }
+}
+
+void FAST_CODE mixerMatrixApplyRPY(const mixerMatrix_t *matrix, float roll, float pitch, float yaw, float *rpyMix, float *rpyMixMin, float *rpyMixMax)
+{
+    // Symmetric mixes are centered on zero, start from there so an all-positive mix still reports a minimum of 0
+    float mixMin = 0.0f;
+    float mixMax = 0.0f;
+
+    for (int i = 0; i < matrix->motorCount; i++) {
+        const float mix = roll * matrix->roll[i] + pitch * matrix->pitch[i] + yaw * matrix->yaw[i];
+        rpyMix[i] = mix;
+        mixMin = MIN(mixMin, mix);
+        mixMax = MAX(mixMax, mix);
+    }
+
+    *rpyMixMin = mixMin;
+    *rpyMixMax = mixMax;
+}
+
+void FAST_CODE mixerDesaturate(float *rpyMix, uint8_t motorCount, float rpyMixMin, float rpyMixMax,
+    float throttleRangeMin, float throttleRangeMax, float clippingFactor, mixerDesaturation_t *result)
+{
+    const float throttleRange = throttleRangeMax - throttleRangeMin;
+    const float throttleCenter = throttleRangeMin + throttleRange / 2;
+    const float clippingWindow = throttleRange * clippingFactor / 2;
+
+    result->mixRange = throttleRange > 0 ? (rpyMixMax - rpyMixMin) / throttleRange : 0.0f;
+
+    if (result->mixRange > 1.0f) {
+        const float scale = 1.0f / result->mixRange;
+        for (int i = 0; i < motorCount; i++) {
+            rpyMix[i] *= scale;
+        }
+
+        // Allow some clipping on edges to soften correction response
+        result->throttleMin = throttleCenter - clippingWindow;
+        result->throttleMax = throttleCenter + clippingWindow;
+        return;
+    }
+
+    // Throttle values for which the lowest and the highest motor just fit
+    result->throttleMin = MIN(throttleRangeMin - rpyMixMin, throttleCenter - clippingWindow);
+    result->throttleMax = MAX(throttleRangeMax - rpyMixMax, throttleCenter + clippingWindow);
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "platform.h"
+
+#if defined(TARGET_MOTOR_COUNT)
+#define MAX_SUPPORTED_MOTORS TARGET_MOTOR_COUNT
+#else
+#define MAX_SUPPORTED_MOTORS 12
+#endif
+
+// Custom mixer data per motor
+typedef struct motorMixer_s {
+    float throttle;
+    float roll;
+    float pitch;
+    float yaw;
+} motorMixer_t;
+
+/*
+ * Motor mixer rules compiled into a motors x 4 matrix, one column per input.
+ * Global gains (reversible motors scaling, yaw direction) are folded into the
+ * columns at compile time so the per-loop kernel is a plain multiply-add.
+ */
+typedef struct mixerMatrix_s {
+    uint8_t motorCount;
+    float throttle[MAX_SUPPORTED_MOTORS];
+    float roll[MAX_SUPPORTED_MOTORS];
+    float pitch[MAX_SUPPORTED_MOTORS];
+    float yaw[MAX_SUPPORTED_MOTORS];
+} mixerMatrix_t;
+
+typedef struct mixerDesaturation_s {
+    float mixRange;         // RPY span relative to the throttle range, above 1.0 the RPY mix was scaled down
+    float throttleMin;      // Window the throttle command is constrained to
+    float throttleMax;
+} mixerDesaturation_t;
+
+void mixerMatrixCompile(mixerMatrix_t *matrix, const motorMixer_t *rules, uint8_t motorCount, float rpyScale, float yawScale);
+
+// Computes the RPY part of every motor output, returns the min and max of the mix
+void mixerMatrixApplyRPY(const mixerMatrix_t *matrix, float roll, float pitch, float yaw, float *rpyMix, float *rpyMixMin, float *rpyMixMax);
+
+/*
+ * Fits the RPY mix into [throttleRangeMin, throttleRangeMax]. When the mix is wider than the range it is scaled down
+ * and the throttle window is clippingFactor of the range around its center, allowing some clipping to soften
+ * corrections. Otherwise the window is as wide as possible while keeping every motor unclipped, and never narrower
+ * than that.
+ */
+void mixerDesaturate(float *rpyMix, uint8_t motorCount, float rpyMixMin, float rpyMixMax,
+    float throttleRangeMin, float throttleRangeMax, float clippingFactor, mixerDesaturation_t *result);
@@ -44,9 +44,11 @@
 #include "flight/imu.h"
 #include "flight/mixer.h"
 #include "flight/mixer_profile.h"
+#include "flight/gain_schedule.h"
 #include "flight/rpm_filter.h"
 #include "flight/kalman.h"
 #include "flight/smith_predictor.h"
+#include "flight/system_identification.h"
 
 #include "io/gps.h"
 
@@ -115,7 +117,21 @@ static EXTENDED_FASTRAM int16_t headingHoldTarget;
 static EXTENDED_FASTRAM pt1Filter_t headingHoldRateFilter;
 static EXTENDED_FASTRAM pt1Filter_t fixedWingTpaFilter;
 
-// Thrust PID Attenuation factor. 0.0f means fully attenuated, 1.0f no attenuation is applied
+// Rate PID gains before TPA and gain scheduling, only recalculated when the PID settings change
+typedef struct {
+    float kP;
+    float kI;
+    float kD;
+    float kFF;
+    float kCD;
+    float trackingPI;   // kP / kI of the unscaled gains, 0 when tracking anti-windup is not used
+    float trackingDP;   // kD / kP of the unscaled gains
+} pidBaseGains_t;
+
+static pidBaseGains_t pidBaseGains[XYZ_AXIS_COUNT];
+static float pidAppliedTpaFactor;
+static float pidAppliedScheduleFactor;
+
 STATIC_FASTRAM bool pidGainsUpdateRequired;
 FASTRAM int16_t axisPID[FLIGHT_DYNAMICS_INDEX_COUNT];
 
@@ -478,76 +494,152 @@ void schedulePidGainsUpdate(void)
     pidGainsUpdateRequired = true;
 }
 
-void updatePIDCoefficients(void)
+#ifdef USE_GAIN_SCHEDULE
+static float getGainScheduleInput(gainScheduleInput_e input)
 {
-    STATIC_FASTRAM uint16_t prevThrottle = 0;
-
-    // Check if throttle changed. Different logic for fixed wing vs multirotor
-    if (usedPidControllerType == PID_TYPE_PIFF && (currentControlRateProfile->throttle.fixedWingTauMs > 0)) {
-        uint16_t filteredThrottle = pt1FilterApply(&fixedWingTpaFilter, rcCommand[THROTTLE]);
-        if (filteredThrottle != prevThrottle) {
-            prevThrottle = filteredThrottle;
-            pidGainsUpdateRequired = true;
-        }
-    }
-    else {
-        if (rcCommand[THROTTLE] != prevThrottle) {
-            prevThrottle = rcCommand[THROTTLE];
-            pidGainsUpdateRequired = true;
+    switch ((gainScheduleSource_e)gainScheduleConfig()->source[input]) {
+    case GAIN_SCHEDULE_SOURCE_THROTTLE:
+        return rcCommand[THROTTLE];
+    case GAIN_SCHEDULE_SOURCE_AIRSPEED:
+#ifdef USE_PITOT
+        if (sensors(SENSOR_PITOT) && pitotIsHealthy()) {
+            return getAirspeedEstimate();
         }
+#endif
+        return pidProfile()->fixedWingReferenceAirspeed;
+    case GAIN_SCHEDULE_SOURCE_ALTITUDE:
+        return getEstimatedActualPosition(Z) / 100.0f;
+    case GAIN_SCHEDULE_SOURCE_VOLTAGE:
+        return getBatteryVoltage();
+    case GAIN_SCHEDULE_SOURCE_VOLTAGE_SAG:
+        return (int)getBatterySagCompensatedVoltage() - (int)getBatteryRawVoltage();
+    case GAIN_SCHEDULE_SOURCE_NONE:
+    default:
+        return 0.0f;
     }
+}
+#endif
 
-#ifdef USE_ANTIGRAVITY
-    if (usedPidControllerType == PID_TYPE_PID) {
-        antigravityThrottleHpf = rcCommand[THROTTLE] - pt1FilterApply(&antigravityThrottleLpf, rcCommand[THROTTLE]);
-        iTermAntigravityGain = scaleRangef(fabsf(antigravityThrottleHpf) * antigravityAccelerator, 0.0f, 1000.0f, 1.0f, antigravityGain);
+static float calculateGainScheduleFactor(void)
+{
+#ifdef USE_GAIN_SCHEDULE
+    // Like TPA, the schedule stays out of the way of autotune
+    if (gainScheduleIsEnabled() && !FLIGHT_MODE(AUTO_TUNE)) {
+        return gainScheduleGetFactor(getGainScheduleInput(GAIN_SCHEDULE_INPUT_X), getGainScheduleInput(GAIN_SCHEDULE_INPUT_Y));
     }
 #endif
+    return 1.0f;
+}
 
-    /*
-     * Compute stick position in range of [-1.0f : 1.0f] without deadband and expo
-     */
+static void updatePIDBaseGains(void)
+{
     for (int axis = 0; axis < 3; axis++) {
-        pidState[axis].stickPosition = constrain(rxGetChannelValue(axis) - PWM_RANGE_MIDDLE, -500, 500) / 500.0f;
-    }
+        pidBaseGains_t *gains = &pidBaseGains[axis];
 
-    // If nothing changed - don't waste time recalculating coefficients
-    if (!pidGainsUpdateRequired) {
-        return;
-    }
+        gains->kP = pidBank()->pid[axis].P / FP_PID_RATE_P_MULTIPLIER;
+        gains->kI = pidBank()->pid[axis].I / FP_PID_RATE_I_MULTIPLIER;
+        gains->kD = pidBank()->pid[axis].D / FP_PID_RATE_D_MULTIPLIER;
+        gains->trackingPI = 0.0f;
+        gains->trackingDP = 0.0f;
+
+        if (usedPidControllerType == PID_TYPE_PIFF) {
+            gains->kFF = pidBank()->pid[axis].FF / FP_PID_RATE_FF_MULTIPLIER;
+            gains->kCD = 0.0f;
+        }
+        else {
+            gains->kFF = 0.0f;
+            gains->kCD = (pidBank()->pid[axis].FF / FP_PID_RATE_D_FF_MULTIPLIER) / (getLooptime() * 0.000001f);
 
-    const float tpaFactor = usedPidControllerType == PID_TYPE_PIFF ? calculateFixedWingTPAFactor(prevThrottle) : calculateMultirotorTPAFactor();
+            // Tracking anti-windup requires P/I/D to be all defined which is only true for MC
+            if ((pidBank()->pid[axis].P != 0) && (pidBank()->pid[axis].I != 0) && (usedPidControllerType == PID_TYPE_PID)) {
+                gains->trackingPI = gains->kP / gains->kI;
+                gains->trackingDP = gains->kD / gains->kP;
+            }
+        }
+    }
+}
 
-    // PID coefficients can be update only with THROTTLE and TPA or inflight PID adjustments
-    //TODO: Next step would be to update those only at THROTTLE or inflight adjustments change
+/*
+ * TPA scales P, D and FF of roll and pitch on multirotors and the whole rate PID on airplanes,
+ * the gain schedule scales the whole rate PID of all axes.
+ */
+static void applyPIDGainFactors(float tpaFactor, float scheduleFactor)
+{
     for (int axis = 0; axis < 3; axis++) {
+        const pidBaseGains_t *gains = &pidBaseGains[axis];
+
         if (usedPidControllerType == PID_TYPE_PIFF) {
             // Airplanes - scale all PIDs according to TPA
-            pidState[axis].kP  = pidBank()->pid[axis].P / FP_PID_RATE_P_MULTIPLIER  * tpaFactor;
-            pidState[axis].kI  = pidBank()->pid[axis].I / FP_PID_RATE_I_MULTIPLIER  * tpaFactor;
-            pidState[axis].kD  = pidBank()->pid[axis].D / FP_PID_RATE_D_MULTIPLIER * tpaFactor;
-            pidState[axis].kFF = pidBank()->pid[axis].FF / FP_PID_RATE_FF_MULTIPLIER * tpaFactor;
+            const float factor = tpaFactor * scheduleFactor;
+            pidState[axis].kP  = gains->kP * factor;
+            pidState[axis].kI  = gains->kI * factor;
+            pidState[axis].kD  = gains->kD * factor;
+            pidState[axis].kFF = gains->kFF * factor;
             pidState[axis].kCD = 0.0f;
             pidState[axis].kT  = 0.0f;
         }
         else {
             const float axisTPA = (axis == FD_YAW) ? 1.0f : tpaFactor;
-            pidState[axis].kP  = pidBank()->pid[axis].P / FP_PID_RATE_P_MULTIPLIER * axisTPA;
-            pidState[axis].kI  = pidBank()->pid[axis].I / FP_PID_RATE_I_MULTIPLIER;
-            pidState[axis].kD  = pidBank()->pid[axis].D / FP_PID_RATE_D_MULTIPLIER * axisTPA;
-            pidState[axis].kCD = (pidBank()->pid[axis].FF / FP_PID_RATE_D_FF_MULTIPLIER * axisTPA) / (getLooptime() * 0.000001f);
+            const float factor = axisTPA * scheduleFactor;
+            pidState[axis].kP  = gains->kP * factor;
+            pidState[axis].kI  = gains->kI * scheduleFactor;
+            pidState[axis].kD  = gains->kD * factor;
+            pidState[axis].kCD = gains->kCD * factor;
             pidState[axis].kFF = 0.0f;
 
-            // Tracking anti-windup requires P/I/D to be all defined which is only true for MC
-            if ((pidBank()->pid[axis].P != 0) && (pidBank()->pid[axis].I != 0) && (usedPidControllerType == PID_TYPE_PID)) {
-                pidState[axis].kT = 2.0f / ((pidState[axis].kP / pidState[axis].kI) + (pidState[axis].kD / pidState[axis].kP));
+            // The common schedule factor cancels out, only TPA changes the P to I ratio
+            if (gains->trackingPI != 0.0f) {
+                pidState[axis].kT = 2.0f / (gains->trackingPI * axisTPA + gains->trackingDP);
             } else {
                 pidState[axis].kT = 0;
             }
         }
     }
+}
+
+void updatePIDCoefficients(void)
+{
+    uint16_t tpaThrottle;
+
+    // Different throttle source for fixed wing vs multirotor
+    if (usedPidControllerType == PID_TYPE_PIFF && (currentControlRateProfile->throttle.fixedWingTauMs > 0)) {
+        tpaThrottle = pt1FilterApply(&fixedWingTpaFilter, rcCommand[THROTTLE]);
+    }
+    else {
+        tpaThrottle = rcCommand[THROTTLE];
+    }
+
+#ifdef USE_ANTIGRAVITY
+    if (usedPidControllerType == PID_TYPE_PID) {
+        antigravityThrottleHpf = rcCommand[THROTTLE] - pt1FilterApply(&antigravityThrottleLpf, rcCommand[THROTTLE]);
+        iTermAntigravityGain = scaleRangef(fabsf(antigravityThrottleHpf) * antigravityAccelerator, 0.0f, 1000.0f, 1.0f, antigravityGain);
+    }
+#endif
+
+    /*
+     * Compute stick position in range of [-1.0f : 1.0f] without deadband and expo
+     */
+    for (int axis = 0; axis < 3; axis++) {
+        pidState[axis].stickPosition = constrain(rxGetChannelValue(axis) - PWM_RANGE_MIDDLE, -500, 500) / 500.0f;
+    }
+
+    const bool settingsChanged = pidGainsUpdateRequired;
+    if (settingsChanged) {
+        updatePIDBaseGains();
+        pidGainsUpdateRequired = false;
+    }
+
+    const float tpaFactor = usedPidControllerType == PID_TYPE_PIFF ? calculateFixedWingTPAFactor(tpaThrottle) : calculateMultirotorTPAFactor();
+    const float scheduleFactor = calculateGainScheduleFactor();
+
+    // If nothing changed - don't waste time rescaling coefficients
+    if (!settingsChanged && tpaFactor == pidAppliedTpaFactor && scheduleFactor == pidAppliedScheduleFactor) {
+        return;
+    }
 
-    pidGainsUpdateRequired = false;
+    applyPIDGainFactors(tpaFactor, scheduleFactor);
+    pidAppliedTpaFactor = tpaFactor;
+    pidAppliedScheduleFactor = scheduleFactor;
 }
 
 static float calcHorizonRateMagnitude(void)
@@ -1079,6 +1171,10 @@ void FAST_CODE pidController(float dT)
         updateHeadingHoldTarget(DECIDEGREES_TO_DEGREES(attitude.values.yaw));
     }
 
+#ifdef USE_SYSTEM_IDENTIFICATION
+    systemIdUpdate(IS_RC_MODE_ACTIVE(BOXSYSTEMID) && ARMING_FLAG(ARMED), dT);
+#endif
+
     for (int axis = 0; axis < 3; axis++) {
         // Step 1: Calculate gyro rates
         pidState[axis].gyroRate = gyro.gyroADCf[axis];
@@ -1141,11 +1237,20 @@ void FAST_CODE pidController(float dT)
         // Apply setpoint rate of change limits
         pidApplySetpointRateLimiting(&pidState[axis], axis, dT);
 
+#ifdef USE_SYSTEM_IDENTIFICATION
+        // Frequency sweep goes on top of the limited setpoint so it is not attenuated
+        pidState[axis].rateTarget = constrainf(pidState[axis].rateTarget + systemIdGetExcitation(axis), -GYRO_SATURATION_LIMIT, +GYRO_SATURATION_LIMIT);
+#endif
+
         // Step 4: Run gyro-driven control
         checkItermLimitingActive(&pidState[axis]);
         checkItermFreezingActive(&pidState[axis], axis);
 
         pidControllerApplyFn(&pidState[axis], axis, dT, dT_inv);
+
+#ifdef USE_SYSTEM_IDENTIFICATION
+        systemIdSample(axis, axisPID_Setpoint[axis], pidState[axis].gyroRate, axisPID[axis]);
+#endif
     }
 }
 
@@ -1172,7 +1277,12 @@ void pidInit(void)
     headingHoldCosZLimit = cos_approx(DECIDEGREES_TO_RADIANS(pidProfile()->max_angle_inclination[FD_ROLL])) *
                            cos_approx(DECIDEGREES_TO_RADIANS(pidProfile()->max_angle_inclination[FD_PITCH]));
 
-    pidGainsUpdateRequired = false;
+    // Coefficients are calculated on the first update
+    pidGainsUpdateRequired = true;
+
+#ifdef USE_GAIN_SCHEDULE
+    gainScheduleInit();
+#endif
 
     itermRelax = pidProfile()->iterm_relax;
 
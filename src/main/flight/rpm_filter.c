@@ -35,10 +35,12 @@
 #include "common/utils.h"
 #include "common/maths.h"
 #include "common/filter.h"
+#include "drivers/dshot_telemetry.h"
 #include "flight/mixer.h"
 #include "sensors/esc_sensor.h"
 #include "fc/config.h"
 #include "fc/settings.h"
+#include "scheduler/scheduler.h"
 
 #ifdef USE_RPM_FILTER
 
@@ -159,9 +161,19 @@ void rpmFilterUpdate(rpmFilterBank_t *filterBank, uint8_t motor, float baseFrequ
 
 void rpmFiltersInit(void)
 {
+    float updatePeriodUs = RPM_FILTER_UPDATE_RATE_US;
+
+#ifdef USE_DSHOT_TELEMETRY
+    // Bidirectional DShot delivers fresh eRPM with every motor update, track it at loop rate
+    if (dshotTelemetryIsEnabled()) {
+        updatePeriodUs = getLooptime();
+        rescheduleTask(TASK_RPM_FILTER, getLooptime());
+    }
+#endif
+
     for (uint8_t i = 0; i < MAX_SUPPORTED_MOTORS; i++)
     {
-        pt1FilterInit(&motorFrequencyFilter[i], RPM_FILTER_RPM_LPF_HZ, US2S(RPM_FILTER_UPDATE_RATE_US));
+        pt1FilterInit(&motorFrequencyFilter[i], RPM_FILTER_RPM_LPF_HZ, US2S(updatePeriodUs));
     }
 
     rpmGyroUpdateFn = (rpmFilterUpdateFnPtr)nullRpmFilterUpdate;
@@ -188,8 +200,18 @@ void rpmFilterUpdateTask(timeUs_t currentTimeUs)
      */
     for (uint8_t i = 0; i < motorCount; i++)
     {
-        const escSensorData_t *escState = getEscTelemetry(i); //Get ESC telemetry
-        const float baseFrequency = pt1FilterApply(&motorFrequencyFilter[i], escState->rpm * HZ_TO_RPM); //Filter motor frequency
+        uint32_t rpm = 0;
+#ifdef USE_ESC_SENSOR
+        rpm = getEscTelemetry(i)->rpm; //Get ESC telemetry
+#endif
+#ifdef USE_DSHOT_TELEMETRY
+        // Bidirectional DShot reports every motor on every frame, prefer it over the serial ESC sensor
+        uint32_t erpm;
+        if (dshotTelemetryGetErpm(i, currentTimeUs, &erpm)) {
+            rpm = erpm / MAX(motorConfig()->motorPoleCount / 2, 1);
+        }
+#endif
+        const float baseFrequency = pt1FilterApply(&motorFrequencyFilter[i], rpm * HZ_TO_RPM); //Filter motor frequency
 
         rpmGyroUpdateFn(&gyroRpmFilters, i, baseFrequency);
     }
@@ -117,12 +117,44 @@ static bool mixerUsesServos;
 static uint8_t minServoIndex;
 static uint8_t maxServoIndex;
 
-static biquadFilter_t servoFilter[MAX_SUPPORTED_SERVOS];
+// All servos share the lowpass cutoff, keep one set of coefficients and only the state per servo
+typedef struct servoFilterBank_s {
+    biquadFilter_t coeffs;
+    float x1[MAX_SUPPORTED_SERVOS];
+    float x2[MAX_SUPPORTED_SERVOS];
+} servoFilterBank_t;
+
+static servoFilterBank_t servoFilterBank;
 static bool servoFilterIsSet;
 
 static servoMetadata_t servoMetadata[MAX_SUPPORTED_SERVOS];
 static rateLimitFilter_t servoSpeedLimitFilter[MAX_SERVO_RULES];
 
+/*
+ * Rules compiled by loadCustomServoMixer(), sorted by their logic condition. Rules sharing a
+ * condition form a group, the condition is checked once per group and a group that is gated
+ * off and has no speed limited rules is skipped as a whole.
+ */
+typedef struct servoCompiledRule_s {
+    const int16_t *input;
+    int16_t rate;
+    float speedLimit;                       // us/s, 0 = unlimited
+    uint8_t target;
+} servoCompiledRule_t;
+
+typedef struct servoRuleGroup_s {
+    int8_t conditionId;
+    uint8_t firstRule;
+    uint8_t ruleCount;
+    bool hasSpeedLimit;
+} servoRuleGroup_t;
+
+static int16_t servoMixerInput[INPUT_SOURCE_COUNT]; // Range [-500:+500]
+static servoCompiledRule_t servoCompiledRules[MAX_SERVO_RULES];
+static servoRuleGroup_t servoRuleGroups[MAX_SERVO_RULES];
+static uint8_t servoRuleGroupCount;
+static uint32_t servoThrottleTargetMask;    // Servos with a throttle input, held low when disarmed
+
 STATIC_FASTRAM pt1Filter_t rotRateFilter;
 STATIC_FASTRAM pt1Filter_t targetRateFilter;
 
@@ -203,6 +235,62 @@ int getServoCount(void)
     }
 }
 
+static int8_t servoRuleConditionId(const servoMixer_t *rule)
+{
+#ifdef USE_PROGRAMMING_FRAMEWORK
+    // All negative ids mean the rule is always active
+    return rule->conditionId < 0 ? -1 : rule->conditionId;
+#else
+    UNUSED(rule);
+    return -1;
+#endif
+}
+
+static void compileServoMixer(void)
+{
+    uint8_t order[MAX_SERVO_RULES];
+
+    // Stable insertion sort by condition, rules keep their relative order within a group
+    for (int i = 0; i < servoRuleCount; i++) {
+        int j = i;
+        while (j > 0 && servoRuleConditionId(&currentServoMixer[order[j - 1]]) > servoRuleConditionId(&currentServoMixer[i])) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    servoRuleGroupCount = 0;
+    servoThrottleTargetMask = 0;
+
+    for (int i = 0; i < servoRuleCount; i++) {
+        const servoMixer_t *rule = &currentServoMixer[order[i]];
+        const int8_t conditionId = servoRuleConditionId(rule);
+        servoCompiledRule_t *compiled = &servoCompiledRules[i];
+
+        compiled->input = &servoMixerInput[rule->inputSource < INPUT_SOURCE_COUNT ? rule->inputSource : INPUT_MAX];
+        compiled->rate = rule->inputSource < INPUT_SOURCE_COUNT ? rule->rate : 0;
+        compiled->speedLimit = rule->speed * 10;
+        compiled->target = rule->targetChannel;
+
+        if (servoRuleGroupCount == 0 || servoRuleGroups[servoRuleGroupCount - 1].conditionId != conditionId) {
+            servoRuleGroups[servoRuleGroupCount].conditionId = conditionId;
+            servoRuleGroups[servoRuleGroupCount].firstRule = i;
+            servoRuleGroups[servoRuleGroupCount].ruleCount = 0;
+            servoRuleGroups[servoRuleGroupCount].hasSpeedLimit = false;
+            servoRuleGroupCount++;
+        }
+
+        servoRuleGroup_t *group = &servoRuleGroups[servoRuleGroupCount - 1];
+        group->ruleCount++;
+        group->hasSpeedLimit |= rule->speed > 0;
+
+        if (rule->inputSource == INPUT_STABILIZED_THROTTLE || rule->inputSource == INPUT_RC_THROTTLE) {
+            servoThrottleTargetMask |= 1 << rule->targetChannel;
+        }
+    }
+}
+
 void loadCustomServoMixer(void)
 {
     servoRuleCount = 0;
@@ -218,23 +306,32 @@ void loadCustomServoMixer(void)
         servoSpeedLimitFilter[servoRuleCount].state = 0;
         servoRuleCount++;
     }
+
+    compileServoMixer();
 }
 
 static void filterServos(void)
 {
     if (servoConfig()->servo_lowpass_freq) {
+        const biquadFilter_t *coeffs = &servoFilterBank.coeffs;
+
         // Initialize servo lowpass filter (servos are calculated at looptime rate)
         if (!servoFilterIsSet) {
+            biquadFilterInitLPF(&servoFilterBank.coeffs, servoConfig()->servo_lowpass_freq, getLooptime());
             for (int i = 0; i < MAX_SUPPORTED_SERVOS; i++) {
-                biquadFilterInitLPF(&servoFilter[i], servoConfig()->servo_lowpass_freq, getLooptime());
-                biquadFilterReset(&servoFilter[i], servo[i]);
+                servoFilterBank.x1[i] = servo[i] - (servo[i] * coeffs->b0);
+                servoFilterBank.x2[i] = (coeffs->b2 - coeffs->a2) * servo[i];
             }
             servoFilterIsSet = true;
         }
 
-        for (int i = 0; i < MAX_SUPPORTED_SERVOS; i++) {
-            // Apply servo lowpass filter and do sanity cheching
-            servo[i] = (int16_t)lrintf(biquadFilterApply(&servoFilter[i], (float)servo[i]));
+        // Outputs outside of the mixed range hold their midpoint, only the mixed servos need filtering
+        for (int i = minServoIndex; i <= maxServoIndex; i++) {
+            const float input = servo[i];
+            const float result = coeffs->b0 * input + servoFilterBank.x1[i];
+            servoFilterBank.x1[i] = coeffs->b1 * input - coeffs->a1 * result + servoFilterBank.x2[i];
+            servoFilterBank.x2[i] = coeffs->b2 * input - coeffs->a2 * result;
+            servo[i] = (int16_t)lrintf(result);
         }
     }
 
@@ -270,7 +367,7 @@ void writeServos(void)
 
 void servoMixer(float dT)
 {
-    int16_t input[INPUT_SOURCE_COUNT]; // Range [-500:+500]
+    int16_t *input = servoMixerInput;
 
     if (FLIGHT_MODE(MANUAL_MODE)) {
         input[INPUT_STABILIZED_ROLL] = rcCommand[ROLL];
@@ -359,42 +456,47 @@ void servoMixer(float dT)
     }
 
     // mix servos according to rules
-    for (int i = 0; i < servoRuleCount; i++) {
-        const uint8_t target = currentServoMixer[i].targetChannel;
-        const uint8_t from = currentServoMixer[i].inputSource;
-
-        int16_t inputRaw = input[from];
+    for (int g = 0; g < servoRuleGroupCount; g++) {
+        const servoRuleGroup_t *group = &servoRuleGroups[g];
 
         /*
          * Check if conditions for a rule are met, not all conditions apply all the time
          */
-    #ifdef USE_PROGRAMMING_FRAMEWORK
-        if (!logicConditionGetValue(currentServoMixer[i].conditionId)) {
-            inputRaw = 0;
+#ifdef USE_PROGRAMMING_FRAMEWORK
+        const bool isActive = logicConditionGetValue(group->conditionId);
+#else
+        const bool isActive = true;
+#endif
+
+        // Inactive rules contribute nothing, unless a speed limited output still has to travel back
+        if (!isActive && !group->hasSpeedLimit) {
+            continue;
         }
-    #endif
-        /*
-         * Apply mixer speed limit. 1 [one] speed unit is defined as 10us/s:
-         * 0 = no limiting
-         * 1 = 10us/s -> full servo sweep (from 1000 to 2000) is performed in 100s
-         * 10 = 100us/s -> full sweep (from 1000 to 2000)  is performed in 10s
-         * 100 = 1000us/s -> full sweep in 1s
-         */
-        int16_t inputLimited = (int16_t) rateLimitFilterApply4(&servoSpeedLimitFilter[i], inputRaw, currentServoMixer[i].speed * 10, dT);
 
-        servo[target] += ((int32_t)inputLimited * currentServoMixer[i].rate) / 100;
+        for (int i = group->firstRule; i < group->firstRule + group->ruleCount; i++) {
+            const servoCompiledRule_t *rule = &servoCompiledRules[i];
+            const int16_t inputRaw = isActive ? *rule->input : 0;
+
+            /*
+             * Apply mixer speed limit. 1 [one] speed unit is defined as 10us/s:
+             * 0 = no limiting
+             * 1 = 10us/s -> full servo sweep (from 1000 to 2000) is performed in 100s
+             * 10 = 100us/s -> full sweep (from 1000 to 2000)  is performed in 10s
+             * 100 = 1000us/s -> full sweep in 1s
+             */
+            const int16_t inputLimited = (int16_t) rateLimitFilterApply4(&servoSpeedLimitFilter[i], inputRaw, rule->speedLimit, dT);
+
+            servo[rule->target] += ((int32_t)inputLimited * rule->rate) / 100;
+        }
     }
 
     /*
      * When not armed, apply servo low position to all outputs that include a throttle or stabilized throttle in the mix
      */
-    if (!ARMING_FLAG(ARMED)) {
-        for (int i = 0; i < servoRuleCount; i++) {
-            const uint8_t target = currentServoMixer[i].targetChannel;
-            const uint8_t from = currentServoMixer[i].inputSource;
-
-            if (from == INPUT_STABILIZED_THROTTLE || from == INPUT_RC_THROTTLE) {
-                servo[target] = motorConfig()->mincommand;
+    if (!ARMING_FLAG(ARMED) && servoThrottleTargetMask) {
+        for (int i = 0; i < MAX_SUPPORTED_SERVOS; i++) {
+            if (servoThrottleTargetMask & (1 << i)) {
+                servo[i] = motorConfig()->mincommand;
             }
         }
     }
@@ -0,0 +1,239 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Frequency response measurement. An exponential sine sweep is added to the rate setpoint of one axis
+ * and setpoint, gyro and PID output are correlated with the sweep as it goes. Because the instantaneous
+ * sweep frequency is known, every sample contributes to exactly one frequency bin: the signals are
+ * demodulated with the sweep phase (a single bin DFT that follows the sweep), which needs no sample
+ * buffers and only a few multiply-adds per loop. The ratio of the demodulated gyro and setpoint gives
+ * the closed loop response, gyro over PID output the response of the plant itself.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef USE_SYSTEM_IDENTIFICATION
+
+#include "common/axis.h"
+#include "common/maths.h"
+
+#include "config/parameter_group.h"
+#include "config/parameter_group_ids.h"
+
+#include "fc/settings.h"
+
+#include "flight/system_identification.h"
+
+PG_REGISTER_WITH_RESET_TEMPLATE(systemIdConfig_t, systemIdConfig, PG_SYSTEM_ID_CONFIG, 0);
+
+PG_RESET_TEMPLATE(systemIdConfig_t, systemIdConfig,
+    .axis = SETTING_SYSID_AXIS_DEFAULT,
+    .amplitude = SETTING_SYSID_AMPLITUDE_DEFAULT,
+    .minHz = SETTING_SYSID_MIN_HZ_DEFAULT,
+    .maxHz = SETTING_SYSID_MAX_HZ_DEFAULT,
+    .duration = SETTING_SYSID_DURATION_DEFAULT,
+);
+
+// Highest sweep frequency as a fraction of the loop rate, keeps a few samples per period
+#define SYSTEM_ID_MAX_FREQUENCY_RATIO   0.2f
+
+typedef enum {
+    SIGNAL_SETPOINT = 0,
+    SIGNAL_GYRO,
+    SIGNAL_OUTPUT,
+    SIGNAL_COUNT
+} systemIdSignal_e;
+
+typedef struct systemIdBin_s {
+    uint32_t samples;
+    float basisRe;                  // Sum of the demodulation basis, removes the bias of each signal
+    float basisIm;
+    float sum[SIGNAL_COUNT];
+    float re[SIGNAL_COUNT];
+    float im[SIGNAL_COUNT];
+} systemIdBin_t;
+
+static struct {
+    systemIdState_e state;
+    bool wasRequested;
+    uint8_t axis;
+    float amplitude;
+    float minHz;
+    float maxHz;
+
+    float phase;
+    float frequency;
+    float frequencyGrowth;          // Per sample factor of the exponential sweep
+    uint32_t sampleIndex;
+    uint32_t sampleCount;
+
+    // Values of the current loop
+    bool active;
+    uint8_t bin;
+    float sinPhase;
+    float cosPhase;
+    float excitation;
+
+    systemIdBin_t bins[SYSTEM_ID_BIN_COUNT];
+} sysid;
+
+bool systemIdStart(uint8_t axis, float amplitude, float minHz, float maxHz, float durationS, float dT)
+{
+    maxHz = MIN(maxHz, SYSTEM_ID_MAX_FREQUENCY_RATIO / dT);
+
+    if (axis >= XYZ_AXIS_COUNT || minHz <= 0 || maxHz <= minHz || durationS <= 0 || dT <= 0) {
+        return false;
+    }
+
+    memset(&sysid.bins, 0, sizeof(sysid.bins));
+    sysid.axis = axis;
+    sysid.amplitude = amplitude;
+    sysid.minHz = minHz;
+    sysid.maxHz = maxHz;
+    sysid.phase = 0;
+    sysid.frequency = minHz;
+    sysid.sampleIndex = 0;
+    sysid.sampleCount = durationS / dT;
+    sysid.frequencyGrowth = powf(maxHz / minHz, 1.0f / sysid.sampleCount);
+    sysid.active = false;
+    sysid.state = SYSTEM_ID_RUNNING;
+
+    return true;
+}
+
+void systemIdUpdate(bool requested, float dT)
+{
+    if (requested && !sysid.wasRequested) {
+        const systemIdConfig_t *config = systemIdConfig();
+        systemIdStart(config->axis, config->amplitude, config->minHz, config->maxHz, config->duration, dT);
+    } else if (!requested && sysid.state == SYSTEM_ID_RUNNING) {
+        sysid.state = SYSTEM_ID_ABORTED;
+    }
+    sysid.wasRequested = requested;
+
+    sysid.active = false;
+
+    if (sysid.state != SYSTEM_ID_RUNNING) {
+        return;
+    }
+
+    if (sysid.sampleIndex >= sysid.sampleCount) {
+        sysid.state = SYSTEM_ID_DONE;
+        return;
+    }
+
+    sysid.active = true;
+    sysid.bin = (uint64_t)sysid.sampleIndex * SYSTEM_ID_BIN_COUNT / sysid.sampleCount;
+    sysid.sinPhase = sin_approx(sysid.phase);
+    sysid.cosPhase = cos_approx(sysid.phase);
+    sysid.excitation = sysid.amplitude * sysid.sinPhase;
+
+    // Advance the sweep for the next loop
+    sysid.phase += 2 * M_PIf * sysid.frequency * dT;
+    if (sysid.phase > M_PIf) {
+        sysid.phase -= 2 * M_PIf;
+    }
+    sysid.frequency *= sysid.frequencyGrowth;
+    sysid.sampleIndex++;
+}
+
+float systemIdGetExcitation(uint8_t axis)
+{
+    return (sysid.active && axis == sysid.axis) ? sysid.excitation : 0.0f;
+}
+
+void systemIdSample(uint8_t axis, float setpoint, float gyroRate, float pidOutput)
+{
+    if (!sysid.active || axis != sysid.axis) {
+        return;
+    }
+
+    systemIdBin_t *bin = &sysid.bins[sysid.bin];
+    const float values[SIGNAL_COUNT] = { setpoint, gyroRate, pidOutput };
+
+    // Multiply by exp(-j * phase)
+    for (int i = 0; i < SIGNAL_COUNT; i++) {
+        bin->sum[i] += values[i];
+        bin->re[i] += values[i] * sysid.cosPhase;
+        bin->im[i] -= values[i] * sysid.sinPhase;
+    }
+    bin->basisRe += sysid.cosPhase;
+    bin->basisIm -= sysid.sinPhase;
+    bin->samples++;
+}
+
+systemIdState_e systemIdGetState(void)
+{
+    return sysid.state;
+}
+
+uint8_t systemIdGetAxis(void)
+{
+    return sysid.axis;
+}
+
+uint8_t systemIdGetProgress(void)
+{
+    return sysid.sampleCount ? (uint64_t)sysid.sampleIndex * 100 / sysid.sampleCount : 0;
+}
+
+static void systemIdRatio(const systemIdBin_t *bin, systemIdSignal_e numerator, systemIdSignal_e denominator, float *gain, float *phase)
+{
+    const float meanN = bin->sum[numerator] / bin->samples;
+    const float meanD = bin->sum[denominator] / bin->samples;
+    const float nRe = bin->re[numerator] - meanN * bin->basisRe;
+    const float nIm = bin->im[numerator] - meanN * bin->basisIm;
+    const float dRe = bin->re[denominator] - meanD * bin->basisRe;
+    const float dIm = bin->im[denominator] - meanD * bin->basisIm;
+
+    const float dMagSq = dRe * dRe + dIm * dIm;
+    if (dMagSq <= 0) {
+        *gain = 0;
+        *phase = 0;
+        return;
+    }
+
+    // N / D = N * conj(D) / |D|^2
+    const float re = (nRe * dRe + nIm * dIm) / dMagSq;
+    const float im = (nIm * dRe - nRe * dIm) / dMagSq;
+
+    *gain = sqrtf(re * re + im * im);
+    *phase = RADIANS_TO_DEGREES(atan2_approx(im, re));
+}
+
+bool systemIdGetBin(uint8_t bin, systemIdBinResult_t *result)
+{
+    if (bin >= SYSTEM_ID_BIN_COUNT || sysid.bins[bin].samples == 0) {
+        return false;
+    }
+
+    const systemIdBin_t *b = &sysid.bins[bin];
+
+    // Geometric center of the bin, the sweep is exponential
+    result->frequencyHz = sysid.minHz * powf(sysid.maxHz / sysid.minHz, (bin + 0.5f) / SYSTEM_ID_BIN_COUNT);
+    systemIdRatio(b, SIGNAL_GYRO, SIGNAL_SETPOINT, &result->closedLoopGain, &result->closedLoopPhase);
+    systemIdRatio(b, SIGNAL_GYRO, SIGNAL_OUTPUT, &result->plantGain, &result->plantPhase);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config/parameter_group.h"
+
+#define SYSTEM_ID_BIN_COUNT     32
+
+typedef enum {
+    SYSTEM_ID_IDLE = 0,
+    SYSTEM_ID_RUNNING,
+    SYSTEM_ID_DONE,
+    SYSTEM_ID_ABORTED,
+} systemIdState_e;
+
+typedef struct systemIdConfig_s {
+    uint8_t axis;                   // Axis the sweep is injected on
+    uint16_t amplitude;             // Sweep amplitude added to the rate setpoint [deg/s]
+    uint8_t minHz;                  // Sweep start frequency
+    uint16_t maxHz;                 // Sweep end frequency
+    uint8_t duration;               // Sweep length [s]
+} systemIdConfig_t;
+
+PG_DECLARE(systemIdConfig_t, systemIdConfig);
+
+typedef struct systemIdBinResult_s {
+    float frequencyHz;
+    float closedLoopGain;           // Gyro over setpoint
+    float closedLoopPhase;          // [deg]
+    float plantGain;                // Gyro over PID output
+    float plantPhase;               // [deg]
+} systemIdBinResult_t;
+
+// Called once per PID loop, starts a sweep on a rising edge of `requested` and aborts it when `requested` drops
+void systemIdUpdate(bool requested, float dT);
+// Sweep value to add to the rate setpoint of the axis in this loop
+float systemIdGetExcitation(uint8_t axis);
+// Feeds the signals of the loop the excitation was applied in
+void systemIdSample(uint8_t axis, float setpoint, float gyroRate, float pidOutput);
+
+bool systemIdStart(uint8_t axis, float amplitude, float minHz, float maxHz, float durationS, float dT);
+systemIdState_e systemIdGetState(void);
+uint8_t systemIdGetAxis(void);
+uint8_t systemIdGetProgress(void);
+bool systemIdGetBin(uint8_t bin, systemIdBinResult_t *result);
@@ -38,7 +38,12 @@
     #define ONLY_EXPOSE_FOR_TESTING static
 #endif
 
+// Targets with RAM to spare raise this in target/common.h to ride out longer SD card busy periods
+#ifndef AFATFS_NUM_CACHE_SECTORS
 #define AFATFS_NUM_CACHE_SECTORS 8
+#endif
+
+STATIC_ASSERT(AFATFS_NUM_CACHE_SECTORS <= INT8_MAX, afatfs_cache_index_fits_int8);
 
 // FAT filesystems are allowed to differ from these parameters, but we choose not to support those weird filesystems:
 #define AFATFS_SECTOR_SIZE  512
@@ -194,6 +199,9 @@ typedef struct afatfsCacheBlockDescriptor_t {
      * is overridden by the locked and retainCount flags.
      */
     unsigned discardable:1;
+
+    // Set when the read was issued ahead of the reader, cleared on the first read from the sector
+    unsigned readAhead:1;
 } afatfsCacheBlockDescriptor_t;
 
 typedef enum {
@@ -445,6 +453,9 @@ typedef struct afatfs_t {
 
     int cacheDirtyEntries; // The number of cache entries in the AFATFS_CACHE_STATE_DIRTY state
     bool cacheFlushInProgress;
+    uint32_t lastFlushedSector; // So flushes can continue the card's current multi-block write
+
+    afatfsStats_t stats;
 
     afatfsFile_t openFiles[AFATFS_MAX_OPEN_FILES];
 
@@ -617,6 +628,7 @@ static void afatfs_cacheSectorInit(afatfsCacheBlockDescriptor_t *descriptor, uin
     descriptor->locked = locked;
     descriptor->retainCount = 0;
     descriptor->discardable = 0;
+    descriptor->readAhead = 0;
 }
 
 /**
@@ -638,6 +650,7 @@ static void afatfs_sdcardReadComplete(sdcardBlockOperation_e operation, uint32_t
                 afatfs_assert(afatfs_cacheSectorGetMemory(i) == buffer && afatfs.cacheDescriptor[i].state == AFATFS_CACHE_STATE_READING);
 
                 afatfs.cacheDescriptor[i].state = AFATFS_CACHE_STATE_IN_SYNC;
+                afatfs.stats.sectorsRead++;
             }
 
             break;
@@ -670,6 +683,7 @@ static void afatfs_sdcardWriteComplete(sdcardBlockOperation_e operation, uint32_
                 afatfs_assert(afatfs_cacheSectorGetMemory(i) == buffer);
 
                 afatfs.cacheDescriptor[i].state = AFATFS_CACHE_STATE_IN_SYNC;
+                afatfs.stats.sectorsWritten++;
             }
             break;
         }
@@ -682,6 +696,7 @@ static void afatfs_sdcardWriteComplete(sdcardBlockOperation_e operation, uint32_
 static void afatfs_cacheFlushSector(int cacheIndex)
 {
     afatfsCacheBlockDescriptor_t *cacheDescriptor = &afatfs.cacheDescriptor[cacheIndex];
+    const bool continuesWrite = afatfs.stats.writeRuns > 0 && cacheDescriptor->sectorIndex == afatfs.lastFlushedSector + 1;
 
 #ifdef AFATFS_MIN_MULTIPLE_BLOCK_WRITE_COUNT
     if (cacheDescriptor->consecutiveEraseBlockCount) {
@@ -701,13 +716,19 @@ static void afatfs_cacheFlushSector(int cacheIndex)
             // Buffer is already transmitted
             afatfs.cacheDirtyEntries--;
             cacheDescriptor->state = AFATFS_CACHE_STATE_IN_SYNC;
+            afatfs.stats.sectorsWritten++;
             break;
 
         case SDCARD_OPERATION_BUSY:
         case SDCARD_OPERATION_FAILURE:
         default:
-            ;
+            return;
     }
+
+    if (!continuesWrite) {
+        afatfs.stats.writeRuns++;
+    }
+    afatfs.lastFlushedSector = cacheDescriptor->sectorIndex;
 }
 
 /**
@@ -813,16 +834,24 @@ static int afatfs_allocateCacheSector(uint32_t sectorIndex)
 bool afatfs_flush(void)
 {
     if (afatfs.cacheDirtyEntries > 0) {
-        // Flush the oldest flushable sector
+        /*
+         * Flush the oldest flushable sector, unless one directly follows the sector we flushed last. The card keeps a
+         * multi-block write open for as long as we write consecutive sectors, so writing that one first turns a
+         * stream of log data into long CMD25 transfers instead of breaking it up for every FAT or directory update.
+         */
         uint32_t earliestSectorTime = 0xFFFFFFFF;
         int earliestSectorIndex = -1;
 
         for (int i = 0; i < AFATFS_NUM_CACHE_SECTORS; i++) {
-            if (afatfs.cacheDescriptor[i].state == AFATFS_CACHE_STATE_DIRTY && !afatfs.cacheDescriptor[i].locked
-                && (earliestSectorIndex == -1 || afatfs.cacheDescriptor[i].writeTimestamp < earliestSectorTime)
-            ) {
-                earliestSectorIndex = i;
-                earliestSectorTime = afatfs.cacheDescriptor[i].writeTimestamp;
+            if (afatfs.cacheDescriptor[i].state == AFATFS_CACHE_STATE_DIRTY && !afatfs.cacheDescriptor[i].locked) {
+                if (afatfs.cacheDescriptor[i].sectorIndex == afatfs.lastFlushedSector + 1) {
+                    earliestSectorIndex = i;
+                    break;
+                }
+                if (earliestSectorIndex == -1 || afatfs.cacheDescriptor[i].writeTimestamp < earliestSectorTime) {
+                    earliestSectorIndex = i;
+                    earliestSectorTime = afatfs.cacheDescriptor[i].writeTimestamp;
+                }
             }
         }
 
@@ -908,6 +937,7 @@ static afatfsOperationStatus_e afatfs_cacheSector(uint32_t physicalSectorIndex,
 
     if (cacheSectorIndex == -1) {
         // We don't have enough free cache to service this request right now, try again later
+        afatfs.stats.cacheFullStalls++;
         return AFATFS_OPERATION_IN_PROGRESS;
     }
 
@@ -1828,11 +1858,60 @@ static uint8_t* afatfs_fileRetainCursorSectorForRead(afatfsFilePtr_t file)
         }
 
         file->readRetainCacheIndex = afatfs_getCacheDescriptorIndexForBuffer(result);
+
+        afatfsCacheBlockDescriptor_t *descriptor = &afatfs.cacheDescriptor[file->readRetainCacheIndex];
+        if (descriptor->readAhead) {
+            descriptor->readAhead = 0;
+            afatfs.stats.readAheadHits++;
+        }
     }
 
     return result;
 }
 
+/**
+ * Start reading the sector a sequential reader will want next into the cache: the cursor's sector if the reader has
+ * just moved into it, otherwise the one after it. Only done within the cursor's cluster, since finding the next
+ * cluster needs a FAT lookup. Does nothing if the card is busy or the cache is full.
+ */
+static void afatfs_fileReadAhead(afatfsFilePtr_t file)
+{
+    if (afatfs_fileIsBusy(file) || file->type == AFATFS_FILE_TYPE_FAT16_ROOT_DIRECTORY || file->cursorCluster == 0) {
+        return;
+    }
+
+    uint32_t offset = file->cursorOffset;
+    uint32_t physicalSector = afatfs_fileGetCursorPhysicalSector(file);
+
+    if (offset % AFATFS_SECTOR_SIZE != 0) {
+        offset = (offset & ~((uint32_t) AFATFS_SECTOR_SIZE - 1)) + AFATFS_SECTOR_SIZE;
+        physicalSector++;
+
+        if (afatfs_byteIndexInCluster(offset) == 0) {
+            return;
+        }
+    }
+
+    if (offset >= file->logicalSize) {
+        return;
+    }
+
+    const afatfsCacheBlockDescriptor_t *cached = afatfs_findCacheSector(physicalSector);
+
+    if (cached && cached->state != AFATFS_CACHE_STATE_EMPTY) {
+        return;
+    }
+
+    uint8_t *buffer;
+    afatfs_cacheSector(physicalSector, &buffer, AFATFS_CACHE_READ, 0);
+
+    afatfsCacheBlockDescriptor_t *descriptor = afatfs_findCacheSector(physicalSector);
+    if (descriptor && descriptor->state == AFATFS_CACHE_STATE_READING) {
+        descriptor->readAhead = 1;
+        afatfs.stats.readAheadIssued++;
+    }
+}
+
 /**
  * Lock the sector at the file's cursor position for write, and return a reference to the memory for that sector.
  *
@@ -3068,7 +3147,7 @@ uint32_t afatfs_fileSize(afatfsFilePtr_t file)
  * Write a single character to the file at the current cursor position. If the cache is too busy to accept the write,
  * it is silently dropped.
  */
-void afatfs_fputc(afatfsFilePtr_t file, uint8_t c)
+bool afatfs_fputc(afatfsFilePtr_t file, uint8_t c)
 {
     uint32_t cursorOffsetInSector = file->cursorOffset % AFATFS_SECTOR_SIZE;
 
@@ -3080,9 +3159,10 @@ void afatfs_fputc(afatfsFilePtr_t file, uint8_t c)
     if (cacheIndex != -1 && cursorOffsetInSector != AFATFS_SECTOR_SIZE - 1) {
         afatfs_cacheSectorGetMemory(cacheIndex)[cursorOffsetInSector] = c;
         file->cursorOffset++;
+        return true;
     } else {
         // Slow path
-        afatfs_fwrite(file, &c, sizeof(c));
+        return afatfs_fwrite(file, &c, sizeof(c)) == sizeof(c);
     }
 }
 
@@ -3252,6 +3332,8 @@ uint32_t afatfs_fread(afatfsFilePtr_t file, uint8_t *buffer, uint32_t len)
         cursorOffsetInSector = 0;
     }
 
+    afatfs_fileReadAhead(file);
+
     return readBytes;
 }
 
@@ -3622,6 +3704,11 @@ afatfsError_e afatfs_getLastError(void)
     return afatfs.lastError;
 }
 
+const afatfsStats_t *afatfs_getStats(void)
+{
+    return &afatfs.stats;
+}
+
 void afatfs_init(void)
 {
 #ifdef STM32H7
@@ -3629,6 +3716,7 @@ void afatfs_init(void)
 #endif
     afatfs.filesystemState = AFATFS_FILESYSTEM_STATE_INITIALIZATION;
     afatfs.initPhase = AFATFS_INITIALIZATION_READ_MBR;
+    afatfs.stats.cacheSectors = AFATFS_NUM_CACHE_SECTORS;
     afatfs.lastClusterAllocated = FAT_SMALLEST_LEGAL_CLUSTER_NUMBER;
 }
 
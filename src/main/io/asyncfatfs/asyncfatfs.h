@@ -57,6 +57,16 @@ typedef enum {
     AFATFS_SEEK_END,
 } afatfsSeek_e;
 
+typedef struct afatfsStats_s {
+    uint32_t sectorsWritten;
+    uint32_t sectorsRead;
+    uint32_t writeRuns;         // Runs of consecutive sector writes, sectorsWritten / writeRuns is the average length
+    uint32_t cacheFullStalls;   // Requests put off because every cache sector was in use
+    uint32_t readAheadIssued;
+    uint32_t readAheadHits;     // Read-ahead sectors a reader went on to use
+    uint16_t cacheSectors;
+} afatfsStats_t;
+
 typedef void (*afatfsFileCallback_t)(afatfsFilePtr_t file);
 typedef void (*afatfsCallback_t)(void);
 
@@ -67,7 +77,7 @@ void afatfs_fcloseSync(afatfsFilePtr_t file);
 bool afatfs_funlink(afatfsFilePtr_t file, afatfsCallback_t callback);
 
 bool afatfs_feof(afatfsFilePtr_t file);
-void afatfs_fputc(afatfsFilePtr_t file, uint8_t c);
+bool afatfs_fputc(afatfsFilePtr_t file, uint8_t c);
 uint32_t afatfs_fwrite(afatfsFilePtr_t file, const uint8_t *buffer, uint32_t len);
 uint32_t afatfs_fwriteSync(afatfsFilePtr_t file, uint8_t *data, uint32_t length);
 uint32_t afatfs_fread(afatfsFilePtr_t file, uint8_t *buffer, uint32_t len);
@@ -95,3 +105,4 @@ bool afatfs_isFull(void);
 
 afatfsFilesystemState_e afatfs_getFilesystemState(void);
 afatfsError_e afatfs_getLastError(void);
+const afatfsStats_t *afatfs_getStats(void);
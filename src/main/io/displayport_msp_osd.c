@@ -30,6 +30,8 @@
 
 #if defined(USE_OSD) && defined(USE_MSP_OSD)
 
+#include "build/debug.h"
+
 #include "common/utils.h"
 #include "common/printf.h"
 #include "common/time.h"
@@ -65,6 +67,8 @@ typedef enum {          // defines are from hdzero code
 #define DRAW_FREQ_DENOM 4 // 60Hz
 #define TX_BUFFER_SIZE 1024
 #define VTX_TIMEOUT 1000 // 1 second timer
+#define MSP_DP_FRAME_OVERHEAD 6     // MSPv1 '$M>', size, cmd and checksum
+#define MSP_DP_MAX_COALESCE_GAP 9   // Clean characters cheaper to re-send than a new frame (header + 4 bytes of subcmd)
 
 static mspProcessCommandFnPtr mspProcessCommand;
 static mspPort_t mspPort;
@@ -272,8 +276,14 @@ static int drawScreen(displayPort_t *displayPort) // 250Hz
 
     uint8_t subcmd[COLS + 4];
     uint8_t updateCount = 0;
+    uint16_t bytesSent = 0;
+    uint16_t charsDeferred = 0;
     subcmd[0] = MSP_DP_WRITE_STRING;
 
+    // TX space available for MSP_DP_WRITE_STRING frames, keeping room for the final MSP_DP_DRAW_SCREEN
+    uint32_t txBudget = mspPort.port ? mspSerialTxBytesFree(mspPort.port) : 0;
+    txBudget = (txBudget > MSP_DP_FRAME_OVERHEAD + 1) ? txBudget - (MSP_DP_FRAME_OVERHEAD + 1) : 0;
+
     int next = BITARRAY_FIND_FIRST_SET(dirty, 0);
     while (next >= 0) {
         // Look for sequential dirty characters on the same line for the same font page
@@ -285,15 +295,40 @@ static int drawScreen(displayPort_t *displayPort) // 250Hz
         bool page = bitArrayGet(fontPage, pos);
         bool blink = bitArrayGet(blinkChar, pos);
 
-        uint8_t len = 4;
-        do {
-            bitArrayClr(dirty, pos);
-            subcmd[len++] = isBfCompatibleVideoSystem(osdConfig()) ? getBfCharacter(screen[pos++], page): screen[pos++];
+        // Extend the run over short gaps of clean characters as well. Re-sending a few
+        // unchanged characters is cheaper than the header and checksum of another frame.
+        int end = pos + 1;
+        int gap = 0;
+        for (int i = end; i < endOfLine && gap <= MSP_DP_MAX_COALESCE_GAP; i++) {
+            if (bitArrayGet(fontPage, i) != page || bitArrayGet(blinkChar, i) != blink) {
+                break;
+            }
+
+            if (bitArrayGet(dirty, i)) {
+                end = i + 1;
+                gap = 0;
+            } else {
+                gap++;
+            }
+        }
 
-            if (bitArrayGet(dirty, pos)) {
-                next = pos;
+        uint8_t len = 4 + (end - pos);
+
+        // Stop once the port's TX buffer can't take the frame, leaving the rest of the
+        // screen dirty for the next draw
+        if (txBudget < (uint32_t)(len + MSP_DP_FRAME_OVERHEAD)) {
+            while (next >= 0) {
+                charsDeferred++;
+                next = BITARRAY_FIND_FIRST_SET(dirty, next + 1);
             }
-        } while (next == pos && next < endOfLine && bitArrayGet(fontPage, next) == page && bitArrayGet(blinkChar, next) == blink);
+            break;
+        }
+        txBudget -= len + MSP_DP_FRAME_OVERHEAD;
+
+        for (int i = 4; pos < end; i++, pos++) {
+            bitArrayClr(dirty, pos);
+            subcmd[i] = isBfCompatibleVideoSystem(osdConfig()) ? getBfCharacter(screen[pos], page): screen[pos];
+        }
 
         if (!isBfCompatibleVideoSystem(osdConfig())) {
             attributes |= (page << DISPLAYPORT_MSP_ATTR_FONTPAGE);
@@ -306,11 +341,16 @@ static int drawScreen(displayPort_t *displayPort) // 250Hz
         subcmd[1] = row;
         subcmd[2] = col;
         subcmd[3] = attributes;
-        output(displayPort, MSP_DISPLAYPORT, subcmd, len);
+        bytesSent += output(displayPort, MSP_DISPLAYPORT, subcmd, len);
         updateCount++;
         next = BITARRAY_FIND_FIRST_SET(dirty, pos);
     }
 
+    DEBUG_SET(DEBUG_MSP_DISPLAYPORT, 0, updateCount);
+    DEBUG_SET(DEBUG_MSP_DISPLAYPORT, 1, bytesSent);
+    DEBUG_SET(DEBUG_MSP_DISPLAYPORT, 2, updateCount ? bytesSent / updateCount : 0);
+    DEBUG_SET(DEBUG_MSP_DISPLAYPORT, 3, charsDeferred);
+
     if (updateCount > 0 || screenCleared) {
         if (screenCleared) {
             screenCleared = false;
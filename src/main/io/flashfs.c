@@ -26,6 +26,7 @@
  * to bring bits back to 1 again.
  */
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
@@ -34,11 +35,87 @@
 
 #if defined(USE_FLASHFS)
 
+#include "common/crc.h"
+#include "common/maths.h"
+#include "common/utils.h"
+
 #include "drivers/flash.h"
 
 #include "io/flashfs.h"
 
+/*
+ * The log index lives in its own partition right after the flashfs one. It's an append-only list of fixed size
+ * records: a header written when the flashfs is erased, then a start and an end record for each log. USB mass
+ * storage lists the logs from it instead of scanning the whole chip for log headers. The index is only trusted
+ * when its header is present and matches the flashfs partition, so a chip written by an older firmware (or one
+ * whose index ran out of room) falls back to the scan.
+ *
+ * On NOR flash records are packed back to back. NAND pages can't be programmed piecewise once ECC is computed,
+ * so there each record takes a whole page.
+ *
+ * A background erase also records its progress here, see flashfsEraseAsync().
+ */
+#define FLASHFS_LOG_INDEX_MAGIC 0xB10C
+
+// Slots kept for erase progress records, the last one marks the end of the erase
+#define FLASHFS_LOG_INDEX_ERASE_RECORDS 32
+
+// Header flags
+#define FLASHFS_LOG_INDEX_HEADER_ERASING    (1 << 0)    // The flashfs erase is not done until an erased record covers it all
+#define FLASHFS_LOG_INDEX_HEADER_INCOMPLETE (1 << 1)    // A log was started before the header went in, it's not indexed
+
+typedef enum {
+    FLASHFS_LOG_INDEX_RECORD_HEADER = 1,
+    FLASHFS_LOG_INDEX_RECORD_LOG_START,
+    FLASHFS_LOG_INDEX_RECORD_LOG_END,
+    FLASHFS_LOG_INDEX_RECORD_ERASED,
+} flashfsLogIndexRecordType_e;
+
+typedef struct flashfsLogIndexRecord_s {
+    uint16_t magic;
+    uint8_t type;
+    uint8_t checksum;   // crc8_dvb_s2 of the fields below
+    uint32_t offset;    // Header: size of the flashfs partition, log records: start of the log, erased: end of the erased area
+    uint32_t value;     // Header: flags, log start: start time, log end: end of the log
+    uint32_t reserved;  // Keeps records from straddling a NOR page
+} flashfsLogIndexRecord_t;
+
+STATIC_ASSERT(sizeof(flashfsLogIndexRecord_t) == 16, flashfs_log_index_record_size);
+
 static flashPartition_t *flashPartition;
+static flashPartition_t *logIndexPartition;
+
+static uint16_t logIndexSlotCount;
+static uint16_t logIndexNextSlot;   // First erased slot
+static bool logIndexValid;          // The header is in place and records can be appended
+static bool logIndexComplete;       // Every log on the flash is in the index
+static bool logIndexHeaderPending;  // Erased, the header goes in once the flash is ready
+static uint32_t logIndexHeaderFlags;
+
+/*
+ * Background erase. The index partition goes first so the index can be used as soon as possible, then the flashfs
+ * sectors from the start of the partition up, one sector per flashfsEraseUpdate() call without waiting for it to
+ * complete. Writes are held back until the sectors they go to are erased, so logging can start right away and
+ * trails the erase.
+ *
+ * With a log index the progress is saved as erased records, and writes only go below the last saved position. If
+ * power is lost during the erase, flashfsInit() picks the erase up from there. Without that the chip would be left
+ * as [new log][erased][old data], which the free space search can't make sense of.
+ */
+typedef struct flashfsEraseState_s {
+    bool active;
+    bool tracked;                   // Progress is saved in the log index
+    bool writerWaiting;             // A write is held back by the saved position
+    uint8_t recordsLeft;
+    flashSector_t nextIndexSector;
+    flashSector_t nextSector;
+    flashSector_t savedSector;      // Sectors below this are erased and recorded in the index
+    uint32_t sectorsPerRecord;
+    uint32_t sectorsDone;
+    uint32_t sectorsTotal;
+} flashfsEraseState_t;
+
+static flashfsEraseState_t eraseState;
 
 static uint8_t flashWriteBuffer[FLASHFS_WRITE_BUFFER_SIZE];
 
@@ -69,11 +146,196 @@ static void flashfsSetTailAddress(uint32_t address)
     tailAddress = address;
 }
 
+static uint32_t flashfsLogIndexSlotSize(const flashGeometry_t *geometry)
+{
+    return geometry->flashType == FLASH_TYPE_NAND ? geometry->pageSize : sizeof(flashfsLogIndexRecord_t);
+}
+
+static uint32_t flashfsLogIndexSlotAddress(uint16_t slot)
+{
+    const flashGeometry_t *geometry = flashGetGeometry();
+
+    return logIndexPartition->startSector * geometry->sectorSize + slot * flashfsLogIndexSlotSize(geometry);
+}
+
+static uint8_t flashfsLogIndexChecksum(const flashfsLogIndexRecord_t *record)
+{
+    return crc8_dvb_s2_update(0, &record->offset, sizeof(*record) - offsetof(flashfsLogIndexRecord_t, offset));
+}
+
+static bool flashfsLogIndexReadSlot(uint16_t slot, flashfsLogIndexRecord_t *record)
+{
+    return flashReadBytes(flashfsLogIndexSlotAddress(slot), (uint8_t *)record, sizeof(*record)) == sizeof(*record);
+}
+
+static bool flashfsLogIndexRecordIsErased(const flashfsLogIndexRecord_t *record)
+{
+    const uint8_t *bytes = (const uint8_t *)record;
+
+    for (unsigned i = 0; i < sizeof(*record); i++) {
+        if (bytes[i] != 0xFF) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool flashfsLogIndexRecordIsValid(const flashfsLogIndexRecord_t *record)
+{
+    return record->magic == FLASHFS_LOG_INDEX_MAGIC && record->checksum == flashfsLogIndexChecksum(record);
+}
+
+static bool flashfsLogIndexAppend(flashfsLogIndexRecordType_e type, uint32_t offset, uint32_t value)
+{
+    const uint32_t address = flashfsLogIndexSlotAddress(logIndexNextSlot);
+
+    if (!logIndexValid) {
+        return false;
+    }
+
+    // Log records leave room for the progress records of a running erase
+    const uint16_t reservedSlots = (type == FLASHFS_LOG_INDEX_RECORD_LOG_START || type == FLASHFS_LOG_INDEX_RECORD_LOG_END) ? eraseState.recordsLeft : 0;
+    if (logIndexNextSlot + reservedSlots >= logIndexSlotCount) {
+        // Out of room, the logs from here on are only found by scanning
+        logIndexComplete = false;
+        return false;
+    }
+
+    flashfsLogIndexRecord_t record = {
+        .magic = FLASHFS_LOG_INDEX_MAGIC,
+        .type = type,
+        .offset = offset,
+        .value = value,
+        .reserved = 0xFFFFFFFF,
+    };
+    record.checksum = flashfsLogIndexChecksum(&record);
+
+    if (flashPageProgram(address, (const uint8_t *)&record, sizeof(record)) == address) {
+        // The flash never got ready, the slot stays erased and the index is incomplete from here on
+        logIndexValid = false;
+        return false;
+    }
+    flashFlush();
+    logIndexNextSlot++;
+    return true;
+}
+
+static void flashfsLogIndexWriteHeader(void)
+{
+    logIndexHeaderPending = false;
+    logIndexNextSlot = 0;
+    logIndexValid = true;
+    logIndexComplete = !(logIndexHeaderFlags & FLASHFS_LOG_INDEX_HEADER_INCOMPLETE);
+    flashfsLogIndexAppend(FLASHFS_LOG_INDEX_RECORD_HEADER, flashfsGetSize(), logIndexHeaderFlags);
+}
+
+static uint32_t flashfsEraseSectorsPerRecord(void)
+{
+    return MAX(FLASH_PARTITION_SECTOR_COUNT(flashPartition) / (FLASHFS_LOG_INDEX_ERASE_RECORDS - 1), 1U);
+}
+
+// Continue an erase that was cut short, everything below erasedEnd is known to be erased
+static void flashfsEraseResume(uint32_t erasedEnd, unsigned recordsUsed)
+{
+    const flashGeometry_t *geometry = flashGetGeometry();
+
+    eraseState.active = true;
+    eraseState.tracked = true;
+    eraseState.writerWaiting = false;
+    eraseState.recordsLeft = recordsUsed < FLASHFS_LOG_INDEX_ERASE_RECORDS ? FLASHFS_LOG_INDEX_ERASE_RECORDS - recordsUsed : 1;
+    eraseState.nextIndexSector = logIndexPartition->endSector + 1;
+    eraseState.nextSector = MAX(erasedEnd / geometry->sectorSize, flashPartition->startSector);
+    eraseState.savedSector = eraseState.nextSector;
+    eraseState.sectorsPerRecord = flashfsEraseSectorsPerRecord();
+    eraseState.sectorsDone = eraseState.nextSector - flashPartition->startSector;
+    eraseState.sectorsTotal = FLASH_PARTITION_SECTOR_COUNT(flashPartition);
+}
+
+// True when the index sectors of the last erase have been issued, a page program then waits for them to finish
+static bool flashfsLogIndexIsErased(void)
+{
+    return !eraseState.active || !logIndexPartition || eraseState.nextIndexSector > logIndexPartition->endSector;
+}
+
+static void flashfsLogIndexLoad(void)
+{
+    logIndexPartition = flashPartition ? flashPartitionFindByType(FLASH_PARTITION_TYPE_FLASHFS_INDEX) : NULL;
+    logIndexSlotCount = 0;
+    logIndexNextSlot = 0;
+    logIndexValid = false;
+    logIndexComplete = false;
+    logIndexHeaderPending = false;
+
+    if (!logIndexPartition) {
+        return;
+    }
+
+    logIndexSlotCount = MIN(flashPartitionSize(logIndexPartition) / flashfsLogIndexSlotSize(flashGetGeometry()), (uint32_t)UINT16_MAX);
+
+    flashfsLogIndexRecord_t record;
+    if (!flashfsLogIndexReadSlot(0, &record) || !flashfsLogIndexRecordIsValid(&record)
+            || record.type != FLASHFS_LOG_INDEX_RECORD_HEADER || record.offset != flashfsGetSize()) {
+        return;
+    }
+
+    const uint32_t headerFlags = record.value;
+    uint32_t erasedEnd = 0;
+    unsigned erasedRecords = 0;
+
+    for (logIndexNextSlot = 1; logIndexNextSlot < logIndexSlotCount; logIndexNextSlot++) {
+        if (!flashfsLogIndexReadSlot(logIndexNextSlot, &record)) {
+            return;
+        }
+        if (flashfsLogIndexRecordIsErased(&record)) {
+            break;
+        }
+        if (!flashfsLogIndexRecordIsValid(&record)) {
+            return;
+        }
+        if (record.type == FLASHFS_LOG_INDEX_RECORD_ERASED) {
+            erasedEnd = record.offset;
+            erasedRecords++;
+        }
+    }
+
+    // A full index may have missed logs written after it ran out of room
+    logIndexValid = logIndexNextSlot < logIndexSlotCount;
+    logIndexComplete = logIndexValid && !(headerFlags & FLASHFS_LOG_INDEX_HEADER_INCOMPLETE);
+
+    if ((headerFlags & FLASHFS_LOG_INDEX_HEADER_ERASING) && erasedEnd < flashfsGetSize()) {
+        // Power was lost during a background erase, the sectors from erasedEnd up may still hold old data
+        flashfsEraseResume(erasedEnd, erasedRecords);
+    }
+}
+
 void flashfsEraseCompletely(void)
 {
-    flashPartitionErase(flashPartition);
+    const flashGeometry_t *geometry = flashGetGeometry();
+
+    eraseState.active = false;
+    eraseState.recordsLeft = 0;
+
+    if (logIndexPartition && flashPartitionCount() == 2
+            && FLASH_PARTITION_SECTOR_COUNT(flashPartition) + FLASH_PARTITION_SECTOR_COUNT(logIndexPartition) == geometry->sectors) {
+        // Nothing else on the chip, so a chip erase is still the fastest way to clear both
+        flashEraseCompletely();
+    } else {
+        flashPartitionErase(flashPartition);
+        if (logIndexPartition) {
+            flashPartitionErase(logIndexPartition);
+        }
+    }
+
     flashfsClearBuffer();
     flashfsSetTailAddress(0);
+
+    // A chip erase may still be running, flashfsEraseUpdate() writes the header once it's done
+    logIndexValid = false;
+    logIndexComplete = false;
+    logIndexNextSlot = 0;
+    logIndexHeaderPending = logIndexPartition != NULL;
+    logIndexHeaderFlags = 0;
 }
 
 void flashfsClose(void)
@@ -93,6 +355,142 @@ void flashfsClose(void)
     }
 }
 
+/**
+ * Start erasing the flashfs in the background, flashfsEraseUpdate() does the work. The volume is empty and
+ * writable straight away.
+ */
+void flashfsEraseAsync(void)
+{
+    if (!flashPartition) {
+        return;
+    }
+
+    flashfsClearBuffer();
+    flashfsSetTailAddress(0);
+
+    eraseState.active = true;
+    eraseState.tracked = logIndexPartition != NULL;
+    eraseState.writerWaiting = false;
+    eraseState.recordsLeft = eraseState.tracked ? FLASHFS_LOG_INDEX_ERASE_RECORDS : 0;
+    eraseState.nextSector = flashPartition->startSector;
+    eraseState.savedSector = flashPartition->startSector;
+    eraseState.sectorsPerRecord = flashfsEraseSectorsPerRecord();
+    eraseState.sectorsDone = 0;
+    eraseState.sectorsTotal = FLASH_PARTITION_SECTOR_COUNT(flashPartition);
+
+    logIndexValid = false;
+    logIndexComplete = false;
+    logIndexNextSlot = 0;
+    logIndexHeaderPending = logIndexPartition != NULL;
+    logIndexHeaderFlags = FLASHFS_LOG_INDEX_HEADER_ERASING;
+    if (logIndexPartition) {
+        eraseState.nextIndexSector = logIndexPartition->startSector;
+        eraseState.sectorsTotal += FLASH_PARTITION_SECTOR_COUNT(logIndexPartition);
+    }
+}
+
+// Save that everything below sector is erased. Until the last record the writer may go up to there.
+static void flashfsEraseSaveProgress(flashSector_t sector)
+{
+    if (flashfsLogIndexAppend(FLASHFS_LOG_INDEX_RECORD_ERASED, sector * flashGetGeometry()->sectorSize, 0)) {
+        eraseState.savedSector = sector;
+    }
+
+    eraseState.recordsLeft--;
+    eraseState.writerWaiting = false;
+}
+
+static bool flashfsEraseProgressDue(void)
+{
+    // The last record is kept for the end of the erase, writes then wait for the erase to finish
+    if (!eraseState.tracked || eraseState.recordsLeft <= 1 || eraseState.nextSector <= eraseState.savedSector) {
+        return false;
+    }
+
+    return eraseState.writerWaiting || (uint32_t)(eraseState.nextSector - eraseState.savedSector) >= eraseState.sectorsPerRecord;
+}
+
+/**
+ * Issue the next sector erase of a background erase, or write the index header or the erase progress, if the
+ * flash is idle. Never waits for the flash.
+ */
+void flashfsEraseUpdate(void)
+{
+    if (!flashIsReady()) {
+        return;
+    }
+
+    if (!eraseState.active) {
+        if (logIndexHeaderPending) {
+            flashfsLogIndexWriteHeader();
+        }
+        return;
+    }
+
+    const flashGeometry_t *geometry = flashGetGeometry();
+
+    if (logIndexPartition && eraseState.nextIndexSector <= logIndexPartition->endSector) {
+        flashEraseSector(eraseState.nextIndexSector++ * geometry->sectorSize);
+    } else if (logIndexHeaderPending) {
+        flashfsLogIndexWriteHeader();
+        return;
+    } else if (flashfsEraseProgressDue()) {
+        // The flash is idle, so the sectors issued so far are erased
+        flashfsEraseSaveProgress(eraseState.nextSector);
+        return;
+    } else if (eraseState.nextSector <= flashPartition->endSector) {
+        flashEraseSector(eraseState.nextSector++ * geometry->sectorSize);
+    } else {
+        if (eraseState.tracked) {
+            flashfsEraseSaveProgress(eraseState.nextSector);
+        }
+        eraseState.active = false;
+        eraseState.recordsLeft = 0;
+        return;
+    }
+
+    eraseState.sectorsDone++;
+}
+
+bool flashfsIsErasing(void)
+{
+    return eraseState.active;
+}
+
+/**
+ * Progress of the background erase in percent, 100 when no erase is running.
+ */
+uint8_t flashfsGetEraseProgress(void)
+{
+    if (!eraseState.active || eraseState.sectorsTotal == 0) {
+        return 100;
+    }
+
+    return eraseState.sectorsDone * 100 / eraseState.sectorsTotal;
+}
+
+// Flash addresses below this can be written: erased, or being erased if the flash is busy and the erase isn't tracked
+static uint32_t flashfsErasedEnd(void)
+{
+    if (!eraseState.active) {
+        return UINT32_MAX;
+    }
+
+    return (eraseState.tracked ? eraseState.savedSector : eraseState.nextSector) * flashGetGeometry()->sectorSize;
+}
+
+// Run the background erase in the foreground until everything below address is erased
+static void flashfsEraseUntil(uint32_t address)
+{
+    while (eraseState.active && flashfsErasedEnd() < address) {
+        if (!flashWaitForReady(0)) {
+            break;
+        }
+        eraseState.writerWaiting = true;
+        flashfsEraseUpdate();
+    }
+}
+
 /**
  * Start and end must lie on sector boundaries, or they will be rounded out to sector boundaries such that
  * all the bytes in the range [start...end) are erased.
@@ -192,6 +590,15 @@ static uint32_t flashfsWriteBuffers(uint8_t const **buffers, uint32_t *bufferSiz
         return 0;
     }
 
+    // Don't overtake a background erase
+    if (tailAddress + bytesTotal > flashfsErasedEnd()) {
+        if (!sync) {
+            eraseState.writerWaiting = true;
+            return 0;
+        }
+        flashfsEraseUntil(tailAddress + bytesTotal);
+    }
+
     uint32_t bytesTotalRemaining = bytesTotal;
 
     while (bytesTotalRemaining > 0) {
@@ -506,6 +913,8 @@ int flashfsIdentifyStartOfFreeSpace(void)
      * To do better we might write a volume header instead, which would mark how much free space remains. But keeping
      * a header up to date while logging would incur more writes to the flash, which would consume precious write
      * bandwidth and block more often.
+     *
+     * While an interrupted erase is resumed only the part below its saved position is in order, old data follows.
      */
 
     enum {
@@ -525,7 +934,7 @@ int flashfsIdentifyStartOfFreeSpace(void)
     } testBuffer;
 
     int left = 0; // Smallest block index in the search region
-    int right = flashfsGetSize() / FREE_BLOCK_SIZE; // One past the largest block index in the search region
+    int right = MIN(flashfsGetSize(), flashfsErasedEnd()) / FREE_BLOCK_SIZE; // One past the largest block index in the search region
     int mid;
     int result = right;
     int i;
@@ -571,6 +980,122 @@ bool flashfsIsEOF(void)
     return tailAddress >= flashfsGetSize();
 }
 
+/**
+ * Size of the partition reserved for the log index, in bytes.
+ */
+uint32_t flashfsLogIndexPartitionSize(const flashGeometry_t *geometry)
+{
+    return (1 + 2 * FLASHFS_LOG_INDEX_MAX_LOGS + FLASHFS_LOG_INDEX_ERASE_RECORDS) * flashfsLogIndexSlotSize(geometry);
+}
+
+/**
+ * Record that a log starts at the current write position. Call before writing the first byte of the log, with the
+ * write buffer flushed.
+ */
+void flashfsLogIndexBegin(const dateTime_t *startTime)
+{
+    uint32_t fatTime = 0;
+
+    // The header goes in first if the erase task didn't get to it yet. A log started while the index
+    // sectors are still being erased is not in the index, the header then marks the index incomplete.
+    if (logIndexHeaderPending) {
+        if (flashfsLogIndexIsErased()) {
+            flashfsLogIndexWriteHeader();
+        } else {
+            logIndexHeaderFlags |= FLASHFS_LOG_INDEX_HEADER_INCOMPLETE;
+        }
+    }
+
+    if (startTime) {
+        fatTime = ((uint32_t)(startTime->year - 1980) << 25) | ((uint32_t)startTime->month << 21) | ((uint32_t)startTime->day << 16)
+            | (startTime->hours << 11) | (startTime->minutes << 5) | (startTime->seconds >> 1);
+    }
+
+    flashfsLogIndexAppend(FLASHFS_LOG_INDEX_RECORD_LOG_START, flashfsGetOffset(), fatTime);
+}
+
+// The last log record, skipping erase progress, if it starts a log that has no end yet
+static bool flashfsLogIndexFindLogStart(flashfsLogIndexRecord_t *record)
+{
+    for (uint16_t slot = logIndexNextSlot - 1; slot > 0; slot--) {
+        if (!flashfsLogIndexReadSlot(slot, record)) {
+            return false;
+        }
+        if (record->type != FLASHFS_LOG_INDEX_RECORD_ERASED) {
+            return record->type == FLASHFS_LOG_INDEX_RECORD_LOG_START;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Record that the log started by the last flashfsLogIndexBegin() ends at the current write position. Call after
+ * flashfsClose().
+ */
+void flashfsLogIndexEnd(void)
+{
+    flashfsLogIndexRecord_t record;
+
+    if (!flashfsLogIndexIsValid() || !flashfsLogIndexFindLogStart(&record)) {
+        return;
+    }
+
+    flashfsLogIndexAppend(FLASHFS_LOG_INDEX_RECORD_LOG_END, record.offset, flashfsGetOffset());
+}
+
+/**
+ * Returns true if the index holds every log on the flash.
+ */
+bool flashfsLogIndexIsValid(void)
+{
+    return logIndexValid && logIndexComplete;
+}
+
+/**
+ * Fetch the log at *cursor and advance it, start with *cursor = 0. Returns false once there are no more logs.
+ */
+bool flashfsLogIndexNext(uint16_t *cursor, flashfsLogIndexEntry_t *entry)
+{
+    flashfsLogIndexRecord_t record;
+
+    if (!flashfsLogIndexIsValid()) {
+        return false;
+    }
+
+    // Slot 0 is the header
+    *cursor = MAX(*cursor, 1);
+
+    while (*cursor < logIndexNextSlot) {
+        if (!flashfsLogIndexReadSlot((*cursor)++, &record)) {
+            return false;
+        }
+        if (record.type != FLASHFS_LOG_INDEX_RECORD_LOG_START) {
+            continue;
+        }
+
+        entry->startOffset = record.offset;
+        entry->endOffset = 0;
+        entry->startTime = record.value;
+
+        // The end record, if any, follows the start record with only erase progress in between
+        for (uint16_t slot = *cursor; slot < logIndexNextSlot && flashfsLogIndexReadSlot(slot, &record); slot++) {
+            if (record.type == FLASHFS_LOG_INDEX_RECORD_ERASED) {
+                continue;
+            }
+            if (record.type == FLASHFS_LOG_INDEX_RECORD_LOG_END && record.offset == entry->startOffset) {
+                entry->endOffset = record.value;
+                *cursor = slot + 1;
+            }
+            break;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
 /**
  * Call after initializing the flash chip in order to set up the filesystem.
  */
@@ -578,6 +1103,9 @@ void flashfsInit(void)
 {
     flashPartition = flashPartitionFindByType(FLASH_PARTITION_TYPE_FLASHFS);
 
+    // Resumes an erase that was cut short, before any write can go to a sector that's still to be erased
+    flashfsLogIndexLoad();
+
     if (flashPartition) {
         // Start the file pointer off at the beginning of free space so caller can start writing immediately
         flashfsSeekAbs(flashfsIdentifyStartOfFreeSpace());
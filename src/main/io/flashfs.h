@@ -19,6 +19,8 @@
 
 #include <stdint.h>
 
+#include "common/time.h"
+
 #include "drivers/flash.h"
 
 #define FLASHFS_WRITE_BUFFER_SIZE 128
@@ -27,8 +29,21 @@
 // Automatically trigger a flush when this much data is in the buffer
 #define FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN 64
 
+// Logs the index has room for between two erases, the index takes a start and an end record per log
+#define FLASHFS_LOG_INDEX_MAX_LOGS 128
+
+typedef struct flashfsLogIndexEntry_s {
+    uint32_t startOffset;
+    uint32_t endOffset;     // 0 when the log was never closed, e.g. power was lost while logging
+    uint32_t startTime;     // Local time in FAT date/time encoding, 0 when the time was not known
+} flashfsLogIndexEntry_t;
+
 void flashfsEraseCompletely(void);
 void flashfsEraseRange(uint32_t start, uint32_t end);
+void flashfsEraseAsync(void);
+void flashfsEraseUpdate(void);
+bool flashfsIsErasing(void);
+uint8_t flashfsGetEraseProgress(void);
 
 void flashfsClose(void);
 
@@ -53,3 +68,9 @@ void flashfsInit(void);
 
 bool flashfsIsReady(void);
 bool flashfsIsEOF(void);
+
+uint32_t flashfsLogIndexPartitionSize(const flashGeometry_t *geometry);
+void flashfsLogIndexBegin(const dateTime_t *startTime);
+void flashfsLogIndexEnd(void);
+bool flashfsLogIndexIsValid(void);
+bool flashfsLogIndexNext(uint16_t *cursor, flashfsLogIndexEntry_t *entry);
@@ -16,6 +16,7 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <ctype.h>
@@ -84,19 +85,11 @@ static const char * baudInitDataNMEA[GPS_BAUDRATE_COUNT] = {
     "$PUBX,41,1,0003,0001,921600,0*15\r\n"      // GPS_BAUDRATE_921600
 };
 
-// Packet checksum accumulators
-static uint8_t _ck_a;
-static uint8_t _ck_b;
-
-// State machine state
-static bool _skip_packet;
-static uint8_t _step;
-static uint8_t _msg_id;
-static uint16_t _payload_length;
-static uint16_t _payload_counter;
+// Receive side frame parser
+static ubxParser_t ubxParser;
+static bool ubxFramePending;
 
 static uint8_t next_fix_type;
-static uint8_t _class;
 static uint8_t _ack_state;
 static uint8_t _ack_waiting_msg;
 
@@ -133,7 +126,7 @@ static union {
     uint8_t bytes[58];
 } send_buffer;
 
-// Receive buffer
+// Aligned copy of the payload, used when a frame isn't 4 byte aligned in the parser buffer
 static union {
     ubx_nav_posllh posllh;
     ubx_nav_status status;
@@ -534,253 +527,248 @@ static uint32_t gpsDecodeHardwareVersion(const char * szBuf, unsigned nBufSize)
     return UBX_HW_VERSION_UNKNOWN;
 }
 
-static bool gpsParseFrameUBLOX(void)
+static void gpsHandleNavPosllhUBLOX(const void *payload, uint16_t length)
 {
-    switch (_msg_id) {
-    case MSG_POSLLH:
-        gpsSol.llh.lon = _buffer.posllh.longitude;
-        gpsSol.llh.lat = _buffer.posllh.latitude;
-        gpsSol.llh.alt = _buffer.posllh.altitude_msl / 10;  //alt in cm
-        gpsSol.eph = gpsConstrainEPE(_buffer.posllh.horizontal_accuracy / 10);
-        gpsSol.epv = gpsConstrainEPE(_buffer.posllh.vertical_accuracy / 10);
-        gpsSol.flags.validEPE = true;
-        if (next_fix_type != GPS_NO_FIX)
-            gpsSol.fixType = next_fix_type;
-        _new_position = true;
-        break;
-    case MSG_STATUS:
-        next_fix_type = gpsMapFixType(_buffer.status.fix_status & NAV_STATUS_FIX_VALID, _buffer.status.fix_type);
-        if (next_fix_type == GPS_NO_FIX)
-            gpsSol.fixType = GPS_NO_FIX;
-        break;
-    case MSG_SOL:
-        next_fix_type = gpsMapFixType(_buffer.solution.fix_status & NAV_STATUS_FIX_VALID, _buffer.solution.fix_type);
-        if (next_fix_type == GPS_NO_FIX)
-            gpsSol.fixType = GPS_NO_FIX;
-        gpsSol.numSat = _buffer.solution.satellites;
-        gpsSol.hdop = gpsConstrainHDOP(_buffer.solution.position_DOP);
-        break;
-    case MSG_VELNED:
-        gpsSol.groundSpeed = _buffer.velned.speed_2d;    // cm/s
-        gpsSol.groundCourse = (uint16_t) (_buffer.velned.heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
-        gpsSol.velNED[X] = _buffer.velned.ned_north;
-        gpsSol.velNED[Y] = _buffer.velned.ned_east;
-        gpsSol.velNED[Z] = _buffer.velned.ned_down;
-        gpsSol.flags.validVelNE = true;
-        gpsSol.flags.validVelD = true;
-        _new_speed = true;
-        break;
-    case MSG_TIMEUTC:
-        if (UBX_VALID_GPS_DATE_TIME(_buffer.timeutc.valid)) {
-            gpsSol.time.year = _buffer.timeutc.year;
-            gpsSol.time.month = _buffer.timeutc.month;
-            gpsSol.time.day = _buffer.timeutc.day;
-            gpsSol.time.hours = _buffer.timeutc.hour;
-            gpsSol.time.minutes = _buffer.timeutc.min;
-            gpsSol.time.seconds = _buffer.timeutc.sec;
-            gpsSol.time.millis = _buffer.timeutc.nano / (1000*1000);
-
-            gpsSol.flags.validTime = true;
-        } else {
-            gpsSol.flags.validTime = false;
-        }
-        break;
-    case MSG_PVT:
-        next_fix_type = gpsMapFixType(_buffer.pvt.fix_status & NAV_STATUS_FIX_VALID, _buffer.pvt.fix_type);
+    const ubx_nav_posllh *posllh = payload;
+    UNUSED(length);
+
+    gpsSol.llh.lon = posllh->longitude;
+    gpsSol.llh.lat = posllh->latitude;
+    gpsSol.llh.alt = posllh->altitude_msl / 10;  //alt in cm
+    gpsSol.eph = gpsConstrainEPE(posllh->horizontal_accuracy / 10);
+    gpsSol.epv = gpsConstrainEPE(posllh->vertical_accuracy / 10);
+    gpsSol.flags.validEPE = true;
+    if (next_fix_type != GPS_NO_FIX)
         gpsSol.fixType = next_fix_type;
-        gpsSol.llh.lon = _buffer.pvt.longitude;
-        gpsSol.llh.lat = _buffer.pvt.latitude;
-        gpsSol.llh.alt = _buffer.pvt.altitude_msl / 10;  //alt in cm
-        gpsSol.velNED[X]=_buffer.pvt.ned_north / 10;  // to cm/s
-        gpsSol.velNED[Y]=_buffer.pvt.ned_east / 10;   // to cm/s
-        gpsSol.velNED[Z]=_buffer.pvt.ned_down / 10;   // to cm/s
-        gpsSol.groundSpeed = _buffer.pvt.speed_2d / 10;    // to cm/s
-        gpsSol.groundCourse = (uint16_t) (_buffer.pvt.heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
-        gpsSol.numSat = _buffer.pvt.satellites;
-        gpsSol.eph = gpsConstrainEPE(_buffer.pvt.horizontal_accuracy / 10);
-        gpsSol.epv = gpsConstrainEPE(_buffer.pvt.vertical_accuracy / 10);
-        gpsSol.hdop = gpsConstrainHDOP(_buffer.pvt.position_DOP);
-        gpsSol.flags.validVelNE = true;
-        gpsSol.flags.validVelD = true;
-        gpsSol.flags.validEPE = true;
-
-        if (UBX_VALID_GPS_DATE_TIME(_buffer.pvt.valid)) {
-            gpsSol.time.year = _buffer.pvt.year;
-            gpsSol.time.month = _buffer.pvt.month;
-            gpsSol.time.day = _buffer.pvt.day;
-            gpsSol.time.hours = _buffer.pvt.hour;
-            gpsSol.time.minutes = _buffer.pvt.min;
-            gpsSol.time.seconds = _buffer.pvt.sec;
-            gpsSol.time.millis = _buffer.pvt.nano / (1000*1000);
-
-            gpsSol.flags.validTime = true;
-        } else {
-            gpsSol.flags.validTime = false;
-        }
+    _new_position = true;
+}
 
-        _new_position = true;
-        _new_speed = true;
-        break;
-    case MSG_VER:
-        if (_class == CLASS_MON) {
-            gpsState.hwVersion = gpsDecodeHardwareVersion(_buffer.ver.hwVersion, sizeof(_buffer.ver.hwVersion));
-            if (gpsState.hwVersion >= UBX_HW_VERSION_UBLOX8) {
-                if (_buffer.ver.swVersion[9] > '2' || true) {
-                    // check extensions;
-                    // after hw + sw vers; each is 30 bytes
-                    bool found = false;
-                    for (int j = 40; j < _payload_length && !found; j += 30)
-                    {
-                        // Example content: GPS;GAL;BDS;GLO
-                        if (strnstr((const char *)(_buffer.bytes + j), "GAL", 30))
-                        {
-                            ubx_capabilities.supported |= UBX_MON_GNSS_GALILEO_MASK;
-                            found = true;
-                        }
-                        if (strnstr((const char *)(_buffer.bytes + j), "BDS", 30))
-                        {
-                            ubx_capabilities.supported |= UBX_MON_GNSS_BEIDOU_MASK;
-                            found = true;
-                        }
-                        if (strnstr((const char *)(_buffer.bytes + j), "GLO", 30))
-                        {
-                            ubx_capabilities.supported |= UBX_MON_GNSS_GLONASS_MASK;
-                            found = true;
-                        }
-                    }
+static void gpsHandleNavStatusUBLOX(const void *payload, uint16_t length)
+{
+    const ubx_nav_status *status = payload;
+    UNUSED(length);
+
+    next_fix_type = gpsMapFixType(status->fix_status & NAV_STATUS_FIX_VALID, status->fix_type);
+    if (next_fix_type == GPS_NO_FIX)
+        gpsSol.fixType = GPS_NO_FIX;
+}
+
+static void gpsHandleNavSolUBLOX(const void *payload, uint16_t length)
+{
+    const ubx_nav_solution *solution = payload;
+    UNUSED(length);
+
+    next_fix_type = gpsMapFixType(solution->fix_status & NAV_STATUS_FIX_VALID, solution->fix_type);
+    if (next_fix_type == GPS_NO_FIX)
+        gpsSol.fixType = GPS_NO_FIX;
+    gpsSol.numSat = solution->satellites;
+    gpsSol.hdop = gpsConstrainHDOP(solution->position_DOP);
+}
+
+static void gpsHandleNavVelnedUBLOX(const void *payload, uint16_t length)
+{
+    const ubx_nav_velned *velned = payload;
+    UNUSED(length);
+
+    gpsSol.groundSpeed = velned->speed_2d;    // cm/s
+    gpsSol.groundCourse = (uint16_t) (velned->heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
+    gpsSol.velNED[X] = velned->ned_north;
+    gpsSol.velNED[Y] = velned->ned_east;
+    gpsSol.velNED[Z] = velned->ned_down;
+    gpsSol.flags.validVelNE = true;
+    gpsSol.flags.validVelD = true;
+    _new_speed = true;
+}
+
+static void gpsHandleNavTimeutcUBLOX(const void *payload, uint16_t length)
+{
+    const ubx_nav_timeutc *timeutc = payload;
+    UNUSED(length);
+
+    if (UBX_VALID_GPS_DATE_TIME(timeutc->valid)) {
+        gpsSol.time.year = timeutc->year;
+        gpsSol.time.month = timeutc->month;
+        gpsSol.time.day = timeutc->day;
+        gpsSol.time.hours = timeutc->hour;
+        gpsSol.time.minutes = timeutc->min;
+        gpsSol.time.seconds = timeutc->sec;
+        gpsSol.time.millis = timeutc->nano / (1000*1000);
+
+        gpsSol.flags.validTime = true;
+    } else {
+        gpsSol.flags.validTime = false;
+    }
+}
+
+static void gpsHandleNavPvtUBLOX(const void *payload, uint16_t length)
+{
+    const ubx_nav_pvt *pvt = payload;
+    UNUSED(length);
+
+    next_fix_type = gpsMapFixType(pvt->fix_status & NAV_STATUS_FIX_VALID, pvt->fix_type);
+    gpsSol.fixType = next_fix_type;
+    gpsSol.llh.lon = pvt->longitude;
+    gpsSol.llh.lat = pvt->latitude;
+    gpsSol.llh.alt = pvt->altitude_msl / 10;  //alt in cm
+    gpsSol.velNED[X]=pvt->ned_north / 10;  // to cm/s
+    gpsSol.velNED[Y]=pvt->ned_east / 10;   // to cm/s
+    gpsSol.velNED[Z]=pvt->ned_down / 10;   // to cm/s
+    gpsSol.groundSpeed = pvt->speed_2d / 10;    // to cm/s
+    gpsSol.groundCourse = (uint16_t) (pvt->heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
+    gpsSol.numSat = pvt->satellites;
+    gpsSol.eph = gpsConstrainEPE(pvt->horizontal_accuracy / 10);
+    gpsSol.epv = gpsConstrainEPE(pvt->vertical_accuracy / 10);
+    gpsSol.hdop = gpsConstrainHDOP(pvt->position_DOP);
+    gpsSol.flags.validVelNE = true;
+    gpsSol.flags.validVelD = true;
+    gpsSol.flags.validEPE = true;
+
+    if (UBX_VALID_GPS_DATE_TIME(pvt->valid)) {
+        gpsSol.time.year = pvt->year;
+        gpsSol.time.month = pvt->month;
+        gpsSol.time.day = pvt->day;
+        gpsSol.time.hours = pvt->hour;
+        gpsSol.time.minutes = pvt->min;
+        gpsSol.time.seconds = pvt->sec;
+        gpsSol.time.millis = pvt->nano / (1000*1000);
+
+        gpsSol.flags.validTime = true;
+    } else {
+        gpsSol.flags.validTime = false;
+    }
+
+    _new_position = true;
+    _new_speed = true;
+}
+
+static void gpsHandleMonVerUBLOX(const void *payload, uint16_t length)
+{
+    const ubx_mon_ver *ver = payload;
+    const char *bytes = payload;
+
+    gpsState.hwVersion = gpsDecodeHardwareVersion(ver->hwVersion, sizeof(ver->hwVersion));
+    if (gpsState.hwVersion >= UBX_HW_VERSION_UBLOX8) {
+        if (ver->swVersion[9] > '2' || true) {
+            // check extensions;
+            // after hw + sw vers; each is 30 bytes
+            bool found = false;
+            for (int j = 40; j < length && !found; j += 30)
+            {
+                const size_t extensionLength = MIN(30, length - j);
+                // Example content: GPS;GAL;BDS;GLO
+                if (strnstr(bytes + j, "GAL", extensionLength))
+                {
+                    ubx_capabilities.supported |= UBX_MON_GNSS_GALILEO_MASK;
+                    found = true;
                 }
-                for (int j = 40; j < _payload_length; j += 30) {
-                    if (strnstr((const char *)(_buffer.bytes + j), "PROTVER", 30)) {
-                        gpsDecodeProtocolVersion((const char *)(_buffer.bytes + j), 30);
-                        break;
-                    }
+                if (strnstr(bytes + j, "BDS", extensionLength))
+                {
+                    ubx_capabilities.supported |= UBX_MON_GNSS_BEIDOU_MASK;
+                    found = true;
+                }
+                if (strnstr(bytes + j, "GLO", extensionLength))
+                {
+                    ubx_capabilities.supported |= UBX_MON_GNSS_GLONASS_MASK;
+                    found = true;
                 }
             }
         }
-        break;
-    case MSG_MON_GNSS:
-        if(_class == CLASS_MON) {
-            if (_buffer.gnss.version == 0) {
-                ubx_capabilities.supported = _buffer.gnss.supported;
-                ubx_capabilities.defaultGnss = _buffer.gnss.defaultGnss;
-                ubx_capabilities.enabledGnss = _buffer.gnss.enabled;
-                ubx_capabilities.capMaxGnss = _buffer.gnss.maxConcurrent;
-                gpsState.lastCapaUpdMs = millis();
+        for (int j = 40; j < length; j += 30) {
+            const size_t extensionLength = MIN(30, length - j);
+            if (strnstr(bytes + j, "PROTVER", extensionLength)) {
+                gpsDecodeProtocolVersion(bytes + j, extensionLength);
+                break;
             }
         }
-        break;
-    case MSG_ACK_ACK:
-        if ((_ack_state == UBX_ACK_WAITING) && (_buffer.ack.msg == _ack_waiting_msg)) {
-            _ack_state = UBX_ACK_GOT_ACK;
-        }
-        break;
-    case MSG_ACK_NACK:
-        if ((_ack_state == UBX_ACK_WAITING) && (_buffer.ack.msg == _ack_waiting_msg)) {
-            _ack_state = UBX_ACK_GOT_NAK;
-        }
-        break;
-    default:
-        return false;
     }
+}
 
-    // we only return true when we get new position and speed data
-    // this ensures we don't use stale data
-    if (_new_position && _new_speed) {
-        _new_speed = _new_position = false;
-        return true;
+static void gpsHandleMonGnssUBLOX(const void *payload, uint16_t length)
+{
+    const ubx_mon_gnss *gnss = payload;
+    UNUSED(length);
+
+    if (gnss->version == 0) {
+        ubx_capabilities.supported = gnss->supported;
+        ubx_capabilities.defaultGnss = gnss->defaultGnss;
+        ubx_capabilities.enabledGnss = gnss->enabled;
+        ubx_capabilities.capMaxGnss = gnss->maxConcurrent;
+        gpsState.lastCapaUpdMs = millis();
     }
+}
 
-    return false;
+static void gpsHandleAckUBLOX(const void *payload, uint16_t length)
+{
+    const ubx_ack_ack *ack = payload;
+    UNUSED(length);
+
+    if ((_ack_state == UBX_ACK_WAITING) && (ack->msg == _ack_waiting_msg)) {
+        _ack_state = UBX_ACK_GOT_ACK;
+    }
 }
 
-static bool gpsNewFrameUBLOX(uint8_t data)
+static void gpsHandleNackUBLOX(const void *payload, uint16_t length)
 {
-    bool parsed = false;
+    const ubx_ack_ack *ack = payload;
+    UNUSED(length);
 
-    switch (_step) {
-        case 0: // Sync char 1 (0xB5)
-            if (PREAMBLE1 == data) {
-                _skip_packet = false;
-                _step++;
-            }
-            break;
-        case 1: // Sync char 2 (0x62)
-            if (PREAMBLE2 != data) {
-                _step = 0;
-                break;
-            }
-            _step++;
-            break;
-        case 2: // Class
-            _step++;
-            _class = data;
-            _ck_b = _ck_a = data;   // reset the checksum accumulators
-            break;
-        case 3: // Id
-            _step++;
-            _ck_b += (_ck_a += data);       // checksum byte
-            _msg_id = data;
-            break;
-        case 4: // Payload length (part 1)
-            _step++;
-            _ck_b += (_ck_a += data);       // checksum byte
-            _payload_length = data; // payload length low byte
-            break;
-        case 5: // Payload length (part 2)
-            _step++;
-            _ck_b += (_ck_a += data);       // checksum byte
-            _payload_length |= (uint16_t)(data << 8);
-            if (_payload_length > MAX_UBLOX_PAYLOAD_SIZE ) {
-                // we can't receive the whole packet, just log the error and start searching for the next packet.
-                gpsStats.errors++;
-                _step = 0;
-                break;
-            }
-            // prepare to receive payload
-            _payload_counter = 0;
-            if (_payload_length == 0) {
-                _step = 7;
-            }
-            break;
-        case 6:
-            _ck_b += (_ck_a += data);       // checksum byte
-            if (_payload_counter < MAX_UBLOX_PAYLOAD_SIZE) {
-                _buffer.bytes[_payload_counter] = data;
-            }
-            // NOTE: check counter BEFORE increasing so that a payload_size of 65535 is correctly handled.  This can happen if garbage data is received.
-            if (_payload_counter ==  _payload_length - 1) {
-                _step++;
-            }
-            _payload_counter++;
-            break;
-        case 7:
-            _step++;
-            if (_ck_a != data) {
-                _skip_packet = true;          // bad checksum
-                gpsStats.errors++;
-                _step = 0;
-            }
-            break;
-        case 8:
-            _step = 0;
+    if ((_ack_state == UBX_ACK_WAITING) && (ack->msg == _ack_waiting_msg)) {
+        _ack_state = UBX_ACK_GOT_NAK;
+    }
+}
 
-            if (_ck_b != data) {
-                gpsStats.errors++;
-                break;              // bad checksum
-            }
+typedef struct {
+    uint8_t msgClass;
+    uint8_t msgId;
+    uint16_t minLength;     // Shorter frames are ignored, handlers can read up to here without checking
+    void (*handler)(const void *payload, uint16_t length);
+} ubxFrameHandler_t;
+
+static const ubxFrameHandler_t ubxFrameHandlers[] = {
+    // Most frequent first
+    { CLASS_NAV, MSG_PVT,       offsetof(ubx_nav_pvt, reserved2),   gpsHandleNavPvtUBLOX },     // u-blox 7 sends 84 bytes, M8+ 92
+    { CLASS_NAV, MSG_POSLLH,    sizeof(ubx_nav_posllh),             gpsHandleNavPosllhUBLOX },
+    { CLASS_NAV, MSG_VELNED,    sizeof(ubx_nav_velned),             gpsHandleNavVelnedUBLOX },
+    { CLASS_NAV, MSG_STATUS,    sizeof(ubx_nav_status),             gpsHandleNavStatusUBLOX },
+    { CLASS_NAV, MSG_SOL,       sizeof(ubx_nav_solution),           gpsHandleNavSolUBLOX },
+    { CLASS_NAV, MSG_TIMEUTC,   sizeof(ubx_nav_timeutc),            gpsHandleNavTimeutcUBLOX },
+    { CLASS_ACK, MSG_ACK_ACK,   sizeof(ubx_ack_ack),                gpsHandleAckUBLOX },
+    { CLASS_ACK, MSG_ACK_NACK,  sizeof(ubx_ack_ack),                gpsHandleNackUBLOX },
+    { CLASS_MON, MSG_VER,       sizeof(ubx_mon_ver),                gpsHandleMonVerUBLOX },
+    { CLASS_MON, MSG_MON_GNSS,  sizeof(ubx_mon_gnss),               gpsHandleMonGnssUBLOX },
+};
 
-            gpsStats.packetCount++;
+static bool gpsDispatchFrameUBLOX(const ubxFrame_t *frame)
+{
+    for (unsigned i = 0; i < ARRAYLEN(ubxFrameHandlers); i++) {
+        const ubxFrameHandler_t *entry = &ubxFrameHandlers[i];
 
-            if (_skip_packet) {
-                break;
-            }
+        if (entry->msgClass != frame->msgClass || entry->msgId != frame->msgId) {
+            continue;
+        }
 
-            if (gpsParseFrameUBLOX()) {
-                parsed = true;
-            }
+        if (frame->length < entry->minLength) {
+            return false;
+        }
+
+        const void *payload = frame->payload;
+        if ((uintptr_t)payload & 3) {
+            memcpy(_buffer.bytes, payload, frame->length);
+            payload = _buffer.bytes;
+        }
+
+        entry->handler(payload, frame->length);
+        break;
+    }
+
+    // we only return true when we get new position and speed data
+    // this ensures we don't use stale data
+    if (_new_position && _new_speed) {
+        _new_speed = _new_position = false;
+        return true;
     }
 
-    return parsed;
+    return false;
 }
 
 static uint16_t hz2rate(uint8_t hz)
@@ -973,17 +961,33 @@ STATIC_PROTOTHREAD(gpsProtocolReceiverThread)
     ptBegin(gpsProtocolReceiverThread);
 
     while (1) {
-        // Wait until there are bytes to consume
-        ptWait(serialRxBytesWaiting(gpsState.gpsPort));
+        // Wait until there are bytes to consume, or frames left over from the last run
+        ptWait(ubxFramePending || serialRxBytesWaiting(gpsState.gpsPort));
+
+        // Move everything received so far into the parser in one go
+        uint16_t space;
+        uint8_t *dst = ubxParserGetWriteBuffer(&ubxParser, &space);
+        const uint16_t count = MIN(space, serialRxBytesWaiting(gpsState.gpsPort));
+        for (uint16_t i = 0; i < count; i++) {
+            dst[i] = serialRead(gpsState.gpsPort);
+        }
+        ubxParserCommitWrite(&ubxParser, count);
 
-        // Consume bytes until buffer empty of until we have full message received
-        while (serialRxBytesWaiting(gpsState.gpsPort)) {
-            uint8_t newChar = serialRead(gpsState.gpsPort);
-            if (gpsNewFrameUBLOX(newChar)) {
+        // Handle complete frames until we have a new solution, the rest waits for the next run
+        ubxFrame_t frame;
+        ubxFramePending = false;
+        while (ubxParserNextFrame(&ubxParser, &frame)) {
+            if (gpsDispatchFrameUBLOX(&frame)) {
                 ptSemaphoreSignal(semNewDataReady);
+                ubxFramePending = true;
                 break;
             }
         }
+
+        gpsStats.packetCount += ubxParser.frames;
+        gpsStats.errors += ubxParser.errors;
+        ubxParser.frames = 0;
+        ubxParser.errors = 0;
     }
 
     ptEnd(0);
@@ -1083,6 +1087,8 @@ STATIC_PROTOTHREAD(gpsProtocolStateThread)
 
 void gpsRestartUBLOX(void)
 {
+    ubxParserInit(&ubxParser);
+    ubxFramePending = false;
     ptSemaphoreInit(semNewDataReady);
     ptRestart(ptGetHandle(gpsProtocolReceiverThread));
     ptRestart(ptGetHandle(gpsProtocolStateThread));
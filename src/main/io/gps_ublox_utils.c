@@ -16,18 +16,27 @@
  */
 
 
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "gps_ublox_utils.h"
 
-void ublox_update_checksum(uint8_t *data, uint8_t len, uint8_t *ck_a, uint8_t *ck_b)
+// Frames start at this offset after compaction so that the payload is 4 byte aligned
+#define UBX_PARSER_FRAME_OFFSET     2
+
+void ublox_update_checksum(const uint8_t *data, uint16_t len, uint8_t *ck_a, uint8_t *ck_b)
 {
-    *ck_a = *ck_b = 0;
+    uint8_t a = 0;
+    uint8_t b = 0;
+
     while (len--) {
-        *ck_a += *data;
-        *ck_b += *ck_a;
-        data++;
+        a += *data++;
+        b += a;
     }
+
+    *ck_a = a;
+    *ck_b = b;
 }
 
 int ubloxCfgFillBytes(ubx_config_data8_t *cfg, ubx_config_data8_payload_t *kvPairs, uint8_t count)
@@ -60,3 +69,100 @@ int ubloxCfgFillBytes(ubx_config_data8_t *cfg, ubx_config_data8_payload_t *kvPai
     return count;
 }
 
+
+void ubxParserInit(ubxParser_t *parser)
+{
+    parser->start = UBX_PARSER_FRAME_OFFSET;
+    parser->end = UBX_PARSER_FRAME_OFFSET;
+    parser->errors = 0;
+    parser->frames = 0;
+}
+
+/*
+ * Moves the unparsed tail, at most one incomplete frame, back to the start of the buffer. UBX payload
+ * lengths are usually multiples of 4, so once a frame is aligned the ones following it are too and
+ * the payload can be read as a struct in place.
+ */
+static void ubxParserCompact(ubxParser_t *parser)
+{
+    const uint16_t pending = parser->end - parser->start;
+
+    if (parser->start != UBX_PARSER_FRAME_OFFSET) {
+        memmove(&parser->buffer[UBX_PARSER_FRAME_OFFSET], &parser->buffer[parser->start], pending);
+        parser->start = UBX_PARSER_FRAME_OFFSET;
+        parser->end = UBX_PARSER_FRAME_OFFSET + pending;
+    }
+}
+
+uint8_t *ubxParserGetWriteBuffer(ubxParser_t *parser, uint16_t *space)
+{
+    ubxParserCompact(parser);
+    *space = UBX_PARSER_BUFFER_SIZE - parser->end;
+    return &parser->buffer[parser->end];
+}
+
+void ubxParserCommitWrite(ubxParser_t *parser, uint16_t count)
+{
+    parser->end += count;
+}
+
+bool ubxParserNextFrame(ubxParser_t *parser, ubxFrame_t *frame)
+{
+    while (parser->start < parser->end) {
+        const uint8_t *sync = memchr(&parser->buffer[parser->start], PREAMBLE1, parser->end - parser->start);
+        if (!sync) {
+            // Nothing that looks like a frame, drop it all
+            parser->start = parser->end;
+            return false;
+        }
+
+        parser->start = sync - parser->buffer;
+        const uint16_t available = parser->end - parser->start;
+
+        if (available < 2) {
+            return false;
+        }
+
+        if (sync[1] != PREAMBLE2) {
+            parser->start++;
+            continue;
+        }
+
+        if (available < UBX_FRAME_HEADER_SIZE) {
+            return false;
+        }
+
+        const uint16_t length = sync[4] | (sync[5] << 8);
+        if (length > MAX_UBLOX_PAYLOAD_SIZE) {
+            // Can't receive the whole frame, search for the next one
+            parser->errors++;
+            parser->start++;
+            continue;
+        }
+
+        if (available < length + UBX_FRAME_OVERHEAD) {
+            return false;
+        }
+
+        uint8_t ck_a, ck_b;
+        ublox_update_checksum(&sync[2], length + 4, &ck_a, &ck_b);
+        if (ck_a != sync[length + UBX_FRAME_HEADER_SIZE] || ck_b != sync[length + UBX_FRAME_HEADER_SIZE + 1]) {
+            // Might have been a sync sequence inside another frame, resync right after it
+            parser->errors++;
+            parser->start++;
+            continue;
+        }
+
+        frame->msgClass = sync[2];
+        frame->msgId = sync[3];
+        frame->length = length;
+        frame->payload = &sync[UBX_FRAME_HEADER_SIZE];
+
+        parser->start += length + UBX_FRAME_OVERHEAD;
+        parser->frames++;
+
+        return true;
+    }
+
+    return false;
+}
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "gps_ublox.h"
@@ -25,9 +26,39 @@
 extern "C" {
 #endif
 
+#define UBX_FRAME_HEADER_SIZE       6   // sync 1, sync 2, class, id, length (2)
+#define UBX_FRAME_OVERHEAD          (UBX_FRAME_HEADER_SIZE + 2)
+#define UBX_PARSER_BUFFER_SIZE      (2 * (MAX_UBLOX_PAYLOAD_SIZE + UBX_FRAME_OVERHEAD))
+
+/*
+ * Block parser for UBX frames. Received bytes are written straight into the parser buffer, frames are
+ * found by searching for the sync bytes and checked with one checksum pass over the whole frame. The
+ * payload of a frame is handed out in place, no copy.
+ */
+typedef struct ubxParser_s {
+    uint8_t buffer[UBX_PARSER_BUFFER_SIZE] __attribute__((aligned(4)));
+    uint16_t start;         // First byte not parsed yet
+    uint16_t end;           // One past the last byte received
+    uint32_t errors;        // Frames dropped because of bad length or checksum
+    uint32_t frames;        // Valid frames
+} ubxParser_t;
+
+typedef struct ubxFrame_s {
+    uint8_t msgClass;
+    uint8_t msgId;
+    uint16_t length;
+    const uint8_t *payload; // Points into the parser buffer, valid until the next write
+} ubxFrame_t;
+
 int ubloxCfgFillBytes(ubx_config_data8_t *cfg, ubx_config_data8_payload_t *kvPairs, uint8_t count);
 
-void ublox_update_checksum(uint8_t *data, uint8_t len, uint8_t *ck_a, uint8_t *ck_b);
+void ublox_update_checksum(const uint8_t *data, uint16_t len, uint8_t *ck_a, uint8_t *ck_b);
+
+void ubxParserInit(ubxParser_t *parser);
+// Returns where new bytes go and how many fit. Call ubxParserCommitWrite() with the count actually written.
+uint8_t *ubxParserGetWriteBuffer(ubxParser_t *parser, uint16_t *space);
+void ubxParserCommitWrite(ubxParser_t *parser, uint16_t count);
+bool ubxParserNextFrame(ubxParser_t *parser, ubxFrame_t *frame);
 
 #ifdef __cplusplus
 }
@@ -154,6 +154,14 @@
 
 #define OSD_MIN_FONT_VERSION 3
 
+#define OSD_SLOW_ELEMENT_ROUNDS 4 // Slow elements are drawn once every N rounds over the element list
+
+typedef enum {
+    OSD_ELEMENT_REFRESH_NORMAL = 0, // Drawn once per round over the element list
+    OSD_ELEMENT_REFRESH_FAST,       // Drawn in a dedicated slot on every other call
+    OSD_ELEMENT_REFRESH_SLOW,       // Drawn once every OSD_SLOW_ELEMENT_ROUNDS rounds
+} osdElementRefresh_e;
+
 static timeMs_t notify_settings_saved = 0;
 static bool     savingSettings = false;
 
@@ -184,10 +192,22 @@ static timeUs_t resumeRefreshAt = 0;
 static bool refreshWaitForResumeCmdRelease;
 
 static bool fullRedraw = false;
+static uint8_t slowElementsRedrawRounds = 0;
+
+// Visible elements of the active layout in draw order, compiled by osdBuildElementList()
+static uint8_t elementList[OSD_ITEM_COUNT];
+static uint8_t elementListCount;
+static uint8_t fastElementList[OSD_ITEM_COUNT];
+static uint8_t fastElementListCount;
+static bool elementListValid = false;
+static uint32_t elementListFeatures;
+static uint32_t elementListSensors;
+static bool elementListEscSensor;
 
 static uint8_t armState;
 
 static textAttributes_t osdGetMultiFunctionMessage(char *buff);
+static void osdInvalidateElementList(void);
 static uint8_t osdWarningsFlags = 0;
 
 typedef struct osdMapData_s {
@@ -217,6 +237,7 @@ void osdStartedSaveProcess(void) {
 
 void osdShowEEPROMSavedNotification(void) {
     savingSettings = false;
+    osdInvalidateElementList();
     notify_settings_saved = millis() + 5000;
 }
 
@@ -2401,8 +2422,9 @@ static bool osdDrawSingleElement(uint8_t item)
 
         if (STATE(GPS_FIX) && isImuHeadingValid()) {
 
-            if (osdConfig()->hud_homepoint || osdConfig()->hud_radar_disp > 0 || osdConfig()->hud_wp_disp > 0) {
-                    osdHudClear();
+            const bool hudPoiEnabled = osdConfig()->hud_homepoint || osdConfig()->hud_radar_disp > 0 || osdConfig()->hud_wp_disp > 0;
+            if (hudPoiEnabled) {
+                osdHudBeginFrame();
             }
 
             // -------- POI : Home point
@@ -2453,6 +2475,10 @@ static bool osdDrawSingleElement(uint8_t item)
                     }
                 }
             }
+
+            if (hudPoiEnabled) {
+                osdHudEndFrame();
+            }
         }
 
         return true;
@@ -3655,14 +3681,168 @@ uint8_t osdIncElementIndex(uint8_t elementIndex)
     return elementIndex;
 }
 
+static osdElementRefresh_e osdGetElementRefresh(uint8_t item)
+{
+    switch (item) {
+    // Elements tracking attitude, speed and altitude are given their own draw slot
+    case OSD_HORIZON_SIDEBARS:
+    case OSD_THROTTLE_POS:
+    case OSD_SCALED_THROTTLE_POS:
+    case OSD_GPS_SPEED:
+    case OSD_3D_SPEED:
+    case OSD_AIR_SPEED:
+    case OSD_ALTITUDE:
+    case OSD_ALTITUDE_MSL:
+    case OSD_VARIO:
+    case OSD_VARIO_NUM:
+    case OSD_HOME_DIR:
+    case OSD_HEADING:
+    case OSD_HEADING_GRAPH:
+    case OSD_GROUND_COURSE:
+    case OSD_ATTITUDE_PITCH:
+    case OSD_ATTITUDE_ROLL:
+        return OSD_ELEMENT_REFRESH_FAST;
+
+    // Elements showing names and settings only change on config or in-flight adjustments
+    case OSD_CRAFT_NAME:
+    case OSD_PILOT_NAME:
+    case OSD_PILOT_LOGO:
+    case OSD_VERSION:
+    case OSD_ROLL_PIDS:
+    case OSD_PITCH_PIDS:
+    case OSD_YAW_PIDS:
+    case OSD_LEVEL_PIDS:
+    case OSD_POS_XY_PIDS:
+    case OSD_POS_Z_PIDS:
+    case OSD_VEL_XY_PIDS:
+    case OSD_VEL_Z_PIDS:
+    case OSD_HEADING_P:
+    case OSD_BOARD_ALIGN_ROLL:
+    case OSD_BOARD_ALIGN_PITCH:
+    case OSD_RC_EXPO:
+    case OSD_RC_YAW_EXPO:
+    case OSD_THROTTLE_EXPO:
+    case OSD_PITCH_RATE:
+    case OSD_ROLL_RATE:
+    case OSD_YAW_RATE:
+    case OSD_MANUAL_RC_EXPO:
+    case OSD_MANUAL_RC_YAW_EXPO:
+    case OSD_MANUAL_PITCH_RATE:
+    case OSD_MANUAL_ROLL_RATE:
+    case OSD_MANUAL_YAW_RATE:
+    case OSD_NAV_FW_CRUISE_THR:
+    case OSD_NAV_FW_PITCH2THR:
+    case OSD_FW_MIN_THROTTLE_DOWN_PITCH_ANGLE:
+    case OSD_TPA:
+    case OSD_TPA_TIME_CONSTANT:
+    case OSD_NAV_FW_CONTROL_SMOOTHNESS:
+        return OSD_ELEMENT_REFRESH_SLOW;
+
+    default:
+        return OSD_ELEMENT_REFRESH_NORMAL;
+    }
+}
+
+static void osdRedrawSlowElements(void)
+{
+    // Covers the rest of the current round plus a full one
+    slowElementsRedrawRounds = 2;
+}
+
+static void osdInvalidateElementList(void)
+{
+    elementListValid = false;
+}
+
+// Sensors osdIncElementIndex() checks, they can come and go at runtime
+#define OSD_ELEMENT_LIST_SENSORS (SENSOR_ACC | SENSOR_MAG)
+
+static bool osdElementListIsStale(void)
+{
+    return !elementListValid || elementListFeatures != featureMask() ||
+        elementListSensors != (sensorsMask() & OSD_ELEMENT_LIST_SENSORS) ||
+        elementListEscSensor != (bool)STATE(ESC_SENSOR_ENABLED);
+}
+
+/*
+ * Compile the elements of the active layout which can be drawn into dense lists,
+ * so the per-tick iteration doesn't re-evaluate the feature and sensor checks in
+ * osdIncElementIndex() for every element. Rebuilt on layout switch, full redraw,
+ * config save, and when the features or the sensors those checks look at change.
+ */
+static void osdBuildElementList(void)
+{
+    elementListCount = 0;
+    fastElementListCount = 0;
+
+    uint8_t item = 0;
+    do {
+        item = osdIncElementIndex(item);
+
+        if (!OSD_VISIBLE(osdLayoutsConfig()->item_pos[currentLayout][item])) {
+            continue;
+        }
+
+        if (osdGetElementRefresh(item) == OSD_ELEMENT_REFRESH_FAST) {
+            fastElementList[fastElementListCount++] = item;
+        } else {
+            elementList[elementListCount++] = item;
+        }
+    } while (item != 0);
+
+    elementListFeatures = featureMask();
+    elementListSensors = sensorsMask() & OSD_ELEMENT_LIST_SENSORS;
+    elementListEscSensor = STATE(ESC_SENSOR_ENABLED);
+    elementListValid = true;
+}
+
+static bool osdDrawNextFastElement(void)
+{
+    static uint8_t elementIndex = 0;
+
+    for (unsigned i = 0; i < fastElementListCount; i++) {
+        elementIndex = (elementIndex + 1) % fastElementListCount;
+        if (osdDrawSingleElement(fastElementList[elementIndex])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void osdDrawNextElement(void)
 {
     static uint8_t elementIndex = 0;
-    // Flag for end of loop, also prevents infinite loop when no elements are enabled
-    uint8_t index = elementIndex;
-    do {
-        elementIndex = osdIncElementIndex(elementIndex);
-    } while (!osdDrawSingleElement(elementIndex) && index != elementIndex);
+    static uint8_t elementRound = 0;
+    static bool fastSlot = false;
+
+    if (osdElementListIsStale()) {
+        osdBuildElementList();
+    }
+
+    // Every other call is reserved for fast changing elements. If none of them
+    // is visible, the slot goes to the rest of the elements.
+    fastSlot = !fastSlot;
+    if (!fastSlot || !osdDrawNextFastElement()) {
+        for (unsigned i = 0; i < elementListCount; i++) {
+            if (++elementIndex >= elementListCount) {
+                elementIndex = 0;
+                elementRound++;
+                if (slowElementsRedrawRounds > 0) {
+                    slowElementsRedrawRounds--;
+                }
+            }
+
+            const uint8_t item = elementList[elementIndex];
+            if (osdGetElementRefresh(item) == OSD_ELEMENT_REFRESH_SLOW && (elementRound % OSD_SLOW_ELEMENT_ROUNDS) && !slowElementsRedrawRounds) {
+                continue;
+            }
+
+            if (osdDrawSingleElement(item)) {
+                break;
+            }
+        }
+    }
 
     // Draw artificial horizon + tracking telemtry last
     osdDrawSingleElement(OSD_ARTIFICIAL_HORIZON);
@@ -4790,6 +4970,7 @@ static void osdRefresh(timeUs_t currentTimeUs)
     if (IS_RC_MODE_ACTIVE(BOXOSD) && !(osdConfig()->osd_failsafe_switch_layout && FLIGHT_MODE(FAILSAFE_MODE))) {
 #endif
       displayClearScreen(osdDisplayPort);
+      osdRedrawSlowElements();
       armState = ARMING_FLAG(ARMED);
       return;
     }
@@ -4888,6 +5069,7 @@ static void osdRefresh(timeUs_t currentTimeUs)
             // Time elapsed or canceled by stick commands.
             // Exit to normal OSD operation.
             displayClearScreen(osdDisplayPort);
+            osdRedrawSlowElements();
             resumeRefreshAt = 0;
             statsDisplayed = false;
         } else {
@@ -4899,17 +5081,25 @@ static void osdRefresh(timeUs_t currentTimeUs)
     }
 
 #ifdef USE_CMS
+    static bool displayWasGrabbed = false;
     if (!displayIsGrabbed(osdDisplayPort)) {
         displayBeginTransaction(osdDisplayPort, DISPLAY_TRANSACTION_OPT_RESET_DRAWING);
         if (fullRedraw) {
             displayClearScreen(osdDisplayPort);
             fullRedraw = false;
+            osdRedrawSlowElements();
+        } else if (displayWasGrabbed) {
+            // Releasing the display from CMS clears it, and the layout might have been edited
+            osdRedrawSlowElements();
+            osdInvalidateElementList();
         }
+        displayWasGrabbed = false;
         osdDrawNextElement();
         displayHeartbeat(osdDisplayPort);
         displayCommitTransaction(osdDisplayPort);
-#ifdef OSD_CALLS_CMS
     } else {
+        displayWasGrabbed = true;
+#ifdef OSD_CALLS_CMS
         cmsUpdate(currentTimeUs);
 #endif
     }
@@ -5003,6 +5193,7 @@ void osdUpdate(timeUs_t currentTimeUs)
 void osdStartFullRedraw(void)
 {
     fullRedraw = true;
+    osdInvalidateElementList();
 }
 
 void osdOverrideLayout(int layout, timeMs_t duration)
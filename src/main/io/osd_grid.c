@@ -25,6 +25,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -109,6 +110,18 @@ static float osdGetAspectRatioCorrection(void)
     return osdDisplayIsPAL() ? 12.0f/15.0f : 12.0f/18.46f;
 }
 
+// Returns true if the AHI wrote at (dx, dy) in the set described by written/orient
+static bool osdGridAhiSetContains(const int8_t *written, int8_t orient, int8_t dx, int8_t dy)
+{
+    if (orient == -1) {
+        return false;
+    }
+
+    const int index = (orient ? dy : dx) + OSD_AHI_PREV_SIZE / 2;
+    const int value = (orient ? dx : dy) + OSD_AHI_PREV_SIZE / 2;
+    return index >= 0 && index < OSD_AHI_PREV_SIZE && written[index] == value;
+}
+
 void osdGridDrawArtificialHorizon(displayPort_t *display, unsigned gx, unsigned gy, float pitchAngle, float rollAngle)
 {
     UNUSED(gx);
@@ -123,23 +136,22 @@ void osdGridDrawArtificialHorizon(displayPort_t *display, unsigned gx, unsigned
     static int8_t previous_written[OSD_AHI_PREV_SIZE];
     static int8_t previous_orient = -1;
 
+    // The new line is computed first and only the symmetric difference with the
+    // previous one hits the display: positions not drawn again are blanked and
+    // positions drawn again are overwritten in place, which the display drivers
+    // skip when the character doesn't change.
+    int8_t written[OSD_AHI_PREV_SIZE];
+    uint16_t writtenChar[OSD_AHI_PREV_SIZE];
+    int8_t orient;
+
+    memset(written, -1, sizeof(written));
+
     const float pitch_rad_to_char = (float)(OSD_AHI_HEIGHT / 2 + 0.5) / DEGREES_TO_RADIANS(osdConfig()->ahi_max_pitch);
 
     const float ky = sin_approx(rollAngle);
     const float kx = cos_approx(rollAngle);
     const float ratio = osdGetAspectRatioCorrection();
 
-    if (previous_orient != -1) {
-        for (int i = 0; i < OSD_AHI_PREV_SIZE; ++i) {
-            if (previous_written[i] > -1) {
-                int8_t dx = (previous_orient ? previous_written[i] : i) - OSD_AHI_PREV_SIZE / 2;
-                int8_t dy = (previous_orient ? i : previous_written[i]) - OSD_AHI_PREV_SIZE / 2;
-                displayWriteChar(display, elemPosX + dx, elemPosY - dy, SYM_BLANK);
-                previous_written[i] = -1;
-            }
-        }
-    }
-
     int8_t ahiPitchAngleDatum;     // sets the pitch datum AHI is drawn relative to (degrees)
     int8_t ahiLineEndPitchOffset;  // AHI end of line offset in degrees when ahiPitchAngleDatum > 0
 
@@ -152,7 +164,7 @@ void osdGridDrawArtificialHorizon(displayPort_t *display, unsigned gx, unsigned
 
     if (fabsf(ky) < fabsf(kx)) {
 
-        previous_orient = 0;
+        orient = 0;
 
         /* ahi line ends drawn with 3 deg offset when ahiPitchAngleDatum > 0
          * Line end offset increased by 1 deg with every 20 deg pitch increase */
@@ -165,16 +177,17 @@ void osdGridDrawArtificialHorizon(displayPort_t *display, unsigned gx, unsigned
             const uint8_t chX = elemPosX + dx, chY = elemPosY - dy;
             uint16_t c;
 
-            if ((dy >= -OSD_AHI_HEIGHT / 2) && (dy <= OSD_AHI_HEIGHT / 2) && displayReadCharWithAttr(display, chX, chY, &c, NULL) && (c == SYM_BLANK)) {
-                c = SYM_AH_H_START + ((OSD_AHI_H_SYM_COUNT - 1) - (uint8_t)((fy - dy) * OSD_AHI_H_SYM_COUNT));
-                displayWriteChar(display, elemPosX + dx, elemPosY - dy, c);
-                previous_written[dx + OSD_AHI_PREV_SIZE / 2] = dy + OSD_AHI_PREV_SIZE / 2;
+            // Draw over blanks and over our own line from the previous iteration
+            if ((dy >= -OSD_AHI_HEIGHT / 2) && (dy <= OSD_AHI_HEIGHT / 2) && displayReadCharWithAttr(display, chX, chY, &c, NULL) &&
+                    (c == SYM_BLANK || osdGridAhiSetContains(previous_written, previous_orient, dx, dy))) {
+                writtenChar[dx + OSD_AHI_PREV_SIZE / 2] = SYM_AH_H_START + ((OSD_AHI_H_SYM_COUNT - 1) - (uint8_t)((fy - dy) * OSD_AHI_H_SYM_COUNT));
+                written[dx + OSD_AHI_PREV_SIZE / 2] = dy + OSD_AHI_PREV_SIZE / 2;
             }
         }
 
     } else {
 
-        previous_orient = 1;
+        orient = 1;
 
         for (int8_t dy = -OSD_AHI_HEIGHT / 2; dy <= OSD_AHI_HEIGHT / 2; dy++) {
             const float fx = ((dy / ratio) - pitchAngle * pitch_rad_to_char) * (kx / ky) + 0.5f;
@@ -182,13 +195,38 @@ void osdGridDrawArtificialHorizon(displayPort_t *display, unsigned gx, unsigned
             const uint8_t chX = elemPosX + dx, chY = elemPosY - dy;
             uint16_t c;
 
-            if ((dx >= -OSD_AHI_WIDTH / 2) && (dx <= OSD_AHI_WIDTH / 2) && displayReadCharWithAttr(display, chX, chY, &c, NULL) && (c == SYM_BLANK)) {
-                c = SYM_AH_V_START + (fx - dx) * OSD_AHI_V_SYM_COUNT;
-                displayWriteChar(display, chX, chY, c);
-                previous_written[dy + OSD_AHI_PREV_SIZE / 2] = dx + OSD_AHI_PREV_SIZE / 2;
+            if ((dx >= -OSD_AHI_WIDTH / 2) && (dx <= OSD_AHI_WIDTH / 2) && displayReadCharWithAttr(display, chX, chY, &c, NULL) &&
+                    (c == SYM_BLANK || osdGridAhiSetContains(previous_written, previous_orient, dx, dy))) {
+                writtenChar[dy + OSD_AHI_PREV_SIZE / 2] = SYM_AH_V_START + (fx - dx) * OSD_AHI_V_SYM_COUNT;
+                written[dy + OSD_AHI_PREV_SIZE / 2] = dx + OSD_AHI_PREV_SIZE / 2;
+            }
+        }
+    }
+
+    // Erase the positions of the previous line which are not part of the new one
+    if (previous_orient != -1) {
+        for (int i = 0; i < OSD_AHI_PREV_SIZE; ++i) {
+            if (previous_written[i] > -1) {
+                int8_t dx = (previous_orient ? previous_written[i] : i) - OSD_AHI_PREV_SIZE / 2;
+                int8_t dy = (previous_orient ? i : previous_written[i]) - OSD_AHI_PREV_SIZE / 2;
+                if (!osdGridAhiSetContains(written, orient, dx, dy)) {
+                    displayWriteChar(display, elemPosX + dx, elemPosY - dy, SYM_BLANK);
+                }
             }
         }
     }
+
+    // Draw the new line
+    for (int i = 0; i < OSD_AHI_PREV_SIZE; ++i) {
+        if (written[i] > -1) {
+            int8_t dx = (orient ? written[i] : i) - OSD_AHI_PREV_SIZE / 2;
+            int8_t dy = (orient ? i : written[i]) - OSD_AHI_PREV_SIZE / 2;
+            displayWriteChar(display, elemPosX + dx, elemPosY - dy, writtenChar[i]);
+        }
+    }
+
+    memcpy(previous_written, written, sizeof(written));
+    previous_orient = orient;
 }
 
 void osdGridDrawHeadingGraph(displayPort_t *display, unsigned gx, unsigned gy, int heading)
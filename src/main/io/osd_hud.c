@@ -16,6 +16,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -39,21 +40,55 @@
 
 #define HUD_DRAWN_MAXCHARS 54 // 8 POI (1 home, 4 radar, 3 WP) x 7 chars max for each, minus 2 for H
 
+// Positions written in the current and in the previous HUD frame. Keeping the previous
+// set lets us erase only the positions which aren't drawn again, instead of blanking
+// everything and rewriting the same characters on every frame.
 static int8_t hud_drawn[HUD_DRAWN_MAXCHARS][2];
-static int8_t hud_drawn_pt;
+static uint8_t hud_drawn_count;
+static int8_t hud_prev_drawn[HUD_DRAWN_MAXCHARS][2];
+static uint8_t hud_prev_drawn_count;
+
+static bool osdHudWasDrawn(uint8_t px, uint8_t py)
+{
+    for (int i = 0; i < hud_prev_drawn_count; i++) {
+        if (hud_prev_drawn[i][0] == px && hud_prev_drawn[i][1] == py) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool osdHudIsDrawn(int8_t px, int8_t py)
+{
+    for (int i = 0; i < hud_drawn_count; i++) {
+        if (hud_drawn[i][0] == px && hud_drawn[i][1] == py) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Start a new HUD frame, positions written in the last one are kept until osdHudEndFrame()
+ */
+void osdHudBeginFrame(void)
+{
+    memcpy(hud_prev_drawn, hud_drawn, sizeof(hud_drawn));
+    hud_prev_drawn_count = hud_drawn_count;
+    hud_drawn_count = 0;
+}
 
 /*
- * Overwrite all previously written positions on the OSD with a blank
+ * Overwrite the positions written in the previous frame but not in this one with a blank
  */
-void osdHudClear(void)
+void osdHudEndFrame(void)
 {
-    for (int i = 0; i < HUD_DRAWN_MAXCHARS; i++) {
-        if (hud_drawn[i][0] > -1) {
-            displayWriteChar(osdGetDisplayPort(), hud_drawn[i][0], hud_drawn[i][1], SYM_BLANK);
-            hud_drawn[i][0] = -1;
+    for (int i = 0; i < hud_prev_drawn_count; i++) {
+        if (!osdHudIsDrawn(hud_prev_drawn[i][0], hud_prev_drawn[i][1])) {
+            displayWriteChar(osdGetDisplayPort(), hud_prev_drawn[i][0], hud_prev_drawn[i][1], SYM_BLANK);
         }
     }
-    hud_drawn_pt = 0;
+    hud_prev_drawn_count = 0;
 }
 
 /*
@@ -61,18 +96,22 @@ void osdHudClear(void)
  */
 static int osdHudWrite(uint8_t px, uint8_t py, uint16_t symb, bool crush)
 {
+    if (hud_drawn_count >= HUD_DRAWN_MAXCHARS) {
+        return false;
+    }
+
     if (!crush) {
         uint16_t c;
-        if (displayReadCharWithAttr(osdGetDisplayPort(), px, py, &c, NULL) && c != SYM_BLANK) {
+        // Characters left from the previous HUD frame don't block drawing
+        if (displayReadCharWithAttr(osdGetDisplayPort(), px, py, &c, NULL) && c != SYM_BLANK && !osdHudWasDrawn(px, py)) {
             return false;
         }
     }
 
     displayWriteChar(osdGetDisplayPort(), px, py, symb);
-    hud_drawn[hud_drawn_pt][0] = px;
-    hud_drawn[hud_drawn_pt][1] = py;
-    hud_drawn_pt++;
-    if (hud_drawn_pt >= HUD_DRAWN_MAXCHARS) hud_drawn_pt = 0;
+    hud_drawn[hud_drawn_count][0] = px;
+    hud_drawn[hud_drawn_count][1] = py;
+    hud_drawn_count++;
     return true;
 }
 
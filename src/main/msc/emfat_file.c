@@ -23,6 +23,7 @@
  */
 
 #include "platform.h"
+#include "common/maths.h"
 #include "common/utils.h"
 #include "common/printf.h"
 
@@ -476,6 +477,38 @@ static int emfat_find_log(emfat_entry_t *entry, int maxCount, int flashfsUsedSpa
 
     return logCount;
 }
+
+// Build the log entries from the flashfs log index, O(logs) instead of scanning the whole chip
+static int emfat_find_log_indexed(emfat_entry_t *entry, int maxCount, int flashfsUsedSpace)
+{
+    flashfsLogIndexEntry_t log;
+    flashfsLogIndexEntry_t next;
+    uint16_t cursor = 0;
+    int logCount = 0;
+
+    bool haveLog = flashfsLogIndexNext(&cursor, &log);
+
+    while (haveLog && logCount < maxCount) {
+        const bool haveNext = flashfsLogIndexNext(&cursor, &next);
+
+        // A log that was never closed runs up to the next one
+        uint32_t endOffset = log.endOffset;
+        if (endOffset <= log.startOffset) {
+            endOffset = haveNext ? next.startOffset : (uint32_t)flashfsUsedSpace;
+        }
+        endOffset = MIN(endOffset, (uint32_t)flashfsUsedSpace);
+
+        if (endOffset > log.startOffset) {
+            entry->cma_time[0] = log.startTime ? log.startTime : cmaTime;
+            emfat_add_log(entry++, logCount++, log.startOffset, endOffset - log.startOffset);
+        }
+
+        log = next;
+        haveLog = haveNext;
+    }
+
+    return logCount;
+}
 #endif  // USE_FLASHFS
 
 void emfat_init_files(void)
@@ -489,7 +522,14 @@ void emfat_init_files(void)
     flashfsUsedSpace = flashfsIdentifyStartOfFreeSpace();
 
     // Detect and create entries for each individual log
-    const int logCount = emfat_find_log(&entries[PREDEFINED_ENTRY_COUNT], EMFAT_MAX_LOG_ENTRY, flashfsUsedSpace);
+    int logCount = 0;
+    if (flashfsLogIndexIsValid()) {
+        logCount = emfat_find_log_indexed(&entries[PREDEFINED_ENTRY_COUNT], EMFAT_MAX_LOG_ENTRY, flashfsUsedSpace);
+    }
+    if (logCount == 0 && flashfsUsedSpace > 0) {
+        // No index, or data on the chip the index doesn't know about
+        logCount = emfat_find_log(&entries[PREDEFINED_ENTRY_COUNT], EMFAT_MAX_LOG_ENTRY, flashfsUsedSpace);
+    }
 
     entryIndex += logCount;
 
@@ -86,8 +86,13 @@
 
 #define MSP2_INAV_MISC2                         0x203A
 #define MSP2_INAV_LOGIC_CONDITIONS_SINGLE       0x203B
+#define MSP2_INAV_CRSF_TELEMETRY_STATS          0x203C
+#define MSP2_INAV_DATAFLASH_STREAM              0x203D
+#define MSP2_INAV_DATAFLASH_STREAM_DATA         0x203E
+#define MSP2_INAV_SYSTEM_ID                     0x203F
 
 #define MSP2_INAV_ESC_RPM                       0x2040
+#define MSP2_INAV_LOOP_PROFILE                  0x2041
 
 #define MSP2_INAV_LED_STRIP_CONFIG_EX           0x2048
 #define MSP2_INAV_SET_LED_STRIP_CONFIG_EX       0x2049
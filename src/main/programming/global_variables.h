@@ -26,7 +26,9 @@
 
 #include "config/parameter_group.h"
 
+#ifndef MAX_GLOBAL_VARIABLES
 #define MAX_GLOBAL_VARIABLES 8
+#endif
 
 typedef struct globalVariableConfig_s {
     int32_t min;
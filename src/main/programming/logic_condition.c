@@ -29,9 +29,12 @@
 #include "config/parameter_group_ids.h"
 
 #include "programming/logic_condition.h"
+#include "programming/logic_condition_order.h"
 #include "programming/global_variables.h"
 #include "programming/pid.h"
 #include "common/utils.h"
+#include "build/debug.h"
+#include "drivers/time.h"
 #include "rx/rx.h"
 #include "common/maths.h"
 #include "fc/config.h"
@@ -57,7 +60,14 @@
 #include "io/vtx.h"
 #include "drivers/vtx_common.h"
 
-PG_REGISTER_ARRAY_WITH_RESET_FN(logicCondition_t, MAX_LOGIC_CONDITIONS, logicConditions, PG_LOGIC_CONDITIONS, 4);
+PG_REGISTER_ARRAY_WITH_RESET_FN(logicCondition_t, MAX_LOGIC_CONDITIONS, logicConditions, PG_LOGIC_CONDITIONS, 5);
+
+// The programming framework limits grow the config image the most, leave at least half of the config storage
+// to everything else. A config image that does not fit cannot be saved.
+STATIC_ASSERT(sizeof(logicCondition_t) * MAX_LOGIC_CONDITIONS +
+              sizeof(globalVariableConfig_t) * MAX_GLOBAL_VARIABLES +
+              sizeof(programmingPid_t) * MAX_PROGRAMMING_PID_COUNT <= CONFIG_STORAGE_MIN_SIZE / 2,
+              programming_framework_config_too_large);
 
 EXTENDED_FASTRAM uint64_t logicConditionsGlobalFlags;
 EXTENDED_FASTRAM int logicConditionValuesByType[LOGIC_CONDITION_LAST];
@@ -86,6 +96,32 @@ void pgResetFn_logicConditions(logicCondition_t *instance)
 
 logicConditionState_t logicConditionStates[MAX_LOGIC_CONDITIONS];
 
+/*
+ * Enabled conditions compiled into evaluation order. Operands that can't change at runtime are
+ * folded into constants, so the per tick loop only touches conditions that actually do something.
+ */
+typedef struct logicConditionInstruction_s {
+    logicOperand_t operandA;
+    logicOperand_t operandB;
+    int16_t activatorId;
+    uint8_t operation;
+    uint8_t index;
+    uint8_t flags;
+} logicConditionInstruction_t;
+
+typedef struct logicConditionProgram_s {
+    logicConditionInstruction_t instructions[MAX_LOGIC_CONDITIONS];
+    uint8_t count;
+    uint8_t staleCount;             // Conditions in a dependency loop, they read last tick's values
+    uint64_t flightOperandMask;     // Flight operands sampled at the start of each tick
+} logicConditionProgram_t;
+
+STATIC_ASSERT(LOGIC_CONDITION_OPERAND_FLIGHT_LAST <= 64, flight_operand_mask_too_small);
+STATIC_ASSERT(MAX_LOGIC_CONDITIONS <= 255, logic_condition_index_does_not_fit_byte);
+
+static EXTENDED_FASTRAM logicConditionProgram_t logicConditionProgram;
+static EXTENDED_FASTRAM int logicConditionFlightOperandValues[LOGIC_CONDITION_OPERAND_FLIGHT_LAST];
+
 static int logicConditionCompute(
     int32_t currentValue,
     logicOperation_e operation,
@@ -481,33 +517,53 @@ static int logicConditionCompute(
     }
 }
 
-void logicConditionProcess(uint8_t i) {
+static int logicConditionGetCompiledOperandValue(const logicOperand_t *operand)
+{
+    switch (operand->type) {
+        case LOGIC_CONDITION_OPERAND_TYPE_VALUE:
+            return operand->value;
 
-    const int activatorValue = logicConditionGetValue(logicConditions(i)->activatorId);
+        case LOGIC_CONDITION_OPERAND_TYPE_FLIGHT:
+            if (logicConditionProgram.flightOperandMask & (1ULL << operand->value)) {
+                return logicConditionFlightOperandValues[operand->value];
+            }
+            return logicConditionGetOperandValue(operand->type, operand->value);
+
+        case LOGIC_CONDITION_OPERAND_TYPE_LC:
+            return logicConditionStates[operand->value].value;
+
+        default:
+            return logicConditionGetOperandValue(operand->type, operand->value);
+    }
+}
+
+static void logicConditionExecute(const logicConditionInstruction_t *instruction)
+{
+    const uint8_t i = instruction->index;
+
+    if (logicConditionGetValue(instruction->activatorId)) {
 
-    if (logicConditions(i)->enabled && activatorValue && !cliMode) {
-        
         /*
          * Process condition only when latch flag is not set
          * Latched LCs can only go from OFF to ON, not the other way
          */
         if (!(logicConditionStates[i].flags & LOGIC_CONDITION_FLAG_LATCH)) {
-            const int operandAValue = logicConditionGetOperandValue(logicConditions(i)->operandA.type, logicConditions(i)->operandA.value);
-            const int operandBValue = logicConditionGetOperandValue(logicConditions(i)->operandB.type, logicConditions(i)->operandB.value);
+            const int operandAValue = logicConditionGetCompiledOperandValue(&instruction->operandA);
+            const int operandBValue = logicConditionGetCompiledOperandValue(&instruction->operandB);
             const int newValue = logicConditionCompute(
-                logicConditionStates[i].value, 
-                logicConditions(i)->operation, 
-                operandAValue, 
+                logicConditionStates[i].value,
+                instruction->operation,
+                operandAValue,
                 operandBValue,
                 i
             );
-        
+
             logicConditionStates[i].value = newValue;
 
             /*
              * if value evaluates as true, put a latch on logic condition
              */
-            if (logicConditions(i)->flags & LOGIC_CONDITION_FLAG_LATCH && newValue) {
+            if (instruction->flags & LOGIC_CONDITION_FLAG_LATCH && newValue) {
                 logicConditionStates[i].flags |= LOGIC_CONDITION_FLAG_LATCH;
             }
         }
@@ -933,20 +989,120 @@ int logicConditionGetOperandValue(logicOperandType_e type, int operand) {
     return retVal;
 }
 
+/*
+ * Operands that depend on what the program itself does during the tick are read live
+ */
+static bool logicConditionIsFlightOperandLive(int operand)
+{
+    return operand == LOGIC_CONDITION_OPERAND_FLIGHT_LOITER_RADIUS ||
+        operand == LOGIC_CONDITION_OPERAND_FLIGHT_ACTIVE_PROFILE;
+}
+
+static void logicConditionCompileOperand(logicOperand_t *compiled, const logicOperand_t *operand)
+{
+    bool valid;
+
+    switch (operand->type) {
+        case LOGIC_CONDITION_OPERAND_TYPE_VALUE:
+            valid = true;
+            break;
+
+        case LOGIC_CONDITION_OPERAND_TYPE_RC_CHANNEL:
+            valid = operand->value >= 1 && operand->value <= MAX_SUPPORTED_RC_CHANNEL_COUNT;
+            break;
+
+        case LOGIC_CONDITION_OPERAND_TYPE_FLIGHT:
+            valid = operand->value >= 0 && operand->value < LOGIC_CONDITION_OPERAND_FLIGHT_LAST;
+            if (valid && !logicConditionIsFlightOperandLive(operand->value)) {
+                logicConditionProgram.flightOperandMask |= 1ULL << operand->value;
+            }
+            break;
+
+        case LOGIC_CONDITION_OPERAND_TYPE_LC:
+            valid = operand->value >= 0 && operand->value < MAX_LOGIC_CONDITIONS;
+            break;
+
+        case LOGIC_CONDITION_OPERAND_TYPE_GVAR:
+            valid = operand->value >= 0 && operand->value < MAX_GLOBAL_VARIABLES;
+            break;
+
+        case LOGIC_CONDITION_OPERAND_TYPE_PID:
+            valid = operand->value >= 0 && operand->value < MAX_PROGRAMMING_PID_COUNT;
+            break;
+
+        case LOGIC_CONDITION_OPERAND_TYPE_FLIGHT_MODE:
+        case LOGIC_CONDITION_OPERAND_TYPE_WAYPOINTS:
+            valid = true;
+            break;
+
+        default:
+            valid = false;
+            break;
+    }
+
+    if (valid) {
+        *compiled = *operand;
+    } else {
+        // Evaluates to 0 no matter what, same as logicConditionGetOperandValue()
+        compiled->type = LOGIC_CONDITION_OPERAND_TYPE_VALUE;
+        compiled->value = 0;
+    }
+}
+
+/*
+ * Rebuilds the evaluation program from logicConditions. Has to be called every time the
+ * configuration changes.
+ */
+void logicConditionCompile(void)
+{
+    uint8_t order[MAX_LOGIC_CONDITIONS];
+
+    logicConditionProgram.flightOperandMask = 0;
+    logicConditionProgram.count = logicConditionBuildEvaluationOrder(logicConditions(0), MAX_LOGIC_CONDITIONS, order, &logicConditionProgram.staleCount);
+
+    for (uint8_t i = 0; i < logicConditionProgram.count; i++) {
+        const logicCondition_t *condition = logicConditions(order[i]);
+        logicConditionInstruction_t *instruction = &logicConditionProgram.instructions[i];
+
+        instruction->index = order[i];
+        instruction->operation = condition->operation;
+        instruction->flags = condition->flags;
+        instruction->activatorId = condition->activatorId;
+        logicConditionCompileOperand(&instruction->operandA, &condition->operandA);
+        logicConditionCompileOperand(&instruction->operandB, &condition->operandB);
+    }
+
+    // Disabled conditions are not evaluated anymore, they just stay false
+    for (uint8_t i = 0; i < MAX_LOGIC_CONDITIONS; i++) {
+        if (!logicConditions(i)->enabled) {
+            logicConditionStates[i].value = 0;
+        }
+    }
+}
+
+static void logicConditionSnapshotFlightOperands(void)
+{
+    for (int i = 0; i < LOGIC_CONDITION_OPERAND_FLIGHT_LAST; i++) {
+        if (logicConditionProgram.flightOperandMask & (1ULL << i)) {
+            logicConditionFlightOperandValues[i] = logicConditionGetFlightOperandValue(i);
+        }
+    }
+}
+
 /*
  * conditionId == -1 is always evaluated as true
  */ 
-int logicConditionGetValue(int8_t conditionId) {
-    if (conditionId >= 0) {
+int logicConditionGetValue(int conditionId) {
+    if (conditionId < 0) {
+        return true;
+    } else if (conditionId < MAX_LOGIC_CONDITIONS) {
         return logicConditionStates[conditionId].value;
     } else {
-        return true;
+        return false;
     }
 }
 
 void logicConditionUpdateTask(timeUs_t currentTimeUs) {
-    UNUSED(currentTimeUs);
-
     //Disable all flags
     logicConditionsGlobalFlags = 0;
 
@@ -959,8 +1115,25 @@ void logicConditionUpdateTask(timeUs_t currentTimeUs) {
         flightAxisOverride[i].angleTargetActive = false;
     }
 
-    for (uint8_t i = 0; i < MAX_LOGIC_CONDITIONS; i++) {
-        logicConditionProcess(i);
+    if (cliMode) {
+        for (uint8_t i = 0; i < logicConditionProgram.count; i++) {
+            logicConditionStates[logicConditionProgram.instructions[i].index].value = false;
+        }
+    } else {
+        logicConditionSnapshotFlightOperands();
+        const timeUs_t snapshotDoneUs = micros();
+
+        for (uint8_t i = 0; i < logicConditionProgram.count; i++) {
+            logicConditionExecute(&logicConditionProgram.instructions[i]);
+        }
+
+        const timeUs_t evaluationDoneUs = micros();
+        DEBUG_SET(DEBUG_LOGIC_CONDITIONS, 0, logicConditionProgram.count);
+        DEBUG_SET(DEBUG_LOGIC_CONDITIONS, 1, logicConditionProgram.staleCount);
+        DEBUG_SET(DEBUG_LOGIC_CONDITIONS, 2, snapshotDoneUs - currentTimeUs);
+        DEBUG_SET(DEBUG_LOGIC_CONDITIONS, 3, evaluationDoneUs - snapshotDoneUs);
+        // Latency from the start of the task until all outputs are final
+        DEBUG_SET(DEBUG_LOGIC_CONDITIONS, 4, evaluationDoneUs - currentTimeUs);
     }
 
 #ifdef USE_I2C_IO_EXPANDER
@@ -26,7 +26,11 @@
 #include "config/parameter_group.h"
 #include "common/time.h"
 
+// Targets with enough flash and RAM raise this in target/common.h. Condition indexes are a single byte
+// in MSP with 0xFF meaning "no activator", so 255 is the upper bound.
+#ifndef MAX_LOGIC_CONDITIONS
 #define MAX_LOGIC_CONDITIONS 64
+#endif
 
 typedef enum {
     LOGIC_CONDITION_TRUE                        = 0,
@@ -138,6 +142,7 @@ typedef enum {
     LOGIC_CONDITION_OPERAND_FLIGHT_ACTIVE_MIXER_PROFILE, //int              // 38
     LOGIC_CONDITION_OPERAND_FLIGHT_MIXER_TRANSITION_ACTIVE, //0,1           // 39
     LOGIC_CONDITION_OPERAND_FLIGHT_ATTITUDE_YAW, // deg                     // 40
+    LOGIC_CONDITION_OPERAND_FLIGHT_LAST
 } logicFlightOperands_e;
 
 typedef enum {
@@ -195,19 +200,23 @@ typedef enum {
     LOGIC_CONDITION_FLAG_TIMEOUT_SATISFIED  = 1 << 1,
 } logicConditionFlags_e;
 
+/*
+ * Stored packed, a condition takes 15 bytes of config instead of 24 and a full program of a few
+ * hundred conditions still fits the config area
+ */
 typedef struct logicOperand_s {
     int32_t value;
-    logicOperandType_e type;
-} logicOperand_t;
+    uint8_t type;           // logicOperandType_e
+} PG_PACKED logicOperand_t;
 
 typedef struct logicCondition_s {
     logicOperand_t operandA;
     logicOperand_t operandB;
     uint8_t enabled;
-    int8_t activatorId;
-    logicOperation_e operation;
+    int16_t activatorId;
+    uint8_t operation;      // logicOperation_e
     uint8_t flags;
-} logicCondition_t;
+} PG_PACKED logicCondition_t;
 
 PG_DECLARE_ARRAY(logicCondition_t, MAX_LOGIC_CONDITIONS, logicConditions);
 
@@ -237,11 +246,11 @@ extern uint64_t logicConditionsGlobalFlags;
 #define LOGIC_CONDITION_GLOBAL_FLAG_ENABLE(mask) (logicConditionsGlobalFlags |= (mask))
 #define LOGIC_CONDITION_GLOBAL_FLAG(mask) (logicConditionsGlobalFlags & (mask))
 
-void logicConditionProcess(uint8_t i);
+void logicConditionCompile(void);
 
 int logicConditionGetOperandValue(logicOperandType_e type, int operand);
 
-int logicConditionGetValue(int8_t conditionId);
+int logicConditionGetValue(int conditionId);
 void logicConditionUpdateTask(timeUs_t currentTimeUs);
 void logicConditionReset(void);
 
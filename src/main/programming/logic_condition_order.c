@@ -0,0 +1,102 @@
+/*
+ * This file is part of INAV Project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU General Public License Version 3, as described below:
+ *
+ * This file is free software: you may copy, redistribute and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "programming/logic_condition_order.h"
+
+static bool logicConditionDependencyReady(const logicCondition_t *conditions, int count, const bool *placed, int self, int dependency)
+{
+    // Self references, disabled and out of range conditions don't constrain the order
+    if (dependency < 0 || dependency >= count || dependency == self || !conditions[dependency].enabled) {
+        return true;
+    }
+
+    return placed[dependency];
+}
+
+static int logicConditionOperandDependency(const logicOperand_t *operand)
+{
+    return operand->type == LOGIC_CONDITION_OPERAND_TYPE_LC ? operand->value : -1;
+}
+
+static bool logicConditionReady(const logicCondition_t *conditions, int count, const bool *placed, int i)
+{
+    return logicConditionDependencyReady(conditions, count, placed, i, conditions[i].activatorId) &&
+        logicConditionDependencyReady(conditions, count, placed, i, logicConditionOperandDependency(&conditions[i].operandA)) &&
+        logicConditionDependencyReady(conditions, count, placed, i, logicConditionOperandDependency(&conditions[i].operandB));
+}
+
+uint8_t logicConditionBuildEvaluationOrder(const logicCondition_t *conditions, int count, uint8_t *order, uint8_t *staleCount)
+{
+    bool placed[MAX_LOGIC_CONDITIONS];
+    uint8_t enabledCount = 0;
+    uint8_t placedCount = 0;
+
+    if (count > MAX_LOGIC_CONDITIONS) {
+        count = MAX_LOGIC_CONDITIONS;
+    }
+
+    memset(placed, 0, sizeof(placed));
+    *staleCount = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (conditions[i].enabled) {
+            enabledCount++;
+        }
+    }
+
+    while (placedCount < enabledCount) {
+        bool progress = false;
+
+        /*
+         * Scan in index order and place everything that is ready. A condition placed during the scan
+         * unblocks the ones after it in the same pass, so programs without forward references come out
+         * in plain index order after a single pass.
+         */
+        for (int i = 0; i < count; i++) {
+            if (conditions[i].enabled && !placed[i] && logicConditionReady(conditions, count, placed, i)) {
+                placed[i] = true;
+                order[placedCount++] = i;
+                progress = true;
+            }
+        }
+
+        if (!progress) {
+            // Dependency loop, break it at the lowest index. That condition sees last tick's values.
+            for (int i = 0; i < count; i++) {
+                if (conditions[i].enabled && !placed[i]) {
+                    placed[i] = true;
+                    order[placedCount++] = i;
+                    (*staleCount)++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return placedCount;
+}
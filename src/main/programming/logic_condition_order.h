@@ -0,0 +1,44 @@
+/*
+ * This file is part of INAV Project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU General Public License Version 3, as described below:
+ *
+ * This file is free software: you may copy, redistribute and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "programming/logic_condition.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Fills order[] with the indexes of the enabled conditions so that every condition comes after the
+ * conditions it reads (activator and LC operands). Conditions without forward references keep their
+ * index order. Returns the number of entries written, staleCount receives the number of conditions
+ * that still read a previous tick value because they are part of a dependency loop.
+ */
+uint8_t logicConditionBuildEvaluationOrder(const logicCondition_t *conditions, int count, uint8_t *order, uint8_t *staleCount);
+
+#ifdef __cplusplus
+}
+#endif
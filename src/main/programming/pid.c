@@ -38,7 +38,7 @@
 EXTENDED_FASTRAM programmingPidState_t programmingPidState[MAX_PROGRAMMING_PID_COUNT];
 static bool pidsInitiated = false;
 
-PG_REGISTER_ARRAY_WITH_RESET_FN(programmingPid_t, MAX_PROGRAMMING_PID_COUNT, programmingPids, PG_PROGRAMMING_PID, 2);
+PG_REGISTER_ARRAY_WITH_RESET_FN(programmingPid_t, MAX_PROGRAMMING_PID_COUNT, programmingPids, PG_PROGRAMMING_PID, 3);
 
 void pgResetFn_programmingPids(programmingPid_t *instance)
 {
@@ -110,7 +110,7 @@ void programmingPidInit(void)
 }
 
 int32_t programmingPidGetOutput(uint8_t i) {
-    return programmingPidState[constrain(i, 0, MAX_PROGRAMMING_PID_COUNT)].output;
+    return programmingPidState[constrain(i, 0, MAX_PROGRAMMING_PID_COUNT - 1)].output;
 }
 
 void programmingPidReset(void)
@@ -32,7 +32,9 @@
 #include "common/axis.h"
 #include "flight/pid.h"
 
+#ifndef MAX_PROGRAMMING_PID_COUNT
 #define MAX_PROGRAMMING_PID_COUNT 4
+#endif
 
 typedef struct programmingPid_s {
     logicOperand_t setpoint;
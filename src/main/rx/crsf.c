@@ -49,8 +49,24 @@
 #define CRSF_PAYLOAD_OFFSET offsetof(crsfFrameDef_t, type)
 #define CRSF_POWER_COUNT 9
 
-STATIC_UNIT_TESTED bool crsfFrameDone = false;
-STATIC_UNIT_TESTED crsfFrame_t crsfFrame;
+/*
+ * Newest complete frame of one type, handed from the ISR to the RX task without masking the ISR. The
+ * ISR writes into the buffer that doesn't hold the newest frame, then publishes it by bumping the
+ * sequence. The RX task copies the newest frame out and starts over if the sequence moved meanwhile.
+ */
+typedef struct crsfFrameSlot_s {
+    crsfFrame_t frame[2];
+    timeUs_t frameAt[2];
+    volatile uint8_t newest;
+    volatile uint8_t sequence;
+    uint8_t takenSequence;          // Owned by the RX task
+} crsfFrameSlot_t;
+
+STATIC_UNIT_TESTED crsfFrame_t crsfFrame;           // Frame being assembled by the ISR
+STATIC_UNIT_TESTED crsfFrameSlot_t crsfRcSlot;
+STATIC_UNIT_TESTED crsfFrameSlot_t crsfLinkStatisticsSlot;
+static timeUs_t crsfRcFrameAt = 0;
+static timeUs_t crsfRcFramePeriodUs = 0;  // Filtered spacing of the RC frames, 0 until measured
 
 STATIC_UNIT_TESTED uint32_t crsfChannelData[CRSF_MAX_CHANNEL];
 
@@ -125,12 +141,12 @@ typedef struct crsfPayloadLinkStatistics_s {
 
 typedef struct crsfPayloadLinkStatistics_s crsfPayloadLinkStatistics_t;
 
-STATIC_UNIT_TESTED uint8_t crsfFrameCRC(void)
+STATIC_UNIT_TESTED uint8_t crsfFrameCRC(const crsfFrame_t *frame)
 {
     // CRC includes type and payload
-    uint8_t crc = crc8_dvb_s2(0, crsfFrame.frame.type);
-    for (int ii = 0; ii < crsfFrame.frame.frameLength - CRSF_FRAME_LENGTH_TYPE_CRC; ++ii) {
-        crc = crc8_dvb_s2(crc, crsfFrame.frame.payload[ii]);
+    uint8_t crc = crc8_dvb_s2(0, frame->frame.type);
+    for (int ii = 0; ii < frame->frame.frameLength - CRSF_FRAME_LENGTH_TYPE_CRC; ++ii) {
+        crc = crc8_dvb_s2(crc, frame->frame.payload[ii]);
     }
     return crc;
 }
@@ -162,11 +178,20 @@ STATIC_UNIT_TESTED void crsfDataReceive(uint16_t c, void *rxCallbackData)
 
     if (crsfFramePosition < fullFrameLength) {
         crsfFrame.bytes[crsfFramePosition++] = (uint8_t)c;
-        crsfFrameDone = crsfFramePosition < fullFrameLength ? false : true;
-        if (crsfFrameDone) {
+        if (crsfFramePosition >= fullFrameLength) {
             crsfFramePosition = 0;
-            if (crsfFrame.frame.type != CRSF_FRAMETYPE_RC_CHANNELS_PACKED) {
-                const uint8_t crc = crsfFrameCRC();
+            if (crsfFrame.frame.type == CRSF_FRAMETYPE_RC_CHANNELS_PACKED || crsfFrame.frame.type == CRSF_FRAMETYPE_LINK_STATISTICS) {
+                // Hand the frame over to the RX task, it's validated and decoded there. A frame
+                // that wasn't picked up yet is replaced, the RX task only wants the newest one.
+                crsfFrameSlot_t *slot = crsfFrame.frame.type == CRSF_FRAMETYPE_RC_CHANNELS_PACKED ? &crsfRcSlot : &crsfLinkStatisticsSlot;
+                const uint8_t next = slot->newest ^ 1;
+                memcpy(&slot->frame[next], &crsfFrame, MIN(fullFrameLength, (int)sizeof(crsfFrame)));
+                slot->frameAt[next] = now;
+                __atomic_thread_fence(__ATOMIC_RELEASE);
+                slot->newest = next;
+                slot->sequence++;
+            } else {
+                const uint8_t crc = crsfFrameCRC(&crsfFrame);
                 if (crc == crsfFrame.bytes[fullFrameLength - 1]) {
                     switch (crsfFrame.frame.type)
                     {
@@ -189,78 +214,138 @@ STATIC_UNIT_TESTED void crsfDataReceive(uint16_t c, void *rxCallbackData)
     }
 }
 
-STATIC_UNIT_TESTED uint8_t crsfFrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
+// Gaps longer than this are link loss, not a packet rate
+#define CRSF_RC_FRAME_PERIOD_MAX_US     500000
+
+static void crsfUpdateRcFramePeriod(timeUs_t frameAt)
 {
-    UNUSED(rxRuntimeConfig);
+    const timeDelta_t periodUs = cmpTimeUs(frameAt, crsfRcFrameAt);
 
-    if (crsfFrameDone) {
-        crsfFrameDone = false;
-        if (crsfFrame.frame.type == CRSF_FRAMETYPE_RC_CHANNELS_PACKED) {
-            // CRC includes type and payload of each frame
-            const uint8_t crc = crsfFrameCRC();
-            if (crc != crsfFrame.frame.payload[CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE]) {
-                return RX_FRAME_PENDING;
-            }
-            crsfFrame.frame.frameLength = CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC;
-
-            // unpack the RC channels
-            const crsfPayloadRcChannelsPacked_t* rcChannels = (crsfPayloadRcChannelsPacked_t*)&crsfFrame.frame.payload;
-            crsfChannelData[0] = rcChannels->chan0;
-            crsfChannelData[1] = rcChannels->chan1;
-            crsfChannelData[2] = rcChannels->chan2;
-            crsfChannelData[3] = rcChannels->chan3;
-            crsfChannelData[4] = rcChannels->chan4;
-            crsfChannelData[5] = rcChannels->chan5;
-            crsfChannelData[6] = rcChannels->chan6;
-            crsfChannelData[7] = rcChannels->chan7;
-            crsfChannelData[8] = rcChannels->chan8;
-            crsfChannelData[9] = rcChannels->chan9;
-            crsfChannelData[10] = rcChannels->chan10;
-            crsfChannelData[11] = rcChannels->chan11;
-            crsfChannelData[12] = rcChannels->chan12;
-            crsfChannelData[13] = rcChannels->chan13;
-            crsfChannelData[14] = rcChannels->chan14;
-            crsfChannelData[15] = rcChannels->chan15;
-            return RX_FRAME_COMPLETE;
+    if (crsfRcFrameAt == 0 || periodUs <= 0 || periodUs > CRSF_RC_FRAME_PERIOD_MAX_US) {
+        return;
+    }
+
+    if (crsfRcFramePeriodUs == 0) {
+        crsfRcFramePeriodUs = periodUs;
+    } else {
+        crsfRcFramePeriodUs += (periodUs - (timeDelta_t)crsfRcFramePeriodUs) / 8;
+    }
+}
+
+// Copies the newest frame out of a slot if there is one the RX task hasn't seen yet
+static bool crsfTakeFrame(crsfFrameSlot_t *slot, crsfFrame_t *frame, timeUs_t *frameAt)
+{
+    // The ISR completes at most one frame while a copy is made, a few attempts are plenty
+    for (int attempt = 0; attempt < 3; attempt++) {
+        const uint8_t sequence = slot->sequence;
+        if (sequence == slot->takenSequence) {
+            return false;
         }
-        else if (crsfFrame.frame.type == CRSF_FRAMETYPE_LINK_STATISTICS) {
-            // CRC includes type and payload of each frame
-            const uint8_t crc = crsfFrameCRC();
-            if (crc != crsfFrame.frame.payload[CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE]) {
-                return RX_FRAME_PENDING;
-            }
-            crsfFrame.frame.frameLength = CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC;
 
-            const crsfPayloadLinkStatistics_t* linkStats = (crsfPayloadLinkStatistics_t*)&crsfFrame.frame.payload;
-            const uint8_t crsftxpowerindex = (linkStats->uplinkTXPower < CRSF_POWER_COUNT) ? linkStats->uplinkTXPower : 0;
+        const uint8_t newest = slot->newest;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        memcpy(frame, &slot->frame[newest], sizeof(*frame));
+        *frameAt = slot->frameAt[newest];
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (slot->sequence == sequence) {
+            slot->takenSequence = sequence;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool crsfDecodeRcFrame(const crsfFrame_t *frame, timeUs_t frameAt)
+{
+    // CRC includes type and payload of each frame
+    const uint8_t crc = crsfFrameCRC(frame);
+    if (crc != frame->frame.payload[CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE]) {
+        return false;
+    }
+    crsfUpdateRcFramePeriod(frameAt);
+    crsfRcFrameAt = frameAt;
+
+    // unpack the RC channels
+    const crsfPayloadRcChannelsPacked_t* rcChannels = (const crsfPayloadRcChannelsPacked_t*)&frame->frame.payload;
+    crsfChannelData[0] = rcChannels->chan0;
+    crsfChannelData[1] = rcChannels->chan1;
+    crsfChannelData[2] = rcChannels->chan2;
+    crsfChannelData[3] = rcChannels->chan3;
+    crsfChannelData[4] = rcChannels->chan4;
+    crsfChannelData[5] = rcChannels->chan5;
+    crsfChannelData[6] = rcChannels->chan6;
+    crsfChannelData[7] = rcChannels->chan7;
+    crsfChannelData[8] = rcChannels->chan8;
+    crsfChannelData[9] = rcChannels->chan9;
+    crsfChannelData[10] = rcChannels->chan10;
+    crsfChannelData[11] = rcChannels->chan11;
+    crsfChannelData[12] = rcChannels->chan12;
+    crsfChannelData[13] = rcChannels->chan13;
+    crsfChannelData[14] = rcChannels->chan14;
+    crsfChannelData[15] = rcChannels->chan15;
+    return true;
+}
+
+static void crsfDecodeLinkStatistics(const crsfFrame_t *frame, rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    UNUSED(rxRuntimeConfig);
+
+    // CRC includes type and payload of each frame
+    const uint8_t crc = crsfFrameCRC(frame);
+    if (crc != frame->frame.payload[CRSF_FRAME_LINK_STATISTICS_PAYLOAD_SIZE]) {
+        return;
+    }
+
+    const crsfPayloadLinkStatistics_t* linkStats = (const crsfPayloadLinkStatistics_t*)&frame->frame.payload;
+    const uint8_t crsftxpowerindex = (linkStats->uplinkTXPower < CRSF_POWER_COUNT) ? linkStats->uplinkTXPower : 0;
 
-            rxLinkStatistics.uplinkRSSI = -1* (linkStats->activeAntenna ? linkStats->uplinkRSSIAnt2 : linkStats->uplinkRSSIAnt1);
-            rxLinkStatistics.uplinkLQ = linkStats->uplinkLQ;
-            rxLinkStatistics.uplinkSNR = linkStats->uplinkSNR;
-            rxLinkStatistics.rfMode = linkStats->rfMode;
-            rxLinkStatistics.uplinkTXPower = crsfTxPowerStatesmW[crsftxpowerindex];
-            rxLinkStatistics.activeAntenna = linkStats->activeAntenna;
+    rxLinkStatistics.uplinkRSSI = -1* (linkStats->activeAntenna ? linkStats->uplinkRSSIAnt2 : linkStats->uplinkRSSIAnt1);
+    rxLinkStatistics.uplinkLQ = linkStats->uplinkLQ;
+    rxLinkStatistics.uplinkSNR = linkStats->uplinkSNR;
+    rxLinkStatistics.rfMode = linkStats->rfMode;
+    rxLinkStatistics.uplinkTXPower = crsfTxPowerStatesmW[crsftxpowerindex];
+    rxLinkStatistics.activeAntenna = linkStats->activeAntenna;
 
 #ifdef USE_OSD
-            if (rxLinkStatistics.uplinkLQ > 0) {
-                int16_t uplinkStrength;   // RSSI dBm converted to %
-                uplinkStrength = constrain((100 * sq((osdConfig()->rssi_dbm_max - osdConfig()->rssi_dbm_min)) - (100 * sq((osdConfig()->rssi_dbm_max  - rxLinkStatistics.uplinkRSSI)))) / sq((osdConfig()->rssi_dbm_max - osdConfig()->rssi_dbm_min)),0,100);
-                if (rxLinkStatistics.uplinkRSSI >= osdConfig()->rssi_dbm_max )
-                    uplinkStrength = 99;
-                else if (rxLinkStatistics.uplinkRSSI < osdConfig()->rssi_dbm_min)
-                    uplinkStrength = 0;
-                lqTrackerSet(rxRuntimeConfig->lqTracker, scaleRange(uplinkStrength, 0, 99, 0, RSSI_MAX_VALUE));
-            } else {
-                lqTrackerSet(rxRuntimeConfig->lqTracker, 0);
-            }
+    if (rxLinkStatistics.uplinkLQ > 0) {
+        int16_t uplinkStrength;   // RSSI dBm converted to %
+        uplinkStrength = constrain((100 * sq((osdConfig()->rssi_dbm_max - osdConfig()->rssi_dbm_min)) - (100 * sq((osdConfig()->rssi_dbm_max  - rxLinkStatistics.uplinkRSSI)))) / sq((osdConfig()->rssi_dbm_max - osdConfig()->rssi_dbm_min)),0,100);
+        if (rxLinkStatistics.uplinkRSSI >= osdConfig()->rssi_dbm_max )
+            uplinkStrength = 99;
+        else if (rxLinkStatistics.uplinkRSSI < osdConfig()->rssi_dbm_min)
+            uplinkStrength = 0;
+        lqTrackerSet(rxRuntimeConfig->lqTracker, scaleRange(uplinkStrength, 0, 99, 0, RSSI_MAX_VALUE));
+    } else {
+        lqTrackerSet(rxRuntimeConfig->lqTracker, 0);
+    }
 #endif
-            // This is not RC channels frame, update channel value but don't indicate frame completion
-            return RX_FRAME_PENDING;
-        }
+}
+
+STATIC_UNIT_TESTED uint8_t crsfFrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    crsfFrame_t frame;
+    timeUs_t frameAt;
+
+    if (crsfTakeFrame(&crsfLinkStatisticsSlot, &frame, &frameAt)) {
+        // Updates the link statistics but isn't a new set of channels
+        crsfDecodeLinkStatistics(&frame, rxRuntimeConfig);
     }
+
+    if (crsfTakeFrame(&crsfRcSlot, &frame, &frameAt) && crsfDecodeRcFrame(&frame, frameAt)) {
+        return RX_FRAME_COMPLETE;
+    }
+
     return RX_FRAME_PENDING;
 }
 
+static timeUs_t crsfFrameTimeUs(const rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    UNUSED(rxRuntimeConfig);
+    return crsfRcFrameAt;
+}
+
 STATIC_UNIT_TESTED uint16_t crsfReadRawRC(const rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan)
 {
     UNUSED(rxRuntimeConfig);
@@ -282,6 +367,16 @@ void crsfRxWriteTelemetryData(const void *data, int len)
     telemetryBufLen = len;
 }
 
+timeUs_t crsfRxGetFramePeriodUs(void)
+{
+    return crsfRcFramePeriodUs;
+}
+
+bool crsfRxIsTelemetryBufEmpty(void)
+{
+    return telemetryBufLen == 0;
+}
+
 void crsfRxSendTelemetryData(void)
 {
     // if there is telemetry data to write
@@ -309,6 +404,7 @@ bool crsfRxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig)
     rxRuntimeConfig->channelCount = CRSF_MAX_CHANNEL;
     rxRuntimeConfig->rcReadRawFn = crsfReadRawRC;
     rxRuntimeConfig->rcFrameStatusFn = crsfFrameStatus;
+    rxRuntimeConfig->rcFrameTimeUsFn = crsfFrameTimeUs;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "common/time.h"
+
 #define CRSF_BAUDRATE           420000
 #define CRSF_PORT_OPTIONS       (SERIAL_STOPBITS_1 | SERIAL_PARITY_NO)
 #define CRSF_PORT_MODE          MODE_RXTX
@@ -119,6 +121,8 @@ typedef union crsfFrame_u {
 
 void crsfRxWriteTelemetryData(const void *data, int len);
 void crsfRxSendTelemetryData(void);
+bool crsfRxIsTelemetryBufEmpty(void);
+timeUs_t crsfRxGetFramePeriodUs(void);
 
 struct rxConfig_s;
 struct rxRuntimeConfig_s;
@@ -158,6 +158,7 @@ typedef struct {
 typedef struct fportBuffer_s {
     uint8_t data[sizeof(fportFrame_t)+1]; // +1 for CRC
     uint8_t length;
+    timeUs_t frameEndUs;
 } fportBuffer_t;
 
 typedef struct {
@@ -195,6 +196,7 @@ static timeUs_t readyToUpdateFirmwareTimestamp = 0;
 #endif
 
 static volatile uint16_t frameErrors = 0;
+static timeUs_t rcFrameTimeUs = 0;
 
 static void reportFrameError(uint8_t errorReason) {
     UNUSED(errorReason);
@@ -271,6 +273,7 @@ static void fportDataReceive(uint16_t byte, void *callback_data)
 
         case FS_CONTROL_FRAME_DATA: {
             if (writeBuffer(byte) > controlFrameSize) {
+                rxBuffer[rxBufferWriteIndex].frameEndUs = currentTimeUs;
                 nextWriteBuffer();
                 state = FS_DOWNLINK_FRAME_START;
             }
@@ -329,6 +332,12 @@ static void writeUplinkFrame(const smartPortPayload_t *payload)
 }
 #endif
 
+static timeUs_t frameTimeUs(const rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    UNUSED(rxRuntimeConfig);
+    return rcFrameTimeUs;
+}
+
 static uint8_t frameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
 {
 #ifdef USE_TELEMETRY_SMARTPORT
@@ -361,6 +370,7 @@ static uint8_t frameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
 
                         case CFT_RC:
                             result = sbusChannelsDecode(rxRuntimeConfig, &frame->control.rc.channels);
+                            rcFrameTimeUs = rxBuffer[rxBufferReadIndex].frameEndUs;
                             lqTrackerSet(rxRuntimeConfig->lqTracker, scaleRange(frame->control.rc.rssi, 0, 100, 0, RSSI_MAX_VALUE));
                             frameReceivedTimestamp = currentTimeUs;
 #if defined(USE_TELEMETRY_SMARTPORT)
@@ -639,6 +649,7 @@ bool fport2RxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig
     rxRuntimeConfig->channelCount = SBUS_MAX_CHANNEL;
     rxRuntimeConfig->rcFrameStatusFn = frameStatus;
     rxRuntimeConfig->rcProcessFrameFn = processFrame;
+    rxRuntimeConfig->rcFrameTimeUsFn = frameTimeUs;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
@@ -83,6 +83,7 @@ typedef struct ghstFailsafeTracker_s {
 static serialPort_t *serialPort;
 static timeUs_t ghstRxFrameStartAtUs = 0;
 static timeUs_t ghstRxFrameEndAtUs = 0;
+static timeUs_t ghstRcFrameAtUs = 0;
 static uint8_t telemetryBuf[GHST_FRAME_SIZE_MAX];
 static uint8_t telemetryBufLen = 0;
 static ghstFailsafeTracker_t ghstFsTracker[GHST_UL_RC_CHANS_FRAME_COUNT];
@@ -237,6 +238,12 @@ static bool ghstDetectFailsafe(void)
     return false;
 }
 
+static timeUs_t ghstFrameTimeUs(const rxRuntimeConfig_t *rxRuntimeState)
+{
+    UNUSED(rxRuntimeState);
+    return ghstRcFrameAtUs;
+}
+
 uint8_t ghstFrameStatus(rxRuntimeConfig_t *rxRuntimeState)
 {
     UNUSED(rxRuntimeState);
@@ -254,6 +261,7 @@ uint8_t ghstFrameStatus(rxRuntimeConfig_t *rxRuntimeState)
         const int fullFrameLength = ghstValidatedFrame.frame.len + GHST_FRAME_LENGTH_ADDRESS + GHST_FRAME_LENGTH_FRAMELENGTH;
         if (crc == ghstValidatedFrame.bytes[fullFrameLength - 1] && ghstValidatedFrame.frame.addr == GHST_ADDR_FC) {
             ghstValidatedFrameAvailable = true;
+            ghstRcFrameAtUs = ghstRxFrameEndAtUs;
             return ghstFailsafeFlag | RX_FRAME_COMPLETE | RX_FRAME_PROCESSING_REQUIRED;            // request callback through ghstProcessFrame to do the decoding  work
         }
 
@@ -349,6 +357,7 @@ bool ghstRxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeState)
     rxRuntimeState->channelCount = GHST_MAX_NUM_CHANNELS;
     rxRuntimeState->rcReadRawFn = ghstReadRawRC;
     rxRuntimeState->rcFrameStatusFn = ghstFrameStatus;
+    rxRuntimeState->rcFrameTimeUsFn = ghstFrameTimeUs;
     rxRuntimeState->rcProcessFrameFn = ghstProcessFrame;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
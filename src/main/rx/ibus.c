@@ -65,6 +65,8 @@ static uint8_t rxBytesToIgnore;
 static uint16_t ibusChecksum;
 
 static bool ibusFrameDone = false;
+static timeUs_t ibusFrameEndAt = 0;
+static timeUs_t ibusRcFrameAt = 0;
 static uint32_t ibusChannelData[IBUS_MAX_CHANNEL];
 
 static uint8_t ibus[IBUS_BUFFSIZE] = { 0, };
@@ -118,6 +120,7 @@ static void ibusDataReceive(uint16_t c, void *rxCallbackData)
     ibus[ibusFramePosition] = (uint8_t)c;
 
     if (ibusFramePosition == ibusFrameSize - 1) {
+        ibusFrameEndAt = ibusTime;
         ibusFrameDone = true;
     } else {
         ibusFramePosition++;
@@ -192,6 +195,7 @@ static uint8_t ibusFrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
     if (checksumIsOk()) {
         if (ibusModel == IBUS_MODEL_IA6 || ibusSyncByte == 0x20) {
             updateChannelData();
+            ibusRcFrameAt = ibusFrameEndAt;
             frameStatus = RX_FRAME_COMPLETE;
         }
         else
@@ -205,6 +209,12 @@ static uint8_t ibusFrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
     return frameStatus;
 }
 
+static timeUs_t ibusFrameTimeUs(const rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    UNUSED(rxRuntimeConfig);
+    return ibusRcFrameAt;
+}
+
 static uint16_t ibusReadRawRC(const rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan)
 {
     UNUSED(rxRuntimeConfig);
@@ -220,6 +230,7 @@ bool ibusInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig)
     rxRuntimeConfig->channelCount = IBUS_MAX_CHANNEL;
     rxRuntimeConfig->rcReadRawFn = ibusReadRawRC;
     rxRuntimeConfig->rcFrameStatusFn = ibusFrameStatus;
+    rxRuntimeConfig->rcFrameTimeUsFn = ibusFrameTimeUs;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
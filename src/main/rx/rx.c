@@ -97,6 +97,8 @@ static rcChannel_t rcChannels[MAX_SUPPORTED_RC_CHANNEL_COUNT];
 rxLinkStatistics_t rxLinkStatistics;
 rxRuntimeConfig_t rxRuntimeConfig;
 static uint8_t rcSampleIndex = 0;
+static timeUs_t rxFrameTimeUs = 0;
+static bool rxFrameNew = false;
 
 PG_REGISTER_WITH_RESET_TEMPLATE(rxConfig_t, rxConfig, PG_RX_CONFIG, 12);
 
@@ -412,6 +414,12 @@ bool rxUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
         rxSignalReceived = (frameStatus & RX_FRAME_FAILSAFE) == 0;
         needRxSignalBefore = currentTimeUs + rxRuntimeConfig.rxSignalTimeout;
         rxDataProcessingRequired = true;
+
+        const timeUs_t frameTimeUs = rxRuntimeConfig.rcFrameTimeUsFn ? rxRuntimeConfig.rcFrameTimeUsFn(&rxRuntimeConfig) : currentTimeUs;
+        DEBUG_SET(DEBUG_RX_LATENCY, 0, cmpTimeUs(frameTimeUs, rxFrameTimeUs));
+        DEBUG_SET(DEBUG_RX_LATENCY, 1, cmpTimeUs(currentTimeUs, frameTimeUs));
+        rxFrameTimeUs = frameTimeUs;
+        rxFrameNew = true;
     }
     else if ((frameStatus & RX_FRAME_FAILSAFE) && rxSignalReceived) {
         // All other receiver statuses are allowed to report failsafe, but not allowed to leave it
@@ -497,6 +505,11 @@ bool calculateRxChannelsAndUpdateFailsafe(timeUs_t currentTimeUs)
         rcStaging[channel] = sample;
     }
 
+    if (rxFrameNew) {
+        DEBUG_SET(DEBUG_RX_LATENCY, 2, cmpTimeUs(micros(), rxFrameTimeUs));
+        rxFrameNew = false;
+    }
+
     // Update channel input value if receiver is not in failsafe mode
     // If receiver is in failsafe (not receiving signal or sending invalid channel values) - last good input values are retained
     if (rxFlightChannelsValid && rxSignalReceived) {
@@ -522,6 +535,12 @@ bool calculateRxChannelsAndUpdateFailsafe(timeUs_t currentTimeUs)
     return true;
 }
 
+// Time the latest RC frame was received, as close to its last byte as the driver can tell
+timeUs_t rxGetFrameTimeUs(void)
+{
+    return rxFrameTimeUs;
+}
+
 void parseRcChannels(const char *input)
 {
     for (const char *c = input; *c; c++) {
@@ -61,6 +61,8 @@ typedef struct sbusFrameData_s {
     sbusDecoderState_e state;
     volatile sbusFrame_t frame;
     volatile bool frameDone;
+    volatile timeUs_t frameTimeUs;  // Last byte of the frame waiting in 'frame'
+    timeUs_t rcFrameTimeUs;         // Last byte of the latest decoded frame
     uint8_t buffer[SBUS_FRAME_SIZE];
     uint8_t position;
     timeUs_t lastActivityTimeUs;
@@ -115,6 +117,7 @@ static void sbusDataReceive(uint16_t c, void *data)
                 if (!sbusFrameData->frameDone && frameValid) {
 
                     memcpy((void *)&sbusFrameData->frame, (void *)&sbusFrameData->buffer[0], SBUS_FRAME_SIZE);
+                    sbusFrameData->frameTimeUs = currentTimeUs;
                     sbusFrameData->frameDone = true;
                 }
             }
@@ -137,6 +140,7 @@ static uint8_t sbusFrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
 
     // Decode channel data and store return value
     const uint8_t retValue = sbusChannelsDecode(rxRuntimeConfig, (void *)&sbusFrameData->frame.channels);
+    sbusFrameData->rcFrameTimeUs = sbusFrameData->frameTimeUs;
 
     // Reset the frameDone flag - tell ISR that we're ready to receive next frame
     sbusFrameData->frameDone = false;
@@ -149,6 +153,12 @@ static uint8_t sbusFrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
     return retValue;
 }
 
+static timeUs_t sbusFrameTimeUs(const rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    const sbusFrameData_t *sbusFrameData = rxRuntimeConfig->frameData;
+    return sbusFrameData->rcFrameTimeUs;
+}
+
 static bool sbusInitEx(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, uint32_t sbusBaudRate)
 {
     static uint16_t sbusChannelData[SBUS_MAX_CHANNEL];
@@ -162,6 +172,7 @@ static bool sbusInitEx(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeC
     rxRuntimeConfig->channelCount = SBUS_MAX_CHANNEL;
 
     rxRuntimeConfig->rcFrameStatusFn = sbusFrameStatus;
+    rxRuntimeConfig->rcFrameTimeUsFn = sbusFrameTimeUs;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
@@ -118,6 +118,9 @@ typedef enum {
 #endif
 #ifdef USE_IRLOCK
     TASK_IRLOCK,
+#endif
+#ifdef USE_FLASHFS
+    TASK_FLASHFS,
 #endif
     /* Count of real tasks */
     TASK_COUNT,
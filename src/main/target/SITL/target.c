@@ -22,6 +22,8 @@
  * along with this program. If not, see http://www.gnu.org/licenses/.
  */
 
+#define _GNU_SOURCE
+
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -32,6 +34,7 @@
 #include <getopt.h>
 #include <errno.h>
 #include <time.h>
+#include <sched.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <sys/types.h>
@@ -64,6 +67,7 @@ char _estack = 0 ;
 char _Min_Stack_Size = 0;
 
 static pthread_mutex_t mainLoopLock;
+static int mainCpu = -1;
 static SitlSim_e sitlSim = SITL_SIM_NONE;
 static struct timespec start_time;
 static uint8_t pwmMapping[MAX_MOTORS + MAX_SERVOS];
@@ -78,6 +82,19 @@ static void printVersion(void) {
     fprintf(stderr, "INAV %d.%d.%d SITL (%s)\n", FC_VERSION_MAJOR, FC_VERSION_MINOR, FC_VERSION_PATCH_LEVEL, shortGitRevision);
 }
 
+static bool pinMainThread(int cpu)
+{
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+    UNUSED(cpu);
+    return false;
+#endif
+}
+
 void systemInit(void) {
     printVersion();
     clock_gettime(CLOCK_MONOTONIC, &start_time);
@@ -98,6 +115,10 @@ void systemInit(void) {
         exit(1);
     }
 
+    if (mainCpu >= 0 && !pinMainThread(mainCpu)) {
+        fprintf(stderr, "[SYSTEM] Unable to pin the main thread to CPU %d.\n", mainCpu);
+    }
+
     if (sitlSim != SITL_SIM_NONE) {
         fprintf(stderr, "[SIM] Waiting for connection...\n");
     }
@@ -179,6 +200,7 @@ void printCmdLineOptions(void)
     fprintf(stderr, "--simip=[ip]                         IP-Address oft the simulator host. If not specified localhost (127.0.0.1) is used.\n");
     fprintf(stderr, "--simport=[port]                     Port oft the simulator host.\n");
     fprintf(stderr, "--useimu                             Use IMU sensor data from the simulator instead of using attitude data from the simulator directly (experimental, not recommended).\n");
+    fprintf(stderr, "--cpu=[n]                            Pin the main thread with the scheduler and the flight loop to CPU n.\n");
     fprintf(stderr, "--chanmap=[mapstring]                Channel mapping. Maps INAVs motor and servo PWM outputs to the virtual receiver output in the simulator.\n");
     fprintf(stderr, "                                     The mapstring has the following format: M(otor)|S(servo)<INAV-OUT>-<RECEIVER-OUT>,... All numbers must have two digits\n");
     fprintf(stderr, "                                     For example: Map motor 1 to virtal receiver output 1, servo 1 to output 2 and servo 2 to output 3:\n");
@@ -202,6 +224,7 @@ void parseArguments(int argc, char *argv[])
             {"simport", required_argument, 0, 'p'},
             {"help", no_argument, 0, 'h'},
             {"path", required_argument, 0, 'e'},
+            {"cpu", required_argument, 0, 'f'},
 	    {"version", no_argument, 0, 'v'},
             {NULL, 0, NULL, 0}
         };
@@ -237,6 +260,9 @@ void parseArguments(int argc, char *argv[])
             case 'i':
                 simIp = optarg;
                 break;
+            case 'f':
+                mainCpu = atoi(optarg);
+                break;
             case 'e':
                 if (!configFileSetPath(optarg)){
                     fprintf(stderr, "[EEPROM] Invalid path, using eeprom file in program directory\n.");
@@ -280,6 +306,17 @@ uint64_t microsISR(void)
     return micros();
 }
 
+// No cycle counter to read, ticks are nanoseconds
+uint32_t usTicks = 1000;
+
+uint32_t ticks(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000 + now.tv_nsec);
+}
+
 uint32_t millis(void) {
     return (uint32_t)(micros() / 1000);
 }
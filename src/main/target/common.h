@@ -193,4 +193,14 @@
 #define MAX_MIXER_PROFILE_COUNT 1
 #endif
 
-#define USE_EZ_TUNE
\ No newline at end of file
+// Larger asyncfatfs cache to ride out SD card busy periods, costs 512 bytes of RAM per sector
+#if defined(STM32F7) || defined(STM32H7)
+#define AFATFS_NUM_CACHE_SECTORS    32
+#endif
+
+#define USE_EZ_TUNE
+
+#if (MCU_FLASH_SIZE > 512) || defined(SITL_BUILD)
+#define USE_SYSTEM_IDENTIFICATION
+#define USE_GAIN_SCHEDULE
+#endif
@@ -48,7 +48,12 @@ extern uint8_t __config_end;
 #define USE_BARO_MSP
 #endif
 
-#ifdef USE_ESC_SENSOR
+// Bidirectional DShot needs input capture on the motor pins, implemented for the F4 timer driver with a DMA stream per channel
+#if defined(USE_DSHOT) && defined(STM32F4) && !defined(USE_DSHOT_DMAR)
+#define USE_DSHOT_TELEMETRY
+#endif
+
+#if defined(USE_ESC_SENSOR) || defined(USE_DSHOT_TELEMETRY)
     #define USE_RPM_FILTER
 #endif
 
@@ -78,3 +83,19 @@ extern uint8_t eepromData[EEPROM_SIZE];
 extern uint8_t __config_start;   // configured via linker script when building binaries.
 extern uint8_t __config_end;
 #endif
+
+// Smallest config storage the target can have. In MCU flash it is the FLASH_CONFIG region of the
+// linker script, which is at least 16kB on every MCU.
+#if defined(CONFIG_IN_FLASH)
+#define CONFIG_STORAGE_MIN_SIZE     (16 * 1024)
+#else
+#define CONFIG_STORAGE_MIN_SIZE     EEPROM_SIZE
+#endif
+
+// Programming framework limits, smaller MCUs and targets with less config storage keep the defaults
+// from programming/. The raised limits make the config image larger than the default 8kB EEPROM_SIZE.
+#if ((MCU_FLASH_SIZE > 512) || defined(SITL_BUILD)) && (CONFIG_STORAGE_MIN_SIZE >= 16 * 1024)
+#define MAX_LOGIC_CONDITIONS        255
+#define MAX_GLOBAL_VARIABLES        16
+#define MAX_PROGRAMMING_PID_COUNT   8
+#endif
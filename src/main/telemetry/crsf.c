@@ -59,11 +59,11 @@
 #include "sensors/sensors.h"
 
 #include "telemetry/crsf.h"
+#include "telemetry/crsf_scheduler.h"
 #include "telemetry/telemetry.h"
 #include "telemetry/msp_shared.h"
 
 
-#define CRSF_CYCLETIME_US                   100000  // 100ms, 10 Hz
 #define CRSF_DEVICEINFO_VERSION             0x01
 // According to TBS: "CRSF over serial should always use a sync byte at the beginning of each frame.
 // To get better performance it's recommended to use the sync byte 0xC8 to get better performance"
@@ -314,14 +314,8 @@ static void crsfFrameAttitude(sbuf_t *dst)
 Payload:
 char[]      Flight mode ( Null­terminated string )
 */
-static void crsfFrameFlightMode(sbuf_t *dst)
+static const char *crsfGetFlightModeString(void)
 {
-    // just do "OK" for the moment as a placeholder
-    // write zero for frame length, since we don't know it yet
-    uint8_t *lengthPtr = sbufPtr(dst);
-    sbufWriteU8(dst, 0);
-    crsfSerialize8(dst, CRSF_FRAMETYPE_FLIGHT_MODE);
-
     // use same logic as OSD, so telemetry displays same flight text as OSD when armed
     const char *flightMode = "OK";
     if (ARMING_FLAG(ARMED)) {
@@ -361,6 +355,17 @@ static void crsfFrameFlightMode(sbuf_t *dst)
         flightMode = "!ERR";
     }
 
+    return flightMode;
+}
+
+static void crsfFrameFlightMode(sbuf_t *dst)
+{
+    // write zero for frame length, since we don't know it yet
+    uint8_t *lengthPtr = sbufPtr(dst);
+    sbufWriteU8(dst, 0);
+    crsfSerialize8(dst, CRSF_FRAMETYPE_FLIGHT_MODE);
+
+    const char *flightMode = crsfGetFlightModeString();
     crsfSerializeData(dst, (const uint8_t*)flightMode, strlen(flightMode));
     crsfSerialize8(dst, 0); // zero terminator for string
     // write in the length
@@ -399,9 +404,6 @@ static void crsfFrameDeviceInfo(sbuf_t *dst)
     *lengthPtr = sbufPtr(dst) - lengthPtr;
 }
 
-#define BV(x)  (1 << (x)) // bit value
-
-// schedule array to decide how often each type of frame is sent
 typedef enum {
     CRSF_FRAME_START_INDEX = 0,
     CRSF_FRAME_ATTITUDE_INDEX = CRSF_FRAME_START_INDEX,
@@ -412,8 +414,19 @@ typedef enum {
     CRSF_SCHEDULE_COUNT_MAX
 } crsfFrameTypeIndex_e;
 
-static uint8_t crsfScheduleCount;
-static uint8_t crsfSchedule[CRSF_SCHEDULE_COUNT_MAX];
+STATIC_ASSERT(CRSF_SCHEDULE_COUNT_MAX <= CRSF_SCHEDULER_MAX_FRAMES, crsf_schedule_too_big);
+
+static const uint8_t crsfScheduledFrameTypes[CRSF_SCHEDULE_COUNT_MAX] = {
+    [CRSF_FRAME_ATTITUDE_INDEX]         = CRSF_FRAMETYPE_ATTITUDE,
+    [CRSF_FRAME_BATTERY_SENSOR_INDEX]   = CRSF_FRAMETYPE_BATTERY_SENSOR,
+    [CRSF_FRAME_FLIGHT_MODE_INDEX]      = CRSF_FRAMETYPE_FLIGHT_MODE,
+    [CRSF_FRAME_GPS_INDEX]              = CRSF_FRAMETYPE_GPS,
+    [CRSF_FRAME_VARIO_SENSOR_INDEX]     = CRSF_FRAMETYPE_VARIO_SENSOR,
+};
+
+static crsfScheduler_t crsfScheduler;
+static const char *crsfLastFlightMode;
+static batteryState_e crsfLastBatteryState;
 
 #if defined(USE_MSP_OVER_TELEMETRY)
 
@@ -439,44 +452,64 @@ void crsfSendMspResponse(uint8_t *payload)
 }
 #endif
 
-static void processCrsf(void)
+// Flag frames whose content changed in a way the pilot should see without waiting for their slot
+static void crsfCheckChangedFrames(void)
+{
+    const char *flightMode = crsfGetFlightModeString();
+    if (flightMode != crsfLastFlightMode) {
+        crsfLastFlightMode = flightMode;
+        crsfSchedulerMarkChanged(&crsfScheduler, CRSF_FRAME_FLIGHT_MODE_INDEX);
+    }
+
+    const batteryState_e batteryState = getBatteryState();
+    if (batteryState != crsfLastBatteryState) {
+        crsfLastBatteryState = batteryState;
+        crsfSchedulerMarkChanged(&crsfScheduler, CRSF_FRAME_BATTERY_SENSOR_INDEX);
+    }
+}
+
+static void processCrsf(timeUs_t currentTimeUs)
 {
-    static uint8_t crsfScheduleIndex = 0;
-    const uint8_t currentSchedule = crsfSchedule[crsfScheduleIndex];
+    // Telemetry frames get fewer downlink slots at low packet rates
+    if (rxLinkStatistics.uplinkLQ > 0) {
+        crsfSchedulerSetSlotInterval(&crsfScheduler, crsfSchedulerSlotIntervalForFramePeriod(crsfRxGetFramePeriodUs()));
+    }
+
+    crsfCheckChangedFrames();
+
+    const int frameIndex = crsfSchedulerNext(&crsfScheduler, currentTimeUs);
+    if (frameIndex < 0) {
+        return;
+    }
 
     sbuf_t crsfPayloadBuf;
     sbuf_t *dst = &crsfPayloadBuf;
 
-    if (currentSchedule & BV(CRSF_FRAME_ATTITUDE_INDEX)) {
-        crsfInitializeFrame(dst);
+    crsfInitializeFrame(dst);
+    switch (frameIndex) {
+    case CRSF_FRAME_ATTITUDE_INDEX:
         crsfFrameAttitude(dst);
-        crsfFinalize(dst);
-    }
-    if (currentSchedule & BV(CRSF_FRAME_BATTERY_SENSOR_INDEX)) {
-        crsfInitializeFrame(dst);
+        break;
+    case CRSF_FRAME_BATTERY_SENSOR_INDEX:
         crsfFrameBatterySensor(dst);
-        crsfFinalize(dst);
-    }
-    if (currentSchedule & BV(CRSF_FRAME_FLIGHT_MODE_INDEX)) {
-        crsfInitializeFrame(dst);
+        break;
+    case CRSF_FRAME_FLIGHT_MODE_INDEX:
         crsfFrameFlightMode(dst);
-        crsfFinalize(dst);
-    }
+        break;
 #ifdef USE_GPS
-    if (currentSchedule & BV(CRSF_FRAME_GPS_INDEX)) {
-        crsfInitializeFrame(dst);
+    case CRSF_FRAME_GPS_INDEX:
         crsfFrameGps(dst);
-        crsfFinalize(dst);
-    }
+        break;
 #endif
 #if defined(USE_BARO) || defined(USE_GPS)
-    if (currentSchedule & BV(CRSF_FRAME_VARIO_SENSOR_INDEX)) {
-        crsfInitializeFrame(dst);
+    case CRSF_FRAME_VARIO_SENSOR_INDEX:
         crsfFrameVarioSensor(dst);
-        crsfFinalize(dst);
-    }
+        break;
 #endif
-    crsfScheduleIndex = (crsfScheduleIndex + 1) % crsfScheduleCount;
+    default:
+        return;
+    }
+    crsfFinalize(dst);
 }
 
 void crsfScheduleDeviceInfoResponse(void)
@@ -495,21 +528,24 @@ void initCrsfTelemetry(void)
     mspReplyPending = false;
 #endif
 
-    int index = 0;
-    crsfSchedule[index++] = BV(CRSF_FRAME_ATTITUDE_INDEX);
-    crsfSchedule[index++] = BV(CRSF_FRAME_BATTERY_SENSOR_INDEX);
-    crsfSchedule[index++] = BV(CRSF_FRAME_FLIGHT_MODE_INDEX);
+    // Target rates with the full link available, in 0.1Hz. Attitude is what the pilot
+    // notices first when it lags, so it keeps its rate when slots run short.
+    crsfSchedulerInit(&crsfScheduler, micros());
+    crsfSchedulerConfigureFrame(&crsfScheduler, CRSF_FRAME_ATTITUDE_INDEX, 200, CRSF_SCHEDULER_PRIORITY_HIGH);
+    crsfSchedulerConfigureFrame(&crsfScheduler, CRSF_FRAME_BATTERY_SENSOR_INDEX, 50, CRSF_SCHEDULER_PRIORITY_LOW);
+    crsfSchedulerConfigureFrame(&crsfScheduler, CRSF_FRAME_FLIGHT_MODE_INDEX, 20, CRSF_SCHEDULER_PRIORITY_LOW);
 #ifdef USE_GPS
     if (feature(FEATURE_GPS)) {
-        crsfSchedule[index++] = BV(CRSF_FRAME_GPS_INDEX);
+        crsfSchedulerConfigureFrame(&crsfScheduler, CRSF_FRAME_GPS_INDEX, 50, CRSF_SCHEDULER_PRIORITY_NORMAL);
     }
 #endif
 #if defined(USE_BARO) || defined(USE_GPS)
     if (sensors(SENSOR_BARO) || (STATE(FIXED_WING_LEGACY) && feature(FEATURE_GPS))) {
-        crsfSchedule[index++] = BV(CRSF_FRAME_VARIO_SENSOR_INDEX);
+        crsfSchedulerConfigureFrame(&crsfScheduler, CRSF_FRAME_VARIO_SENSOR_INDEX, 100, CRSF_SCHEDULER_PRIORITY_NORMAL);
     }
 #endif
-    crsfScheduleCount = (uint8_t)index;
+    crsfLastFlightMode = NULL;
+    crsfLastBatteryState = getBatteryState();
 }
 
 bool checkCrsfTelemetryState(void)
@@ -522,8 +558,6 @@ bool checkCrsfTelemetryState(void)
  */
 void handleCrsfTelemetry(timeUs_t currentTimeUs)
 {
-    static uint32_t crsfLastCycleTime;
-
     if (!crsfTelemetryEnabled) {
         return;
     }
@@ -536,7 +570,6 @@ void handleCrsfTelemetry(timeUs_t currentTimeUs)
 #if defined(USE_MSP_OVER_TELEMETRY)
     if (mspReplyPending) {
         mspReplyPending = handleCrsfMspFrameBuffer(CRSF_FRAME_TX_MSP_FRAME_SIZE, &crsfSendMspResponse);
-        crsfLastCycleTime = currentTimeUs; // reset telemetry timing due to ad-hoc request
         return;
     }
 #endif
@@ -548,16 +581,32 @@ void handleCrsfTelemetry(timeUs_t currentTimeUs)
         crsfFrameDeviceInfo(dst);
         crsfFinalize(dst);
         deviceInfoReplyPending = false;
-        crsfLastCycleTime = currentTimeUs; // reset telemetry timing due to ad-hoc request
         return;
     }
 
-    // Actual telemetry data only needs to be sent at a low frequency, ie 10Hz
-    // Spread out scheduled frames evenly so each frame is sent at the same frequency.
-    if (currentTimeUs >= crsfLastCycleTime + (CRSF_CYCLETIME_US / crsfScheduleCount)) {
-        crsfLastCycleTime = currentTimeUs;
-        processCrsf();
+    // Only build a new frame once the receiver has taken the previous one, otherwise it would be overwritten
+    if (crsfRxIsTelemetryBufEmpty()) {
+        processCrsf(currentTimeUs);
+    }
+}
+
+bool crsfGetTelemetryFrameStats(uint8_t index, crsfTelemetryFrameStats_t *stats)
+{
+    if (index >= CRSF_SCHEDULE_COUNT_MAX || !crsfScheduler.frames[index].enabled) {
+        return false;
     }
+
+    const crsfSchedulerFrame_t *frame = &crsfScheduler.frames[index];
+    stats->frameType = crsfScheduledFrameTypes[index];
+    stats->priority = frame->priority;
+    stats->targetRateDeciHz = frame->targetRateDeciHz;
+    stats->achievedRateDeciHz = frame->achievedRateDeciHz;
+    return true;
+}
+
+timeUs_t crsfGetTelemetrySlotInterval(void)
+{
+    return crsfScheduler.slotIntervalUs;
 }
 
 int getCrsfFrame(uint8_t *frame, crsfFrameType_e frameType)
@@ -23,12 +23,21 @@
 #define CRSF_MSP_RX_BUF_SIZE 128
 #define CRSF_MSP_TX_BUF_SIZE 128
 
+typedef struct crsfTelemetryFrameStats_s {
+    uint8_t     frameType;          // crsfFrameType_e
+    uint8_t     priority;
+    uint16_t    targetRateDeciHz;
+    uint16_t    achievedRateDeciHz;
+} crsfTelemetryFrameStats_t;
+
 void initCrsfTelemetry(void);
 bool checkCrsfTelemetryState(void);
 void handleCrsfTelemetry(timeUs_t currentTimeUs);
 void crsfScheduleDeviceInfoResponse(void);
 void crsfScheduleMspResponse(void);
 int getCrsfFrame(uint8_t *frame, crsfFrameType_e frameType);
+bool crsfGetTelemetryFrameStats(uint8_t index, crsfTelemetryFrameStats_t *stats);
+timeUs_t crsfGetTelemetrySlotInterval(void);
 #if defined(USE_MSP_OVER_TELEMETRY)
 void initCrsfMspBuffer(void);
 bool bufferCrsfMspFrame(uint8_t *frameStart, int frameLength);
@@ -0,0 +1,142 @@
+/*
+ * This file is part of INAV
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "crsf_scheduler.h"
+
+void crsfSchedulerInit(crsfScheduler_t *scheduler, timeUs_t currentTimeUs)
+{
+    memset(scheduler, 0, sizeof(*scheduler));
+    scheduler->slotIntervalUs = CRSF_SCHEDULER_SLOT_US_MIN;
+    scheduler->lastSlotUs = currentTimeUs;
+    scheduler->statsWindowStartUs = currentTimeUs;
+}
+
+void crsfSchedulerConfigureFrame(crsfScheduler_t *scheduler, uint8_t index, uint16_t targetRateDeciHz, crsfSchedulerPriority_e priority)
+{
+    if (index >= CRSF_SCHEDULER_MAX_FRAMES || targetRateDeciHz == 0) {
+        return;
+    }
+
+    crsfSchedulerFrame_t *frame = &scheduler->frames[index];
+    frame->enabled = true;
+    frame->changed = false;
+    frame->priority = priority;
+    frame->targetRateDeciHz = targetRateDeciHz;
+    frame->intervalUs = 10000000 / targetRateDeciHz;
+    // Make the frame due right away
+    frame->lastSentUs = scheduler->lastSlotUs - frame->intervalUs;
+}
+
+void crsfSchedulerMarkChanged(crsfScheduler_t *scheduler, uint8_t index)
+{
+    if (index < CRSF_SCHEDULER_MAX_FRAMES) {
+        scheduler->frames[index].changed = true;
+    }
+}
+
+void crsfSchedulerSetSlotInterval(crsfScheduler_t *scheduler, timeUs_t slotIntervalUs)
+{
+    scheduler->slotIntervalUs = slotIntervalUs;
+}
+
+/*
+ * Telemetry shares the air time with RC frames, so the spacing is derived from the measured period of
+ * the uplink RC frames. It works the same for every link, the rfMode in the link statistics is an index
+ * whose meaning differs between Crossfire and ELRS. 150Hz gives 20ms, 50Hz 50ms and 4Hz 250ms.
+ */
+timeUs_t crsfSchedulerSlotIntervalForFramePeriod(timeUs_t framePeriodUs)
+{
+    if (framePeriodUs == 0) {
+        return CRSF_SCHEDULER_SLOT_US_MIN;
+    }
+
+    const timeUs_t slotIntervalUs = framePeriodUs * 5 / 2;
+    if (slotIntervalUs < CRSF_SCHEDULER_SLOT_US_MIN) {
+        return CRSF_SCHEDULER_SLOT_US_MIN;
+    }
+    if (slotIntervalUs > CRSF_SCHEDULER_SLOT_US_MAX) {
+        return CRSF_SCHEDULER_SLOT_US_MAX;
+    }
+    return slotIntervalUs;
+}
+
+static void crsfSchedulerUpdateStats(crsfScheduler_t *scheduler, timeUs_t currentTimeUs)
+{
+    const timeDelta_t windowUs = currentTimeUs - scheduler->statsWindowStartUs;
+    if (windowUs < CRSF_SCHEDULER_STATS_WINDOW_US) {
+        return;
+    }
+
+    for (int i = 0; i < CRSF_SCHEDULER_MAX_FRAMES; i++) {
+        crsfSchedulerFrame_t *frame = &scheduler->frames[i];
+        frame->achievedRateDeciHz = (uint32_t)frame->windowSentCount * 10000000 / windowUs;
+        frame->windowSentCount = 0;
+    }
+    scheduler->statsWindowStartUs = currentTimeUs;
+}
+
+/*
+ * One frame is sent per slot. Frames flagged as changed go first, then the due frame that has waited
+ * longest, weighted by priority. Waiting time keeps growing, so when the link can't carry every
+ * target rate low priority frames are sent less often instead of not at all.
+ */
+int crsfSchedulerNext(crsfScheduler_t *scheduler, timeUs_t currentTimeUs)
+{
+    crsfSchedulerUpdateStats(scheduler, currentTimeUs);
+
+    if (currentTimeUs - scheduler->lastSlotUs < scheduler->slotIntervalUs) {
+        return -1;
+    }
+
+    int best = -1;
+    bool bestChanged = false;
+    uint32_t bestScore = 0;
+
+    for (int i = 0; i < CRSF_SCHEDULER_MAX_FRAMES; i++) {
+        const crsfSchedulerFrame_t *frame = &scheduler->frames[i];
+        if (!frame->enabled) {
+            continue;
+        }
+
+        const timeUs_t elapsedUs = currentTimeUs - frame->lastSentUs;
+        if (!frame->changed && elapsedUs < frame->intervalUs) {
+            continue;
+        }
+
+        const uint32_t score = (uint32_t)(elapsedUs / 1000) * frame->priority;
+
+        if (best < 0 || (frame->changed && !bestChanged) || (frame->changed == bestChanged && score > bestScore)) {
+            best = i;
+            bestChanged = frame->changed;
+            bestScore = score;
+        }
+    }
+
+    if (best >= 0) {
+        crsfSchedulerFrame_t *frame = &scheduler->frames[best];
+        frame->changed = false;
+        frame->lastSentUs = currentTimeUs;
+        frame->windowSentCount++;
+        scheduler->lastSlotUs = currentTimeUs;
+    }
+
+    return best;
+}
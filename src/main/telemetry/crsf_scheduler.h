@@ -0,0 +1,71 @@
+/*
+ * This file is part of INAV
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRSF_SCHEDULER_MAX_FRAMES           8
+#define CRSF_SCHEDULER_STATS_WINDOW_US      1000000
+
+// Spacing between two telemetry frames, 2.5 uplink frames within these limits
+#define CRSF_SCHEDULER_SLOT_US_MIN          20000
+#define CRSF_SCHEDULER_SLOT_US_MAX          250000
+
+typedef enum {
+    CRSF_SCHEDULER_PRIORITY_LOW     = 1,
+    CRSF_SCHEDULER_PRIORITY_NORMAL  = 2,
+    CRSF_SCHEDULER_PRIORITY_HIGH    = 4,
+} crsfSchedulerPriority_e;
+
+typedef struct crsfSchedulerFrame_s {
+    bool        enabled;
+    bool        changed;            // Value changed since last send, send ahead of everything else
+    uint8_t     priority;           // crsfSchedulerPriority_e
+    uint16_t    targetRateDeciHz;
+    uint16_t    achievedRateDeciHz; // Measured over the last stats window
+    uint16_t    windowSentCount;
+    timeUs_t    intervalUs;
+    timeUs_t    lastSentUs;
+} crsfSchedulerFrame_t;
+
+typedef struct crsfScheduler_s {
+    crsfSchedulerFrame_t frames[CRSF_SCHEDULER_MAX_FRAMES];
+    timeUs_t    slotIntervalUs;
+    timeUs_t    lastSlotUs;
+    timeUs_t    statsWindowStartUs;
+} crsfScheduler_t;
+
+void crsfSchedulerInit(crsfScheduler_t *scheduler, timeUs_t currentTimeUs);
+void crsfSchedulerConfigureFrame(crsfScheduler_t *scheduler, uint8_t index, uint16_t targetRateDeciHz, crsfSchedulerPriority_e priority);
+void crsfSchedulerMarkChanged(crsfScheduler_t *scheduler, uint8_t index);
+void crsfSchedulerSetSlotInterval(crsfScheduler_t *scheduler, timeUs_t slotIntervalUs);
+timeUs_t crsfSchedulerSlotIntervalForFramePeriod(timeUs_t framePeriodUs);
+
+// Returns the index of the frame to send now and accounts for it, or -1 if nothing should be sent
+int crsfSchedulerNext(crsfScheduler_t *scheduler, timeUs_t currentTimeUs);
+
+#ifdef __cplusplus
+}
+#endif
@@ -94,8 +94,9 @@
 #pragma GCC diagnostic pop
 
 #define TELEMETRY_MAVLINK_PORT_MODE     MODE_RXTX
-#define TELEMETRY_MAVLINK_MAXRATE       50
-#define TELEMETRY_MAVLINK_DELAY         ((1000 * 1000) / TELEMETRY_MAVLINK_MAXRATE)
+#define TELEMETRY_MAVLINK_MAXRATE       200
+#define TELEMETRY_MAVLINK_MIN_INTERVAL_US   ((1000 * 1000) / TELEMETRY_MAVLINK_MAXRATE)
+#define TELEMETRY_MAVLINK_STATS_WINDOW_US   (1000 * 1000)
 
 /**
  * MAVLink requires angles to be in the range -Pi..Pi.
@@ -172,10 +173,30 @@ static uint8_t mavRates[] = {
     [MAV_DATA_STREAM_EXTRA3] = 1                // 1Hz
 };
 
-#define MAXSTREAMS (sizeof(mavRates) / sizeof(mavRates[0]))
+typedef struct mavlinkScheduledMessage_s {
+    uint32_t msgId;
+    uint8_t stream;                 // MAV_DATA_STREAM providing the default rate
+    void (*send)(void);
+} mavlinkScheduledMessage_t;
+
+typedef struct mavlinkMessageState_s {
+    timeUs_t intervalUs;            // 0 = not sent
+    timeUs_t nextDueUs;
+    uint16_t maxLength;             // Worst case size on the wire, checked against the TX space
+    bool intervalOverridden;        // Set through MAV_CMD_SET_MESSAGE_INTERVAL, survives stream rate changes
+    uint16_t windowCount;
+    uint16_t achievedRateHz;
+} mavlinkMessageState_t;
+
+typedef struct mavlinkStats_s {
+    timeUs_t windowStartUs;
+    uint32_t windowBytes;
+    uint16_t windowMessages;
+    uint16_t windowDeferred;
+} mavlinkStats_t;
+
+static void mavlinkResetMessageSchedule(void);
 
-static timeUs_t lastMavlinkMessage = 0;
-static uint8_t mavTicks[MAXSTREAMS];
 static mavlink_message_t mavSendMsg;
 static mavlink_message_t mavRecvMsg;
 static mavlink_status_t mavRecvStatus;
@@ -243,28 +264,6 @@ static APM_PLANE_MODE inavToArduPlaneMap(flightModeForTelemetry_e flightMode)
     }
 }
 
-static int mavlinkStreamTrigger(enum MAV_DATA_STREAM streamNum)
-{
-    uint8_t rate = (uint8_t) mavRates[streamNum];
-    if (rate == 0) {
-        return 0;
-    }
-
-    if (mavTicks[streamNum] == 0) {
-        // we're triggering now, setup the next trigger point
-        if (rate > TELEMETRY_MAVLINK_MAXRATE) {
-            rate = TELEMETRY_MAVLINK_MAXRATE;
-        }
-
-        mavTicks[streamNum] = (TELEMETRY_MAVLINK_MAXRATE / rate);
-        return 1;
-    }
-
-    // count down at TASK_RATE_HZ
-    mavTicks[streamNum]--;
-    return 0;
-}
-
 void freeMAVLinkTelemetryPort(void)
 {
     closeSerialPort(mavlinkPort);
@@ -307,6 +306,7 @@ static void configureMAVLinkStreamRates(void)
     mavRates[MAV_DATA_STREAM_EXTRA1] = telemetryConfig()->mavlink.extra1_rate;
     mavRates[MAV_DATA_STREAM_EXTRA2] = telemetryConfig()->mavlink.extra2_rate;
     mavRates[MAV_DATA_STREAM_EXTRA3] = telemetryConfig()->mavlink.extra3_rate;
+    mavlinkResetMessageSchedule();
 }
 
 void checkMAVLinkTelemetryState(void)
@@ -324,6 +324,8 @@ void checkMAVLinkTelemetryState(void)
         freeMAVLinkTelemetryPort();
 }
 
+static mavlinkStats_t mavStats;
+
 static void mavlinkSendMessage(void)
 {
     uint8_t mavBuffer[MAVLINK_MAX_PACKET_LEN];
@@ -337,12 +339,12 @@ static void mavlinkSendMessage(void)
 
     int msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavSendMsg);
 
-    for (int i = 0; i < msgLength; i++) {
-        serialWrite(mavlinkPort, mavBuffer[i]);
-    }
+    serialWriteBuf(mavlinkPort, mavBuffer, msgLength);
+    mavStats.windowBytes += msgLength;
+    mavStats.windowMessages++;
 }
 
-void mavlinkSendSystemStatus(void)
+static void mavlinkSendSystemStatus(void)
 {
     // Receiver is assumed to be always present
     uint32_t onboard_control_sensors_present    = (MAV_SYS_STATUS_SENSOR_RC_RECEIVER);
@@ -486,7 +488,7 @@ void mavlinkSendSystemStatus(void)
     mavlinkSendMessage();
 }
 
-void mavlinkSendRCChannelsAndRSSI(void)
+static void mavlinkSendRCChannelsAndRSSI(void)
 {
 #define GET_CHANNEL_VALUE(x) ((rxRuntimeConfig.channelCount >= (x + 1)) ? rxGetChannelValue(x) : 0)
     mavlink_msg_rc_channels_raw_pack(mavSystemId, mavComponentId, &mavSendMsg,
@@ -519,7 +521,7 @@ void mavlinkSendRCChannelsAndRSSI(void)
 }
 
 #if defined(USE_GPS)
-void mavlinkSendPosition(timeUs_t currentTimeUs)
+static void mavlinkSendGpsRawInt(void)
 {
     uint8_t gpsFixType = 0;
 
@@ -535,7 +537,7 @@ void mavlinkSendPosition(timeUs_t currentTimeUs)
 
     mavlink_msg_gps_raw_int_pack(mavSystemId, mavComponentId, &mavSendMsg,
         // time_usec Timestamp (microseconds since UNIX epoch or microseconds since system boot)
-        currentTimeUs,
+        micros(),
         // fix_type 0-1: no fix, 2: 2D fix, 3: 3D fix. Some applications will not use the value of this field unless it is at least two, so always correctly fill in the fix.
         gpsFixType,
         // lat Latitude in 1E7 degrees
@@ -568,11 +570,16 @@ void mavlinkSendPosition(timeUs_t currentTimeUs)
         0);
 
     mavlinkSendMessage();
+}
+
+static void mavlinkSendGlobalPositionInt(void)
+{
+    if (!sensors(SENSOR_GPS))
+        return;
 
-    // Global position
     mavlink_msg_global_position_int_pack(mavSystemId, mavComponentId, &mavSendMsg,
         // time_usec Timestamp (microseconds since UNIX epoch or microseconds since system boot)
-        currentTimeUs,
+        micros(),
         // lat Latitude in 1E7 degrees
         gpsSol.llh.lat,
         // lon Longitude in 1E7 degrees
@@ -592,6 +599,12 @@ void mavlinkSendPosition(timeUs_t currentTimeUs)
     );
 
     mavlinkSendMessage();
+}
+
+static void mavlinkSendGpsGlobalOrigin(void)
+{
+    if (!sensors(SENSOR_GPS))
+        return;
 
     mavlink_msg_gps_global_origin_pack(mavSystemId, mavComponentId, &mavSendMsg,
         // latitude Latitude (WGS84), expressed as * 1E7
@@ -608,7 +621,7 @@ void mavlinkSendPosition(timeUs_t currentTimeUs)
 }
 #endif
 
-void mavlinkSendAttitude(void)
+static void mavlinkSendAttitude(void)
 {
     mavlink_msg_attitude_pack(mavSystemId, mavComponentId, &mavSendMsg,
         // time_boot_ms Timestamp (milliseconds since system boot)
@@ -629,7 +642,7 @@ void mavlinkSendAttitude(void)
     mavlinkSendMessage();
 }
 
-void mavlinkSendHUDAndHeartbeat(void)
+static void mavlinkSendVfrHud(void)
 {
     float mavAltitude = 0;
     float mavGroundSpeed = 0;
@@ -669,8 +682,10 @@ void mavlinkSendHUDAndHeartbeat(void)
         mavClimbRate);
 
     mavlinkSendMessage();
+}
 
-
+static void mavlinkSendHeartbeat(void)
+{
     uint8_t mavModes = MAV_MODE_FLAG_MANUAL_INPUT_ENABLED | MAV_MODE_FLAG_CUSTOM_MODE_ENABLED;
     if (ARMING_FLAG(ARMED))
         mavModes |= MAV_MODE_FLAG_SAFETY_ARMED;
@@ -749,7 +764,7 @@ void mavlinkSendHUDAndHeartbeat(void)
     mavlinkSendMessage();
 }
 
-void mavlinkSendBatteryTemperatureStatusText(void)
+static void mavlinkSendBatteryStatus(void)
 {
     uint16_t batteryVoltages[MAVLINK_MSG_BATTERY_STATUS_FIELD_VOLTAGES_LEN];
     uint16_t batteryVoltagesExt[MAVLINK_MSG_BATTERY_STATUS_FIELD_VOLTAGES_EXT_LEN];
@@ -805,8 +820,10 @@ void mavlinkSendBatteryTemperatureStatusText(void)
         0);
 
     mavlinkSendMessage();
+}
 
-
+static void mavlinkSendScaledPressure(void)
+{
     int16_t temperature;
     sensors(SENSOR_BARO) ? getBaroTemperature(&temperature) : getIMUTemperature(&temperature);
     mavlink_msg_scaled_pressure_pack(mavSystemId, mavComponentId, &mavSendMsg,
@@ -817,10 +834,12 @@ void mavlinkSendBatteryTemperatureStatusText(void)
         0);
 
     mavlinkSendMessage();
-
+}
 
 // FIXME - Status text is limited to boards with USE_OSD
 #ifdef USE_OSD
+static void mavlinkSendStatusText(void)
+{
     char buff[MAVLINK_MSG_STATUSTEXT_FIELD_TEXT_LEN] = {" "};
     textAttributes_t elemAttr = osdGetSystemMessage(buff, sizeof(buff), false);
     if (buff[0] != SYM_BLANK) {
@@ -839,40 +858,132 @@ void mavlinkSendBatteryTemperatureStatusText(void)
 
         mavlinkSendMessage();
     }
+}
 #endif
 
+// Ordered by priority, messages earlier in the table get the TX space first
+static const mavlinkScheduledMessage_t mavScheduledMessages[] = {
+    { MAVLINK_MSG_ID_HEARTBEAT,             MAV_DATA_STREAM_EXTRA2,             mavlinkSendHeartbeat },
+    { MAVLINK_MSG_ID_ATTITUDE,              MAV_DATA_STREAM_EXTRA1,             mavlinkSendAttitude },
+#ifdef USE_GPS
+    { MAVLINK_MSG_ID_GLOBAL_POSITION_INT,   MAV_DATA_STREAM_POSITION,           mavlinkSendGlobalPositionInt },
+    { MAVLINK_MSG_ID_GPS_RAW_INT,           MAV_DATA_STREAM_POSITION,           mavlinkSendGpsRawInt },
+#endif
+    { MAVLINK_MSG_ID_VFR_HUD,               MAV_DATA_STREAM_EXTRA2,             mavlinkSendVfrHud },
+    { MAVLINK_MSG_ID_SYS_STATUS,            MAV_DATA_STREAM_EXTENDED_STATUS,    mavlinkSendSystemStatus },
+    { MAVLINK_MSG_ID_RC_CHANNELS_RAW,       MAV_DATA_STREAM_RC_CHANNELS,        mavlinkSendRCChannelsAndRSSI },
+    { MAVLINK_MSG_ID_BATTERY_STATUS,        MAV_DATA_STREAM_EXTRA3,             mavlinkSendBatteryStatus },
+    { MAVLINK_MSG_ID_SCALED_PRESSURE,       MAV_DATA_STREAM_EXTRA3,             mavlinkSendScaledPressure },
+#ifdef USE_OSD
+    { MAVLINK_MSG_ID_STATUSTEXT,            MAV_DATA_STREAM_EXTRA3,             mavlinkSendStatusText },
+#endif
+#ifdef USE_GPS
+    { MAVLINK_MSG_ID_GPS_GLOBAL_ORIGIN,     MAV_DATA_STREAM_POSITION,           mavlinkSendGpsGlobalOrigin },
+#endif
+};
+
+#define MAVLINK_SCHEDULED_MESSAGE_COUNT ARRAYLEN(mavScheduledMessages)
+
+static mavlinkMessageState_t mavMessageState[MAVLINK_SCHEDULED_MESSAGE_COUNT];
 
+static int mavlinkFindScheduledMessage(uint32_t msgId)
+{
+    for (unsigned i = 0; i < MAVLINK_SCHEDULED_MESSAGE_COUNT; i++) {
+        if (mavScheduledMessages[i].msgId == msgId) {
+            return i;
+        }
+    }
+    return -1;
 }
 
-void processMAVLinkTelemetry(timeUs_t currentTimeUs)
+static timeUs_t mavlinkStreamInterval(uint8_t stream)
 {
-    // is executed @ TELEMETRY_MAVLINK_MAXRATE rate
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTENDED_STATUS)) {
-        mavlinkSendSystemStatus();
+    const uint8_t rate = mavRates[stream];
+    if (rate == 0) {
+        return 0;
     }
+    return (1000 * 1000) / MIN(rate, TELEMETRY_MAVLINK_MAXRATE);
+}
+
+static void mavlinkResetMessageSchedule(void)
+{
+    const timeUs_t currentTimeUs = micros();
+
+    for (unsigned i = 0; i < MAVLINK_SCHEDULED_MESSAGE_COUNT; i++) {
+        mavlinkMessageState_t *state = &mavMessageState[i];
+        const mavlink_msg_entry_t *entry = mavlink_get_msg_entry(mavScheduledMessages[i].msgId);
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_RC_CHANNELS)) {
-        mavlinkSendRCChannelsAndRSSI();
+        if (!state->intervalOverridden) {
+            state->intervalUs = mavlinkStreamInterval(mavScheduledMessages[i].stream);
+        }
+        state->nextDueUs = currentTimeUs;
+        state->maxLength = MAVLINK_NUM_NON_PAYLOAD_BYTES + (entry ? entry->max_msg_len : MAVLINK_MAX_PAYLOAD_LEN);
     }
+}
 
-#ifdef USE_GPS
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_POSITION)) {
-        mavlinkSendPosition(currentTimeUs);
+static void mavlinkUpdateStats(timeUs_t currentTimeUs)
+{
+    const timeDelta_t windowUs = cmpTimeUs(currentTimeUs, mavStats.windowStartUs);
+    if (windowUs < TELEMETRY_MAVLINK_STATS_WINDOW_US) {
+        return;
     }
-#endif
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA1)) {
-        mavlinkSendAttitude();
+    for (unsigned i = 0; i < MAVLINK_SCHEDULED_MESSAGE_COUNT; i++) {
+        mavlinkMessageState_t *state = &mavMessageState[i];
+        state->achievedRateHz = (uint32_t)state->windowCount * TELEMETRY_MAVLINK_STATS_WINDOW_US / windowUs;
+        state->windowCount = 0;
     }
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA2)) {
-        mavlinkSendHUDAndHeartbeat();
+    DEBUG_SET(DEBUG_MAVLINK_TELEMETRY, 0, (int64_t)mavStats.windowBytes * TELEMETRY_MAVLINK_STATS_WINDOW_US / windowUs);
+    DEBUG_SET(DEBUG_MAVLINK_TELEMETRY, 1, mavStats.windowMessages);
+    DEBUG_SET(DEBUG_MAVLINK_TELEMETRY, 2, mavStats.windowDeferred);
+    // Achieved rates of the highest priority messages
+    for (unsigned i = 3; i < DEBUG32_VALUE_COUNT && i - 3 < MAVLINK_SCHEDULED_MESSAGE_COUNT; i++) {
+        DEBUG_SET(DEBUG_MAVLINK_TELEMETRY, i, mavMessageState[i - 3].achievedRateHz);
     }
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA3)) {
-        mavlinkSendBatteryTemperatureStatusText();
+    mavStats.windowStartUs = currentTimeUs;
+    mavStats.windowBytes = 0;
+    mavStats.windowMessages = 0;
+    mavStats.windowDeferred = 0;
+}
+
+/*
+ * Sends every message that is due, as many as fit into the free TX space of the port.
+ * Messages that don't fit stay due and go out on the next pass, lower priority ones can
+ * still use the remaining space.
+ */
+static void processMAVLinkTelemetry(timeUs_t currentTimeUs)
+{
+    uint32_t txFree = serialTxBytesFree(mavlinkPort);
+
+    for (unsigned i = 0; i < MAVLINK_SCHEDULED_MESSAGE_COUNT; i++) {
+        mavlinkMessageState_t *state = &mavMessageState[i];
+
+        if (state->intervalUs == 0 || cmpTimeUs(currentTimeUs, state->nextDueUs) < 0) {
+            continue;
+        }
+
+        if (txFree < state->maxLength) {
+            mavStats.windowDeferred++;
+            continue;
+        }
+
+        const uint32_t bytesBefore = mavStats.windowBytes;
+        mavScheduledMessages[i].send();
+        if (mavStats.windowBytes != bytesBefore) {
+            txFree -= MIN(txFree, mavStats.windowBytes - bytesBefore);
+            state->windowCount++;
+        }
+
+        state->nextDueUs += state->intervalUs;
+        // Don't try to catch up after the link was congested, resume from now
+        if (cmpTimeUs(currentTimeUs, state->nextDueUs) >= 0) {
+            state->nextDueUs = currentTimeUs + state->intervalUs;
+        }
     }
 
+    mavlinkUpdateStats(currentTimeUs);
 }
 
 static bool handleIncoming_MISSION_CLEAR_ALL(void)
@@ -1052,6 +1163,79 @@ static bool handleIncoming_RC_CHANNELS_OVERRIDE(void) {
     return true;
 }
 
+static void mavlinkSendCommandAck(uint16_t command, uint8_t result)
+{
+    mavlink_msg_command_ack_pack(mavSystemId, mavComponentId, &mavSendMsg,
+        command,
+        result,
+        0,
+        0,
+        mavRecvMsg.sysid,
+        mavRecvMsg.compid);
+
+    mavlinkSendMessage();
+}
+
+static uint8_t mavlinkSetMessageInterval(uint32_t msgId, float intervalUs)
+{
+    const int index = mavlinkFindScheduledMessage(msgId);
+    if (index < 0) {
+        return MAV_RESULT_DENIED;
+    }
+
+    mavlinkMessageState_t *state = &mavMessageState[index];
+    if (intervalUs < 0) {
+        // -1 disables the message
+        state->intervalUs = 0;
+        state->intervalOverridden = true;
+    } else if (intervalUs == 0) {
+        // 0 restores the stream rate from the settings
+        state->intervalUs = mavlinkStreamInterval(mavScheduledMessages[index].stream);
+        state->intervalOverridden = false;
+    } else {
+        state->intervalUs = MAX((timeUs_t)intervalUs, (timeUs_t)TELEMETRY_MAVLINK_MIN_INTERVAL_US);
+        state->intervalOverridden = true;
+    }
+    state->nextDueUs = micros();
+
+    return MAV_RESULT_ACCEPTED;
+}
+
+static bool handleIncoming_COMMAND_LONG(void)
+{
+    mavlink_command_long_t msg;
+    mavlink_msg_command_long_decode(&mavRecvMsg, &msg);
+
+    if (msg.target_system != mavSystemId) {
+        return false;
+    }
+
+    switch (msg.command) {
+        case MAV_CMD_SET_MESSAGE_INTERVAL:
+            mavlinkSendCommandAck(msg.command, mavlinkSetMessageInterval((uint32_t)msg.param1, msg.param2));
+            return true;
+        case MAV_CMD_GET_MESSAGE_INTERVAL:
+            {
+                const int index = mavlinkFindScheduledMessage((uint32_t)msg.param1);
+                if (index < 0) {
+                    mavlinkSendCommandAck(msg.command, MAV_RESULT_DENIED);
+                    return true;
+                }
+                const timeUs_t intervalUs = mavMessageState[index].intervalUs;
+                mavlink_msg_message_interval_pack(mavSystemId, mavComponentId, &mavSendMsg,
+                    (uint16_t)msg.param1,
+                    // interval_us 0 means not sent, -1 means disabled
+                    intervalUs ? (int32_t)intervalUs : -1);
+                mavlinkSendMessage();
+                mavlinkSendCommandAck(msg.command, MAV_RESULT_ACCEPTED);
+            }
+            return true;
+        default:
+            mavlinkSendCommandAck(msg.command, MAV_RESULT_UNSUPPORTED);
+            return true;
+    }
+}
+
 static bool processMAVLinkIncomingTelemetry(void)
 {
     while (serialRxBytesWaiting(mavlinkPort) > 0) {
@@ -1074,6 +1258,8 @@ static bool processMAVLinkIncomingTelemetry(void)
                     return handleIncoming_MISSION_REQUEST();
                 case MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE:
                     return handleIncoming_RC_CHANNELS_OVERRIDE();
+                case MAVLINK_MSG_ID_COMMAND_LONG:
+                    return handleIncoming_COMMAND_LONG();
                 default:
                     return false;
             }
@@ -1100,20 +1286,17 @@ void handleMAVLinkTelemetry(timeUs_t currentTimeUs)
         incomingRequestServed = true;
     }
 
-    if ((currentTimeUs - lastMavlinkMessage) >= TELEMETRY_MAVLINK_DELAY) {
-        // Only process scheduled data if we didn't serve any incoming request this cycle
-        if (!incomingRequestServed || 
-            (
-                 (rxConfig()->receiverType == RX_TYPE_SERIAL) && 
-                 (rxConfig()->serialrx_provider == SERIALRX_MAVLINK) &&
-                 !tristateWithDefaultOnIsActive(rxConfig()->halfDuplex)
-            )
-        ) {
-            processMAVLinkTelemetry(currentTimeUs);
-        }
-        lastMavlinkMessage = currentTimeUs;
-        incomingRequestServed = false;
+    // Only process scheduled data if we didn't serve any incoming request this cycle
+    if (!incomingRequestServed ||
+        (
+             (rxConfig()->receiverType == RX_TYPE_SERIAL) &&
+             (rxConfig()->serialrx_provider == SERIALRX_MAVLINK) &&
+             !tristateWithDefaultOnIsActive(rxConfig()->halfDuplex)
+        )
+    ) {
+        processMAVLinkTelemetry(currentTimeUs);
     }
+    incomingRequestServed = false;
 }
 
 #endif
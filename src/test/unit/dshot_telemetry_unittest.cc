@@ -0,0 +1,160 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+
+extern "C" {
+#include "drivers/dshot_telemetry.h"
+}
+
+#include "gtest/gtest.h"
+
+#define BIT_TICKS   16
+
+// Capture of a reply for a 1000us eRPM period, with up to one tick of jitter on each edge
+static const uint16_t capturedEdges1000us[] = {
+    0, 17, 63, 81, 111, 129, 143, 161, 175, 193, 207, 241, 255, 289, 303, 321
+};
+
+static const uint8_t gcrEncodeTable[16] = {
+    0x19, 0x1B, 0x12, 0x13, 0x1D, 0x15, 0x16, 0x17, 0x1A, 0x09, 0x0A, 0x0B, 0x1E, 0x0D, 0x0E, 0x0F
+};
+
+static uint16_t encodeFrame(uint16_t value12, bool corruptChecksum = false)
+{
+    uint16_t checksum = (value12 ^ (value12 >> 4) ^ (value12 >> 8)) & 0x0F;
+    checksum = ~checksum & 0x0F;
+    if (corruptChecksum) {
+        checksum ^= 0x01;
+    }
+    return (value12 << 4) | checksum;
+}
+
+// Build the edge timestamps an ESC reply would produce, starting at startTick
+static int encodeEdges(uint16_t frame, uint16_t startTick, int jitter, uint16_t *edges)
+{
+    uint32_t gcr = 0;
+    for (int nibble = 0; nibble < 4; nibble++) {
+        gcr |= gcrEncodeTable[(frame >> (nibble * 4)) & 0x0F] << (nibble * 5);
+    }
+    const uint32_t sequence = (1 << 20) | gcr;
+
+    int count = 0;
+    for (int bit = 0; bit < DSHOT_TELEMETRY_FRAME_BITS; bit++) {
+        if (sequence & (1 << (20 - bit))) {
+            const int offset = (count % 2) ? jitter : -jitter;
+            edges[count++] = startTick + bit * BIT_TICKS + (bit ? offset : 0);
+        }
+    }
+    return count;
+}
+
+TEST(DshotTelemetryTest, TestCapturedFrame)
+{
+    const int count = sizeof(capturedEdges1000us) / sizeof(capturedEdges1000us[0]);
+
+    EXPECT_EQ(0x19BFB7u, dshotTelemetryEdgesToGcr(capturedEdges1000us, count, BIT_TICKS));
+    EXPECT_EQ(60000u, dshotTelemetryDecodeEdges(capturedEdges1000us, count, BIT_TICKS));
+}
+
+TEST(DshotTelemetryTest, TestPeriods)
+{
+    uint16_t edges[DSHOT_TELEMETRY_MAX_EDGES];
+
+    // exponent 0..7, mantissa 9 bits
+    const struct {
+        uint16_t value12;
+        uint32_t erpm;
+    } cases[] = {
+        { (0 << 9) | 100, 600000 },
+        { (1 << 9) | 250, 120000 },
+        { (3 << 9) | 125, 60000 },
+        { (7 << 9) | 510, 919 },
+        { 0x0FFF, 0 },              // Motor stopped
+    };
+
+    for (const auto &c : cases) {
+        const int count = encodeEdges(encodeFrame(c.value12), 1000, 3, edges);
+        EXPECT_EQ(c.erpm, dshotTelemetryDecodeEdges(edges, count, BIT_TICKS)) << "value " << c.value12;
+    }
+}
+
+TEST(DshotTelemetryTest, TestTimerWrap)
+{
+    uint16_t edges[DSHOT_TELEMETRY_MAX_EDGES];
+    const int count = encodeEdges(encodeFrame((3 << 9) | 125), 65500, 2, edges);
+
+    EXPECT_EQ(60000u, dshotTelemetryDecodeEdges(edges, count, BIT_TICKS));
+}
+
+TEST(DshotTelemetryTest, TestTrailingIdle)
+{
+    uint16_t edges[DSHOT_TELEMETRY_MAX_EDGES];
+
+    // The line going back to idle adds an edge after the frame, the run up to it is cut at the frame end
+    int count = encodeEdges(encodeFrame((3 << 9) | 125), 0, 1, edges);
+    edges[count] = edges[count - 1] + 9 * BIT_TICKS;
+    EXPECT_EQ(60000u, dshotTelemetryDecodeEdges(edges, count + 1, BIT_TICKS));
+
+    // Edges after the frame end are ignored
+    edges[count + 1] = edges[count] + 2 * BIT_TICKS;
+    EXPECT_EQ(60000u, dshotTelemetryDecodeEdges(edges, count + 2, BIT_TICKS));
+}
+
+TEST(DshotTelemetryTest, TestRejectsBadFrames)
+{
+    uint16_t edges[DSHOT_TELEMETRY_MAX_EDGES];
+
+    // Checksum mismatch
+    int count = encodeEdges(encodeFrame((3 << 9) | 125, true), 0, 0, edges);
+    EXPECT_EQ(DSHOT_TELEMETRY_INVALID, dshotTelemetryDecodeEdges(edges, count, BIT_TICKS));
+
+    // Glitch shorter than half a bit
+    const uint16_t glitch[] = { 0, 4, 16 };
+    EXPECT_EQ(DSHOT_TELEMETRY_INVALID, dshotTelemetryEdgesToGcr(glitch, 3, BIT_TICKS));
+
+    // 00000 is not a GCR symbol
+    uint16_t frame;
+    EXPECT_FALSE(dshotTelemetryGcrToFrame(1 << 20, &frame));
+
+    // Zero period
+    EXPECT_EQ(DSHOT_TELEMETRY_INVALID, dshotTelemetryFrameToErpm(encodeFrame(1 << 9)));
+}
+
+TEST(DshotTelemetryTest, TestMotorState)
+{
+    const int count = sizeof(capturedEdges1000us) / sizeof(capturedEdges1000us[0]);
+    uint32_t erpm = 0;
+
+    dshotTelemetryEnable(true);
+    EXPECT_FALSE(dshotTelemetryGetErpm(0, 1000, &erpm));
+
+    dshotTelemetryProcessEdges(0, capturedEdges1000us, count, BIT_TICKS, 1000);
+    dshotTelemetryProcessEdges(0, capturedEdges1000us, 3, BIT_TICKS, 1100);
+
+    EXPECT_TRUE(dshotTelemetryGetErpm(0, 2000, &erpm));
+    EXPECT_EQ(60000u, erpm);
+
+    // Stale data is not reported
+    EXPECT_FALSE(dshotTelemetryGetErpm(0, 1000 + DSHOT_TELEMETRY_TIMEOUT_US + 1, &erpm));
+    EXPECT_FALSE(dshotTelemetryGetErpm(1, 2000, &erpm));
+
+    dshotTelemetryStats_t stats;
+    dshotTelemetryGetStats(0, &stats);
+    EXPECT_EQ(1u, stats.validFrames);
+    EXPECT_EQ(1u, stats.invalidFrames);
+}
@@ -0,0 +1,169 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+#include "flight/gain_schedule.h"
+}
+
+#include "gtest/gtest.h"
+
+// Piecewise bilinear evaluation of the configured table, what the compiled grid approximates
+static float referenceFactor(const gainScheduleConfig_t *config, float x, float y)
+{
+    float t[GAIN_SCHEDULE_INPUT_COUNT];
+    int k[GAIN_SCHEDULE_INPUT_COUNT];
+    const float value[GAIN_SCHEDULE_INPUT_COUNT] = { x, y };
+
+    for (int input = 0; input < GAIN_SCHEDULE_INPUT_COUNT; input++) {
+        const int16_t *bp = config->breakpoints[input];
+        float v = value[input];
+        if (config->source[input] == GAIN_SCHEDULE_SOURCE_NONE) {
+            v = bp[0];
+        }
+        v = v < bp[0] ? bp[0] : (v > bp[GAIN_SCHEDULE_POINTS - 1] ? bp[GAIN_SCHEDULE_POINTS - 1] : v);
+
+        k[input] = 0;
+        while (k[input] < GAIN_SCHEDULE_POINTS - 2 && v > bp[k[input] + 1]) {
+            k[input]++;
+        }
+        t[input] = (v - bp[k[input]]) / (bp[k[input] + 1] - bp[k[input]]);
+    }
+
+    const int kx = k[0], ky = k[1];
+    const float bottom = config->factor[ky][kx] + (config->factor[ky][kx + 1] - config->factor[ky][kx]) * t[0];
+    const float top = config->factor[ky + 1][kx] + (config->factor[ky + 1][kx + 1] - config->factor[ky + 1][kx]) * t[0];
+    return (bottom + (top - bottom) * t[1]) / 100.0f;
+}
+
+static void setupTable(gainScheduleConfig_t *config, const int16_t *xBreakpoints, const int16_t *yBreakpoints)
+{
+    memset(config, 0, sizeof(*config));
+    config->source[GAIN_SCHEDULE_INPUT_X] = GAIN_SCHEDULE_SOURCE_AIRSPEED;
+    config->source[GAIN_SCHEDULE_INPUT_Y] = GAIN_SCHEDULE_SOURCE_ALTITUDE;
+    memcpy(config->breakpoints[GAIN_SCHEDULE_INPUT_X], xBreakpoints, sizeof(config->breakpoints[0]));
+    memcpy(config->breakpoints[GAIN_SCHEDULE_INPUT_Y], yBreakpoints, sizeof(config->breakpoints[0]));
+
+    // Gains drop with airspeed and rise with altitude
+    for (int row = 0; row < GAIN_SCHEDULE_POINTS; row++) {
+        for (int col = 0; col < GAIN_SCHEDULE_POINTS; col++) {
+            config->factor[row][col] = 160 - col * 25 + row * 10 + ((row * col) % 3) * 5;
+        }
+    }
+}
+
+TEST(GainScheduleTest, TestDisabled)
+{
+    gainScheduleConfig_t config;
+    gainScheduleGrid_t grid;
+
+    gainScheduleResetConfig(&config);
+    EXPECT_FALSE(gainScheduleCompile(&grid, &config));
+    EXPECT_FLOAT_EQ(1.0f, gainScheduleLookup(&grid, 1500, 1500));
+
+    // A used input with breakpoints that do not increase disables the schedule
+    config.source[GAIN_SCHEDULE_INPUT_X] = GAIN_SCHEDULE_SOURCE_THROTTLE;
+    config.factor[0][0] = 50;
+    config.breakpoints[GAIN_SCHEDULE_INPUT_X][2] = config.breakpoints[GAIN_SCHEDULE_INPUT_X][1];
+    EXPECT_FALSE(gainScheduleCompile(&grid, &config));
+    EXPECT_FLOAT_EQ(1.0f, gainScheduleLookup(&grid, 1000, 1500));
+}
+
+TEST(GainScheduleTest, TestFactorLimits)
+{
+    const int16_t xBreakpoints[GAIN_SCHEDULE_POINTS] = { 1000, 1500, 2000, 2500, 3000 };
+    const int16_t yBreakpoints[GAIN_SCHEDULE_POINTS] = { 0, 100, 200, 300, 400 };
+    gainScheduleConfig_t config;
+    gainScheduleGrid_t grid;
+
+    // A stored table from before the limits, zero gains are raised to the minimum when applied and validated
+    setupTable(&config, xBreakpoints, yBreakpoints);
+    config.factor[0][0] = 0;
+    config.factor[4][4] = 255;
+    ASSERT_TRUE(gainScheduleCompile(&grid, &config));
+    EXPECT_FLOAT_EQ(GAIN_SCHEDULE_FACTOR_MIN / 100.0f, gainScheduleLookup(&grid, 1000, 0));
+    EXPECT_FLOAT_EQ(GAIN_SCHEDULE_FACTOR_MAX / 100.0f, gainScheduleLookup(&grid, 3000, 400));
+
+    gainScheduleValidateConfig(&config);
+    EXPECT_EQ(GAIN_SCHEDULE_FACTOR_MIN, config.factor[0][0]);
+    EXPECT_EQ(GAIN_SCHEDULE_FACTOR_MAX, config.factor[4][4]);
+}
+
+TEST(GainScheduleTest, TestUniformBreakpointsAreExact)
+{
+    // Breakpoints on grid nodes, the grid reproduces the table everywhere
+    const int16_t xBreakpoints[GAIN_SCHEDULE_POINTS] = { 1000, 1500, 2000, 2500, 3000 };
+    const int16_t yBreakpoints[GAIN_SCHEDULE_POINTS] = { 0, 100, 200, 300, 400 };
+    gainScheduleConfig_t config;
+    gainScheduleGrid_t grid;
+
+    setupTable(&config, xBreakpoints, yBreakpoints);
+    ASSERT_TRUE(gainScheduleCompile(&grid, &config));
+
+    for (float x = 900; x <= 3100; x += 37) {
+        for (float y = -20; y <= 420; y += 13) {
+            EXPECT_NEAR(referenceFactor(&config, x, y), gainScheduleLookup(&grid, x, y), 1e-4f) << "x " << x << " y " << y;
+        }
+    }
+}
+
+TEST(GainScheduleTest, TestNonUniformBreakpoints)
+{
+    const int16_t xBreakpoints[GAIN_SCHEDULE_POINTS] = { 1200, 1350, 1700, 2300, 3000 };
+    const int16_t yBreakpoints[GAIN_SCHEDULE_POINTS] = { 0, 50, 120, 500, 1000 };
+    gainScheduleConfig_t config;
+    gainScheduleGrid_t grid;
+
+    setupTable(&config, xBreakpoints, yBreakpoints);
+    ASSERT_TRUE(gainScheduleCompile(&grid, &config));
+
+    // Table corners and points outside the table are exact
+    EXPECT_NEAR(config.factor[0][0] / 100.0f, gainScheduleLookup(&grid, 1200, 0), 1e-4f);
+    EXPECT_NEAR(config.factor[4][4] / 100.0f, gainScheduleLookup(&grid, 3000, 1000), 1e-4f);
+    EXPECT_NEAR(config.factor[0][4] / 100.0f, gainScheduleLookup(&grid, 5000, -100), 1e-4f);
+
+    // Elsewhere the grid rounds the kinks between nodes, stays within a few percent of the table
+    float maxError = 0;
+    for (float x = 1200; x <= 3000; x += 11) {
+        for (float y = 0; y <= 1000; y += 7) {
+            const float error = fabsf(referenceFactor(&config, x, y) - gainScheduleLookup(&grid, x, y));
+            maxError = error > maxError ? error : maxError;
+        }
+    }
+    EXPECT_LT(maxError, 0.04f);
+}
+
+TEST(GainScheduleTest, TestSingleInput)
+{
+    const int16_t xBreakpoints[GAIN_SCHEDULE_POINTS] = { 1000, 1125, 1500, 1875, 2000 };
+    const int16_t yBreakpoints[GAIN_SCHEDULE_POINTS] = { 0, 0, 0, 0, 0 };
+    gainScheduleConfig_t config;
+    gainScheduleGrid_t grid;
+
+    setupTable(&config, xBreakpoints, yBreakpoints);
+    config.source[GAIN_SCHEDULE_INPUT_Y] = GAIN_SCHEDULE_SOURCE_NONE;
+    ASSERT_TRUE(gainScheduleCompile(&grid, &config));
+
+    // Breakpoints on grid nodes are exact, the unused input stays on the first row whatever its value
+    for (int col = 0; col < GAIN_SCHEDULE_POINTS; col++) {
+        EXPECT_NEAR(config.factor[0][col] / 100.0f, gainScheduleLookup(&grid, xBreakpoints[col], 12345), 1e-4f);
+    }
+    EXPECT_FLOAT_EQ(gainScheduleLookup(&grid, 1400, 0), gainScheduleLookup(&grid, 1400, -500));
+}
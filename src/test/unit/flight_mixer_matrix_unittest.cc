@@ -0,0 +1,259 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+extern "C" {
+#include "flight/mixer_matrix.h"
+}
+
+#include "gtest/gtest.h"
+
+#define THROTTLE_MIN    1070.0f
+#define THROTTLE_MAX    2000.0f
+#define CLIPPING_FACTOR 0.33f
+
+static const motorMixer_t quadX[] = {
+    { 1.0f, -1.0f,  1.0f, -1.0f },
+    { 1.0f, -1.0f, -1.0f,  1.0f },
+    { 1.0f,  1.0f,  1.0f,  1.0f },
+    { 1.0f,  1.0f, -1.0f, -1.0f },
+};
+
+static const motorMixer_t hexX[] = {
+    { 1.0f, -0.5f,  0.866025f,  1.0f },
+    { 1.0f, -0.5f, -0.866025f,  1.0f },
+    { 1.0f,  0.5f,  0.866025f, -1.0f },
+    { 1.0f,  0.5f, -0.866025f, -1.0f },
+    { 1.0f, -1.0f,  0.0f,      -1.0f },
+    { 1.0f,  1.0f,  0.0f,       1.0f },
+};
+
+static const motorMixer_t octoFlatX[] = {
+    { 1.0f,  1.0f, -0.414178f,  1.0f },
+    { 1.0f, -0.414178f, -1.0f, -1.0f },
+    { 1.0f, -1.0f,  0.414178f,  1.0f },
+    { 1.0f,  0.414178f,  1.0f, -1.0f },
+    { 1.0f,  0.414178f, -1.0f,  1.0f },
+    { 1.0f, -1.0f, -0.414178f, -1.0f },
+    { 1.0f, -0.414178f,  1.0f,  1.0f },
+    { 1.0f,  1.0f,  0.414178f, -1.0f },
+};
+
+static const motorMixer_t octoX8[] = {
+    { 1.0f, -1.0f,  1.0f, -1.0f },
+    { 1.0f, -1.0f, -1.0f,  1.0f },
+    { 1.0f,  1.0f,  1.0f,  1.0f },
+    { 1.0f,  1.0f, -1.0f, -1.0f },
+    { 1.0f, -1.0f,  1.0f,  1.0f },
+    { 1.0f, -1.0f, -1.0f, -1.0f },
+    { 1.0f,  1.0f,  1.0f, -1.0f },
+    { 1.0f,  1.0f, -1.0f,  1.0f },
+};
+
+static const struct {
+    const char *name;
+    const motorMixer_t *rules;
+    uint8_t motorCount;
+} layouts[] = {
+    { "quad X", quadX, 4 },
+    { "hex X", hexX, 6 },
+    { "octo flat X", octoFlatX, 8 },
+    { "octo X8", octoX8, 8 },
+};
+
+static float mixMotor(const mixerMatrix_t *matrix, const float *rpyMix, const mixerDesaturation_t *desaturation, float throttle, int motor)
+{
+    const float motorThrottle = throttle * matrix->throttle[motor];
+    const float constrained = motorThrottle < desaturation->throttleMin ? desaturation->throttleMin :
+        (motorThrottle > desaturation->throttleMax ? desaturation->throttleMax : motorThrottle);
+    return rpyMix[motor] + constrained;
+}
+
+TEST(MixerMatrixTest, TestCompile)
+{
+    mixerMatrix_t matrix;
+    mixerMatrixCompile(&matrix, quadX, 4, 0.5f, -1.0f);
+
+    EXPECT_EQ(4, matrix.motorCount);
+    EXPECT_FLOAT_EQ(1.0f, matrix.throttle[0]);
+    EXPECT_FLOAT_EQ(-0.5f, matrix.roll[0]);
+    EXPECT_FLOAT_EQ(0.5f, matrix.pitch[0]);
+    EXPECT_FLOAT_EQ(0.5f, matrix.yaw[0]);
+    EXPECT_FLOAT_EQ(0.0f, matrix.roll[4]);
+}
+
+TEST(MixerMatrixTest, TestApplyRPY)
+{
+    mixerMatrix_t matrix;
+    mixerMatrixCompile(&matrix, quadX, 4, 1.0f, -1.0f);
+
+    float rpyMix[MAX_SUPPORTED_MOTORS];
+    float rpyMixMin, rpyMixMax;
+    mixerMatrixApplyRPY(&matrix, 100, 50, 20, rpyMix, &rpyMixMin, &rpyMixMax);
+
+    EXPECT_FLOAT_EQ(-100 + 50 + 20, rpyMix[0]);
+    EXPECT_FLOAT_EQ(-100 - 50 - 20, rpyMix[1]);
+    EXPECT_FLOAT_EQ(100 + 50 - 20, rpyMix[2]);
+    EXPECT_FLOAT_EQ(100 - 50 + 20, rpyMix[3]);
+    EXPECT_FLOAT_EQ(-170, rpyMixMin);
+    EXPECT_FLOAT_EQ(130, rpyMixMax);
+}
+
+TEST(MixerMatrixTest, TestNoSaturation)
+{
+    for (const auto &layout : layouts) {
+        mixerMatrix_t matrix;
+        mixerMatrixCompile(&matrix, layout.rules, layout.motorCount, 1.0f, -1.0f);
+
+        float rpyMix[MAX_SUPPORTED_MOTORS];
+        float rpyMixMin, rpyMixMax;
+        mixerMatrixApplyRPY(&matrix, 80, -60, 40, rpyMix, &rpyMixMin, &rpyMixMax);
+
+        float expected[MAX_SUPPORTED_MOTORS];
+        memcpy(expected, rpyMix, sizeof(expected));
+
+        mixerDesaturation_t desaturation;
+        mixerDesaturate(rpyMix, layout.motorCount, rpyMixMin, rpyMixMax, THROTTLE_MIN, THROTTLE_MAX, CLIPPING_FACTOR, &desaturation);
+
+        EXPECT_LT(desaturation.mixRange, 1.0f) << layout.name;
+
+        // Corrections fit, they are kept as they are and no motor clips at low or high throttle
+        for (const float throttle : { THROTTLE_MIN, THROTTLE_MAX }) {
+            for (int i = 0; i < layout.motorCount; i++) {
+                EXPECT_FLOAT_EQ(expected[i], rpyMix[i]) << layout.name;
+                const float output = mixMotor(&matrix, rpyMix, &desaturation, throttle, i);
+                EXPECT_GE(output, THROTTLE_MIN - 0.01f) << layout.name << " motor " << i;
+                EXPECT_LE(output, THROTTLE_MAX + 0.01f) << layout.name << " motor " << i;
+            }
+        }
+    }
+}
+
+TEST(MixerMatrixTest, TestAsymmetricMixUsesAllHeadroom)
+{
+    // Yaw only raises the first two motors, throttle may go all the way down but not up
+    const motorMixer_t lifted[] = {
+        { 1.0f, 0.0f, 0.0f, 1.0f },
+        { 1.0f, 0.0f, 0.0f, 1.0f },
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+    };
+
+    mixerMatrix_t matrix;
+    mixerMatrixCompile(&matrix, lifted, 4, 1.0f, 1.0f);
+
+    float rpyMix[MAX_SUPPORTED_MOTORS];
+    float rpyMixMin, rpyMixMax;
+    mixerMatrixApplyRPY(&matrix, 0, 0, 300, rpyMix, &rpyMixMin, &rpyMixMax);
+    EXPECT_FLOAT_EQ(0, rpyMixMin);
+    EXPECT_FLOAT_EQ(300, rpyMixMax);
+
+    mixerDesaturation_t desaturation;
+    mixerDesaturate(rpyMix, 4, rpyMixMin, rpyMixMax, THROTTLE_MIN, THROTTLE_MAX, CLIPPING_FACTOR, &desaturation);
+
+    EXPECT_FLOAT_EQ(THROTTLE_MIN, desaturation.throttleMin);
+    EXPECT_FLOAT_EQ(THROTTLE_MAX - 300, desaturation.throttleMax);
+}
+
+TEST(MixerMatrixTest, TestSaturation)
+{
+    for (const auto &layout : layouts) {
+        mixerMatrix_t matrix;
+        mixerMatrixCompile(&matrix, layout.rules, layout.motorCount, 1.0f, -1.0f);
+
+        float rpyMix[MAX_SUPPORTED_MOTORS];
+        float rpyMixMin, rpyMixMax;
+        mixerMatrixApplyRPY(&matrix, 500, 500, 500, rpyMix, &rpyMixMin, &rpyMixMax);
+
+        mixerDesaturation_t desaturation;
+        mixerDesaturate(rpyMix, layout.motorCount, rpyMixMin, rpyMixMax, THROTTLE_MIN, THROTTLE_MAX, CLIPPING_FACTOR, &desaturation);
+
+        EXPECT_GT(desaturation.mixRange, 1.0f) << layout.name;
+
+        // The mix is scaled down to exactly the throttle range
+        float scaledMin = 0, scaledMax = 0;
+        for (int i = 0; i < layout.motorCount; i++) {
+            scaledMin = std::min(scaledMin, rpyMix[i]);
+            scaledMax = std::max(scaledMax, rpyMix[i]);
+        }
+        EXPECT_NEAR(THROTTLE_MAX - THROTTLE_MIN, scaledMax - scaledMin, 0.01f) << layout.name;
+
+        // Throttle is held to the clipping window around mid range
+        const float center = (THROTTLE_MIN + THROTTLE_MAX) / 2;
+        const float window = (THROTTLE_MAX - THROTTLE_MIN) * CLIPPING_FACTOR / 2;
+        EXPECT_FLOAT_EQ(center - window, desaturation.throttleMin) << layout.name;
+        EXPECT_FLOAT_EQ(center + window, desaturation.throttleMax) << layout.name;
+    }
+}
+
+TEST(MixerMatrixTest, TestSaturatedAsymmetricMixKeepsClippingWindow)
+{
+    // A saturated mix that only lifts motors would fit at low throttle, the window still stays around mid range
+    const motorMixer_t lifted[] = {
+        { 1.0f, 0.0f, 0.0f, 1.0f },
+        { 1.0f, 0.0f, 0.0f, 1.0f },
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+    };
+
+    mixerMatrix_t matrix;
+    mixerMatrixCompile(&matrix, lifted, 4, 1.0f, 1.0f);
+
+    float rpyMix[MAX_SUPPORTED_MOTORS];
+    float rpyMixMin, rpyMixMax;
+    mixerMatrixApplyRPY(&matrix, 0, 0, 1500, rpyMix, &rpyMixMin, &rpyMixMax);
+
+    mixerDesaturation_t desaturation;
+    mixerDesaturate(rpyMix, 4, rpyMixMin, rpyMixMax, THROTTLE_MIN, THROTTLE_MAX, CLIPPING_FACTOR, &desaturation);
+
+    const float center = (THROTTLE_MIN + THROTTLE_MAX) / 2;
+    const float window = (THROTTLE_MAX - THROTTLE_MIN) * CLIPPING_FACTOR / 2;
+    EXPECT_FLOAT_EQ(center - window, desaturation.throttleMin);
+    EXPECT_FLOAT_EQ(center + window, desaturation.throttleMax);
+    EXPECT_FLOAT_EQ(THROTTLE_MAX - THROTTLE_MIN, rpyMix[0]);
+}
+
+TEST(MixerMatrixTest, TestBenchmark)
+{
+    // Times the kernel per layout for the test report (--gtest_output=xml), does not fail on timing
+    for (const auto &layout : layouts) {
+        mixerMatrix_t matrix;
+        mixerMatrixCompile(&matrix, layout.rules, layout.motorCount, 1.0f, -1.0f);
+
+        const int iterations = 100000;
+        float rpyMix[MAX_SUPPORTED_MOTORS];
+        float checksum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int n = 0; n < iterations; n++) {
+            float rpyMixMin, rpyMixMax;
+            mixerDesaturation_t desaturation;
+            mixerMatrixApplyRPY(&matrix, n % 1000 - 500, (n * 7) % 1000 - 500, (n * 13) % 1000 - 500, rpyMix, &rpyMixMin, &rpyMixMax);
+            mixerDesaturate(rpyMix, layout.motorCount, rpyMixMin, rpyMixMax, THROTTLE_MIN, THROTTLE_MAX, CLIPPING_FACTOR, &desaturation);
+            checksum += rpyMix[0] + desaturation.throttleMin;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        RecordProperty(std::string(layout.name) + " ns/update", (int)(elapsed.count() / iterations));
+        EXPECT_TRUE(checksum == checksum);
+    }
+}
@@ -0,0 +1,143 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <cstdint>
+
+extern "C" {
+#include "flight/system_identification.h"
+}
+
+#include "gtest/gtest.h"
+
+#define LOOP_DT         0.001f
+#define PLANT_GAIN      0.5f
+#define PLANT_DELAY     2       // loops
+#define STICK_OFFSET    30.0f   // deg/s the pilot commands during the sweep
+
+static float wrapDegrees(float angle)
+{
+    while (angle > 180) angle -= 360;
+    while (angle < -180) angle += 360;
+    return angle;
+}
+
+// Runs a sweep on a plant that is a pure gain with a few loops of delay, the PID output is twice the setpoint
+static void runSweep(uint8_t axis, int loops, int abortAtLoop = -1)
+{
+    float history[PLANT_DELAY + 1] = { 0 };
+
+    for (int n = 0; n < loops; n++) {
+        systemIdUpdate(n != abortAtLoop, LOOP_DT);
+        if (n == abortAtLoop) {
+            return;
+        }
+
+        for (int a = 0; a < 3; a++) {
+            const float setpoint = (a == axis ? STICK_OFFSET : 0) + systemIdGetExcitation(a);
+
+            if (a == axis) {
+                for (int i = PLANT_DELAY; i > 0; i--) {
+                    history[i] = history[i - 1];
+                }
+                history[0] = setpoint;
+            }
+
+            systemIdSample(a, setpoint, PLANT_GAIN * history[PLANT_DELAY], 2 * setpoint);
+        }
+    }
+
+    systemIdUpdate(false, LOOP_DT);
+}
+
+class SystemIdTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        systemIdConfigMutable()->axis = 1;
+        systemIdConfigMutable()->amplitude = 100;
+        systemIdConfigMutable()->minHz = 2;
+        systemIdConfigMutable()->maxHz = 100;
+        systemIdConfigMutable()->duration = 20;
+        systemIdUpdate(false, LOOP_DT);
+    }
+};
+
+TEST_F(SystemIdTest, TestExcitation)
+{
+    systemIdUpdate(true, LOOP_DT);
+
+    EXPECT_EQ(SYSTEM_ID_RUNNING, systemIdGetState());
+    EXPECT_EQ(1, systemIdGetAxis());
+    EXPECT_EQ(0.0f, systemIdGetExcitation(0));
+
+    float peak = 0;
+    for (int n = 0; n < 1000; n++) {
+        systemIdUpdate(true, LOOP_DT);
+        peak = fmaxf(peak, fabsf(systemIdGetExcitation(1)));
+        EXPECT_EQ(0.0f, systemIdGetExcitation(2));
+    }
+    EXPECT_NEAR(100.0f, peak, 1.0f);
+}
+
+TEST_F(SystemIdTest, TestFrequencyResponse)
+{
+    runSweep(1, 20 / LOOP_DT + 10);
+
+    EXPECT_EQ(SYSTEM_ID_DONE, systemIdGetState());
+    EXPECT_EQ(100, systemIdGetProgress());
+
+    float lastFrequency = 0;
+    for (int bin = 0; bin < SYSTEM_ID_BIN_COUNT; bin++) {
+        systemIdBinResult_t result;
+        ASSERT_TRUE(systemIdGetBin(bin, &result));
+
+        EXPECT_GT(result.frequencyHz, lastFrequency);
+        EXPECT_GE(result.frequencyHz, 2.0f);
+        EXPECT_LE(result.frequencyHz, 100.0f);
+        lastFrequency = result.frequencyHz;
+
+        const float expectedPhase = -360.0f * result.frequencyHz * PLANT_DELAY * LOOP_DT;
+
+        EXPECT_NEAR(PLANT_GAIN, result.closedLoopGain, 0.02f) << "bin " << bin;
+        EXPECT_NEAR(0.0f, wrapDegrees(result.closedLoopPhase - expectedPhase), 5.0f) << "bin " << bin;
+        EXPECT_NEAR(PLANT_GAIN / 2, result.plantGain, 0.01f) << "bin " << bin;
+        EXPECT_NEAR(0.0f, wrapDegrees(result.plantPhase - expectedPhase), 5.0f) << "bin " << bin;
+    }
+}
+
+TEST_F(SystemIdTest, TestAbort)
+{
+    runSweep(1, 20 / LOOP_DT, 5000);
+
+    EXPECT_EQ(SYSTEM_ID_ABORTED, systemIdGetState());
+    EXPECT_EQ(25, systemIdGetProgress());
+    EXPECT_EQ(0.0f, systemIdGetExcitation(1));
+
+    systemIdBinResult_t result;
+    EXPECT_TRUE(systemIdGetBin(0, &result));
+    EXPECT_FALSE(systemIdGetBin(SYSTEM_ID_BIN_COUNT - 1, &result));
+}
+
+TEST_F(SystemIdTest, TestRejectsBadRange)
+{
+    EXPECT_FALSE(systemIdStart(0, 100, 50, 40, 10, LOOP_DT));
+    EXPECT_FALSE(systemIdStart(3, 100, 2, 100, 10, LOOP_DT));
+
+    // The end frequency is limited by the loop rate
+    EXPECT_FALSE(systemIdStart(0, 100, 2, 400, 10, 1.0f / 10));
+    EXPECT_TRUE(systemIdStart(0, 100, 1, 400, 10, 1.0f / 10));
+}
@@ -19,9 +19,13 @@
 #include "gtest/gtest.h"
 #include "unittest_macros.h"
 
+#include <chrono>
 #include <iostream>
+#include <random>
 #include <string>
+#include <vector>
 #include <stdio.h>
+#include <string.h>
 
 #include "io/gps_ublox_utils.h"
 
@@ -87,4 +91,209 @@ TEST(GPSUbloxTest, TestUbloxCfgFillBytes)
     // osdFormatCentiNumber(buf, 12345, 1, 2, 3, 7);
     // std::cout << "'" << buf << "'" << std::endl;
     //EXPECT_FALSE(strcmp(buf, " 123.45"));
-}
\ No newline at end of file
+}
+
+struct TestFrame {
+    uint8_t msgClass;
+    uint8_t msgId;
+    std::vector<uint8_t> payload;
+};
+
+static std::vector<uint8_t> encodeFrame(const TestFrame &frame)
+{
+    std::vector<uint8_t> bytes = {
+        0xB5, 0x62, frame.msgClass, frame.msgId,
+        (uint8_t)(frame.payload.size() & 0xFF), (uint8_t)(frame.payload.size() >> 8)
+    };
+    bytes.insert(bytes.end(), frame.payload.begin(), frame.payload.end());
+
+    uint8_t ck_a, ck_b;
+    ublox_update_checksum(&bytes[2], bytes.size() - 2, &ck_a, &ck_b);
+    bytes.push_back(ck_a);
+    bytes.push_back(ck_b);
+
+    return bytes;
+}
+
+static TestFrame randomFrame(std::mt19937 &rng, uint16_t maxLength)
+{
+    TestFrame frame;
+    frame.msgClass = rng() & 0xFF;
+    frame.msgId = rng() & 0xFF;
+    frame.payload.resize(rng() % (maxLength + 1));
+    for (auto &b : frame.payload) {
+        b = rng() & 0xFF;
+    }
+    return frame;
+}
+
+// Copies bytes into the parser the way the receiver thread does, returns how many fit
+static uint16_t appendBytes(ubxParser_t *parser, const uint8_t *data, uint16_t length)
+{
+    uint16_t space;
+    uint8_t *dst = ubxParserGetWriteBuffer(parser, &space);
+
+    length = std::min(length, space);
+    memcpy(dst, data, length);
+    ubxParserCommitWrite(parser, length);
+
+    return length;
+}
+
+// Feeds the stream in chunks of random size and collects every frame the parser returns
+static std::vector<TestFrame> parseStream(ubxParser_t *parser, const std::vector<uint8_t> &stream, std::mt19937 &rng, size_t maxChunk)
+{
+    std::vector<TestFrame> frames;
+    size_t offset = 0;
+
+    while (offset < stream.size()) {
+        const size_t chunk = std::min(stream.size() - offset, 1 + rng() % maxChunk);
+        offset += appendBytes(parser, &stream[offset], chunk);
+
+        ubxFrame_t frame;
+        while (ubxParserNextFrame(parser, &frame)) {
+            frames.push_back({ frame.msgClass, frame.msgId, std::vector<uint8_t>(frame.payload, frame.payload + frame.length) });
+        }
+    }
+
+    return frames;
+}
+
+static void expectSameFrames(const std::vector<TestFrame> &expected, const std::vector<TestFrame> &actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i].msgClass, actual[i].msgClass);
+        EXPECT_EQ(expected[i].msgId, actual[i].msgId);
+        EXPECT_EQ(expected[i].payload, actual[i].payload);
+    }
+}
+
+TEST(GPSUbloxTest, TestParserSingleFrame)
+{
+    ubxParser_t parser;
+    ubxParserInit(&parser);
+
+    // UBX-ACK-ACK for CFG-MSG
+    const uint8_t ack[] = { 0xB5, 0x62, 0x05, 0x01, 0x02, 0x00, 0x06, 0x01, 0x0F, 0x38 };
+    ubxFrame_t frame;
+
+    // Incomplete frame is kept until the rest arrives
+    EXPECT_EQ(5, appendBytes(&parser, ack, 5));
+    EXPECT_FALSE(ubxParserNextFrame(&parser, &frame));
+
+    EXPECT_EQ(5, appendBytes(&parser, ack + 5, 5));
+    ASSERT_TRUE(ubxParserNextFrame(&parser, &frame));
+    EXPECT_EQ(0x05, frame.msgClass);
+    EXPECT_EQ(0x01, frame.msgId);
+    EXPECT_EQ(2, frame.length);
+    EXPECT_EQ(0x06, frame.payload[0]);
+    EXPECT_EQ(0x01, frame.payload[1]);
+    EXPECT_EQ(0, (uintptr_t)frame.payload & 3);
+
+    EXPECT_FALSE(ubxParserNextFrame(&parser, &frame));
+    EXPECT_EQ(1u, parser.frames);
+    EXPECT_EQ(0u, parser.errors);
+}
+
+TEST(GPSUbloxTest, TestParserRejectsBadChecksumAndLength)
+{
+    ubxParser_t parser;
+    ubxParserInit(&parser);
+
+    std::mt19937 rng(1);
+    TestFrame good = { 0x01, 0x07, std::vector<uint8_t>(92, 0x55) };
+    std::vector<uint8_t> corrupted = encodeFrame(good);
+    corrupted[20] ^= 0x01;
+
+    // Length above what we can receive
+    std::vector<uint8_t> tooLong = { 0xB5, 0x62, 0x01, 0x35, 0x00, 0x04 };
+
+    std::vector<uint8_t> stream = corrupted;
+    stream.insert(stream.end(), tooLong.begin(), tooLong.end());
+    const std::vector<uint8_t> goodBytes = encodeFrame(good);
+    stream.insert(stream.end(), goodBytes.begin(), goodBytes.end());
+
+    expectSameFrames({ good }, parseStream(&parser, stream, rng, 64));
+    EXPECT_EQ(2u, parser.errors);
+}
+
+TEST(GPSUbloxTest, TestParserFuzz)
+{
+    std::mt19937 rng(0x1234);
+
+    for (int run = 0; run < 200; run++) {
+        ubxParser_t parser;
+        ubxParserInit(&parser);
+
+        std::vector<TestFrame> expected;
+        std::vector<uint8_t> stream;
+
+        for (int i = 0; i < 20; i++) {
+            // Line noise between frames, biased towards sync bytes
+            const int noise = rng() % 16;
+            for (int n = 0; n < noise; n++) {
+                const uint32_t r = rng();
+                stream.push_back((r & 0x300) == 0 ? 0xB5 : ((r & 0x300) == 0x100 ? 0x62 : (r & 0xFF)));
+            }
+
+            TestFrame frame = randomFrame(rng, MAX_UBLOX_PAYLOAD_SIZE);
+            std::vector<uint8_t> bytes = encodeFrame(frame);
+
+            if (rng() % 8 == 0) {
+                // Damaged frame, must not be returned
+                bytes[rng() % bytes.size()] ^= 1 << (rng() % 8);
+                stream.insert(stream.end(), bytes.begin(), bytes.end() - (rng() % 4));
+            } else {
+                expected.push_back(frame);
+                stream.insert(stream.end(), bytes.begin(), bytes.end());
+            }
+        }
+
+        // Idle line at the end, so a fake header near the end of the stream gets resolved too
+        stream.insert(stream.end(), MAX_UBLOX_PAYLOAD_SIZE + 8, 0);
+
+        // A damaged frame can claim a length that swallows the frames after it, those are found again
+        // after the resync, so everything that went in intact must come out in order
+        const std::vector<TestFrame> actual = parseStream(&parser, stream, rng, 300);
+        expectSameFrames(expected, actual);
+    }
+}
+
+TEST(GPSUbloxTest, TestParserBenchmark)
+{
+    // One second of M10 output at 25Hz: NAV-PVT, NAV-SAT with 20 satellites, NAV-SIG with 15 signals
+    std::mt19937 rng(7);
+    std::vector<uint8_t> second;
+    int framesPerSecond = 0;
+
+    for (int i = 0; i < 25; i++) {
+        const TestFrame pvt = { 0x01, 0x07, std::vector<uint8_t>(92, 0x11) };
+        const TestFrame sat = { 0x01, 0x35, std::vector<uint8_t>(8 + 12 * 20, 0x22) };
+        const TestFrame sig = { 0x01, 0x43, std::vector<uint8_t>(8 + 16 * 15, 0x33) };
+
+        for (const TestFrame &frame : { pvt, sat, sig }) {
+            const std::vector<uint8_t> bytes = encodeFrame(frame);
+            second.insert(second.end(), bytes.begin(), bytes.end());
+            framesPerSecond++;
+        }
+    }
+
+    ubxParser_t parser;
+    ubxParserInit(&parser);
+
+    const int seconds = 200;
+    size_t frames = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int s = 0; s < seconds; s++) {
+        frames += parseStream(&parser, second, rng, 64).size();
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+
+    EXPECT_EQ((size_t)framesPerSecond * seconds, frames);
+    EXPECT_EQ(0u, parser.errors);
+
+    // Goes to the test report (--gtest_output=xml) rather than the console
+    RecordProperty("bytes", (int)(second.size() * seconds));
+    RecordProperty("elapsed_us", (int)elapsed);
+}
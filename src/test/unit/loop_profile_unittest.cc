@@ -0,0 +1,173 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+
+extern "C" {
+#include "build/debug.h"
+#include "fc/loop_profile.h"
+
+// 100 ticks per microsecond, 10ns per tick
+uint32_t usTicks = 100;
+int32_t debug[DEBUG32_VALUE_COUNT];
+uint8_t debugMode;
+
+static uint32_t fakeTicks;
+
+uint32_t ticks(void)
+{
+    return fakeTicks;
+}
+
+uint32_t getLooptime(void)
+{
+    return 1000;
+}
+}
+
+#include "gtest/gtest.h"
+
+// Runs one loop where the PID stage takes pidTicks and every other stage 100 ticks
+static void runLoop(uint32_t pidTicks)
+{
+    loopProfileBegin();
+    for (int stage = 0; stage < LOOP_STAGE_COUNT; stage++) {
+        fakeTicks += (stage == LOOP_STAGE_PID) ? pidTicks : 100;
+        loopProfileMark((loopStage_e)stage);
+    }
+    loopProfileEnd();
+}
+
+TEST(LoopProfileTest, TestStageAttribution)
+{
+    loopProfileReset();
+    fakeTicks = UINT32_MAX - 500;   // Counter wraps during the loop
+
+    loopProfileBegin();
+    fakeTicks += 200;
+    loopProfileMark(LOOP_STAGE_GYRO);
+    fakeTicks += 300;
+    loopProfileMark(LOOP_STAGE_NAVIGATION);
+    fakeTicks += 1000;
+    loopProfileMark(LOOP_STAGE_PID);
+    fakeTicks += 50;
+    loopProfileMark(LOOP_STAGE_NAVIGATION);
+    loopProfileEnd();
+
+    loopStageStats_t stats;
+    loopProfileGetStats(LOOP_STAGE_GYRO, &stats);
+    EXPECT_EQ(2000u, stats.minNs);
+    EXPECT_EQ(2000u, stats.avgNs);
+    EXPECT_EQ(2000u, stats.maxNs);
+
+    // A stage marked twice gets both parts
+    loopProfileGetStats(LOOP_STAGE_NAVIGATION, &stats);
+    EXPECT_EQ(3500u, stats.avgNs);
+
+    loopProfileGetStats(LOOP_STAGE_TOTAL, &stats);
+    EXPECT_EQ(15500u, stats.avgNs);
+    EXPECT_EQ(15500u, stats.worstLoopNs);
+
+    loopProfileGetStats(LOOP_STAGE_OUTPUT, &stats);
+    EXPECT_EQ(0u, stats.maxNs);
+
+    EXPECT_EQ(1u, loopProfileGetLoopCount());
+    EXPECT_EQ(0u, loopProfileGetOverrunCount());
+}
+
+TEST(LoopProfileTest, TestPercentile)
+{
+    loopStageStats_t stats;
+
+    loopProfileReset();
+    for (int i = 0; i < 1000; i++) {
+        runLoop(i % 200 == 0 ? 20000 : 1000);
+    }
+
+    // 0.5% of slow loops do not move the 99th percentile, it stays within the bucket of the common case
+    loopProfileGetStats(LOOP_STAGE_PID, &stats);
+    EXPECT_EQ(10000u, stats.minNs);
+    EXPECT_EQ(200000u, stats.maxNs);
+    EXPECT_EQ(10950u, stats.avgNs);
+    EXPECT_GE(stats.p99Ns, 10000u);
+    EXPECT_LE(stats.p99Ns, 12500u);
+
+    // 2% do
+    loopProfileReset();
+    for (int i = 0; i < 1000; i++) {
+        runLoop(i % 50 == 0 ? 20000 : 1000);
+    }
+    loopProfileGetStats(LOOP_STAGE_PID, &stats);
+    EXPECT_GE(stats.p99Ns, 200000u);
+    EXPECT_LE(stats.p99Ns, 250000u);
+}
+
+TEST(LoopProfileTest, TestOverrunsAndWorstLoop)
+{
+    loopStageStats_t stats;
+
+    loopProfileReset();
+    runLoop(1000);
+    runLoop(120000);    // 1.2ms in a 1ms loop
+    runLoop(1000);
+
+    EXPECT_EQ(3u, loopProfileGetLoopCount());
+    EXPECT_EQ(1u, loopProfileGetOverrunCount());
+
+    loopProfileGetStats(LOOP_STAGE_PID, &stats);
+    EXPECT_EQ(1200000u, stats.worstLoopNs);
+    loopProfileGetStats(LOOP_STAGE_GYRO, &stats);
+    EXPECT_EQ(1000u, stats.worstLoopNs);
+    loopProfileGetStats(LOOP_STAGE_TOTAL, &stats);
+    EXPECT_EQ(1209000u, stats.worstLoopNs);
+}
+
+TEST(LoopProfileTest, TestDecay)
+{
+    loopStageStats_t stats;
+
+    loopProfileReset();
+    for (int i = 0; i < 40000; i++) {
+        runLoop(5000);
+    }
+    // Every halving of the statistics leaves half as many of the old loops
+    for (int i = 0; i < 200000; i++) {
+        runLoop(1000);
+    }
+
+    // Average and percentile follow the recent loops, min and max cover everything since the reset
+    loopProfileGetStats(LOOP_STAGE_PID, &stats);
+    EXPECT_EQ(240000u, loopProfileGetLoopCount());
+    EXPECT_EQ(10000u, stats.minNs);
+    EXPECT_EQ(50000u, stats.maxNs);
+    EXPECT_LT(stats.avgNs, 15000u);
+    EXPECT_LE(stats.p99Ns, 12500u);
+}
+
+TEST(LoopProfileTest, TestDebugMode)
+{
+    loopProfileReset();
+    debugMode = DEBUG_LOOP_PROFILE;
+    runLoop(3000);
+    debugMode = DEBUG_NONE;
+
+    EXPECT_EQ(1000, debug[0]);     // GYRO
+    EXPECT_EQ(2000, debug[3]);     // POSITION and NAVIGATION
+    EXPECT_EQ(30000, debug[4]);    // PID
+    EXPECT_EQ(3000, debug[5]);     // MIXER, SERVOS and OUTPUT
+    EXPECT_EQ(39000, debug[7]);    // TOTAL
+}
@@ -27,6 +27,7 @@
 extern "C" {
     #include "common/maths.h"
     #include "common/vector.h"
+    #include "common/quaternion.h"
 }
 
 #include "unittest_macros.h"
@@ -153,6 +154,27 @@ TEST(MathsUnittest, TestRotateVectorAroundAxis)
     expectVectorsAreEqual(&vector, &expected_result);
 }
 
+TEST(MathsUnittest, TestQuaternionToRotationMatrix)
+{
+    // Rotation matrix must give the same result as rotating by the quaternion directly
+    fpQuaternion_t q = { 0.8f, 0.2f, -0.4f, 0.3f };
+    quaternionNormalize(&q, &q);
+
+    float rmat[3][3];
+    quaternionToRotationMatrix(rmat, &q);
+
+    const fpVector3_t vectors[] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.3f, -1.2f, 2.5f } };
+
+    for (unsigned i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        fpVector3_t expected;
+        quaternionRotateVectorInv(&expected, &vectors[i], &q);
+
+        EXPECT_NEAR(rmat[0][0] * vectors[i].x + rmat[0][1] * vectors[i].y + rmat[0][2] * vectors[i].z, expected.x, 1e-6);
+        EXPECT_NEAR(rmat[1][0] * vectors[i].x + rmat[1][1] * vectors[i].y + rmat[1][2] * vectors[i].z, expected.y, 1e-6);
+        EXPECT_NEAR(rmat[2][0] * vectors[i].x + rmat[2][1] * vectors[i].y + rmat[2][2] * vectors[i].z, expected.z, 1e-6);
+    }
+}
+
 #if defined(FAST_MATH) || defined(VERY_FAST_MATH)
 TEST(MathsUnittest, TestFastTrigonometrySinCos)
 {
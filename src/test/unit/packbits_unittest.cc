@@ -0,0 +1,118 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+#include "common/packbits.h"
+}
+
+#include "gtest/gtest.h"
+
+static void expectRoundTrip(const uint8_t *data, size_t len)
+{
+    uint8_t encoded[PACKBITS_MAX_ENCODED_SIZE(1024)];
+    uint8_t decoded[1024];
+
+    const int encodedLen = packbitsEncode(data, len, encoded, sizeof(encoded));
+    ASSERT_GE(encodedLen, 0);
+    EXPECT_LE((size_t)encodedLen, PACKBITS_MAX_ENCODED_SIZE(len));
+
+    const int decodedLen = packbitsDecode(encoded, encodedLen, decoded, sizeof(decoded));
+    ASSERT_EQ((int)len, decodedLen);
+    EXPECT_EQ(0, memcmp(data, decoded, len));
+}
+
+TEST(PackbitsTest, TestRun)
+{
+    uint8_t data[300];
+    memset(data, 0xFF, sizeof(data));
+
+    uint8_t encoded[16];
+    const int encodedLen = packbitsEncode(data, sizeof(data), encoded, sizeof(encoded));
+
+    // 128 + 128 + 44
+    EXPECT_EQ(6, encodedLen);
+    EXPECT_EQ(0x81, encoded[0]);
+    EXPECT_EQ(0xFF, encoded[1]);
+
+    expectRoundTrip(data, sizeof(data));
+}
+
+TEST(PackbitsTest, TestLiterals)
+{
+    const uint8_t data[] = { 1, 2, 3, 3, 4, 5 };
+
+    uint8_t encoded[16];
+    const int encodedLen = packbitsEncode(data, sizeof(data), encoded, sizeof(encoded));
+
+    // Two equal bytes are not worth a run
+    EXPECT_EQ(7, encodedLen);
+    EXPECT_EQ(5, encoded[0]);
+
+    expectRoundTrip(data, sizeof(data));
+}
+
+TEST(PackbitsTest, TestMixed)
+{
+    const uint8_t data[] = { 7, 8, 0, 0, 0, 0, 0, 9, 9, 9, 10 };
+
+    uint8_t encoded[16];
+    const int encodedLen = packbitsEncode(data, sizeof(data), encoded, sizeof(encoded));
+
+    const uint8_t expected[] = { 1, 7, 8, 0xFC, 0, 0xFE, 9, 0, 10 };
+    ASSERT_EQ((int)sizeof(expected), encodedLen);
+    EXPECT_EQ(0, memcmp(expected, encoded, sizeof(expected)));
+
+    expectRoundTrip(data, sizeof(data));
+}
+
+TEST(PackbitsTest, TestIncompressible)
+{
+    uint8_t data[1024];
+    uint32_t state = 12345;
+    for (size_t i = 0; i < sizeof(data); i++) {
+        state = state * 1103515245 + 12345;
+        data[i] = state >> 16;
+    }
+
+    expectRoundTrip(data, sizeof(data));
+
+    // Output must be refused rather than overflow a buffer that is too small
+    uint8_t encoded[sizeof(data)];
+    EXPECT_EQ(-1, packbitsEncode(data, sizeof(data), encoded, sizeof(encoded)));
+}
+
+TEST(PackbitsTest, TestDecodeErrors)
+{
+    uint8_t decoded[8];
+
+    // Literal block runs past the end of the input
+    const uint8_t truncated[] = { 3, 1, 2 };
+    EXPECT_EQ(-1, packbitsDecode(truncated, sizeof(truncated), decoded, sizeof(decoded)));
+
+    // Run doesn't fit in the output
+    const uint8_t tooLong[] = { 0xF0, 1 };
+    EXPECT_EQ(-1, packbitsDecode(tooLong, sizeof(tooLong), decoded, sizeof(decoded)));
+
+    // No-op control bytes are skipped
+    const uint8_t noop[] = { 0x80, 0xFF, 5 };
+    EXPECT_EQ(2, packbitsDecode(noop, sizeof(noop), decoded, sizeof(decoded)));
+    EXPECT_EQ(5, decoded[0]);
+    EXPECT_EQ(5, decoded[1]);
+}
@@ -0,0 +1,152 @@
+/*
+ * This file is part of INAV.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "unittest_macros.h"
+
+#include "programming/logic_condition_order.h"
+
+class LogicConditionOrderTest : public ::testing::Test {
+protected:
+    logicCondition_t conditions[MAX_LOGIC_CONDITIONS];
+    uint8_t order[MAX_LOGIC_CONDITIONS];
+    uint8_t staleCount;
+
+    void SetUp() override
+    {
+        memset(conditions, 0, sizeof(conditions));
+        for (int i = 0; i < MAX_LOGIC_CONDITIONS; i++) {
+            conditions[i].activatorId = -1;
+        }
+    }
+
+    void enable(int i, int activatorId = -1)
+    {
+        conditions[i].enabled = 1;
+        conditions[i].activatorId = activatorId;
+        conditions[i].operation = LOGIC_CONDITION_TRUE;
+    }
+
+    void readLc(int i, int lc)
+    {
+        conditions[i].operandA.type = LOGIC_CONDITION_OPERAND_TYPE_LC;
+        conditions[i].operandA.value = lc;
+    }
+
+    int position(int index, uint8_t count)
+    {
+        for (int i = 0; i < count; i++) {
+            if (order[i] == index) {
+                return i;
+            }
+        }
+        return -1;
+    }
+};
+
+TEST_F(LogicConditionOrderTest, EmptyProgram)
+{
+    EXPECT_EQ(0, logicConditionBuildEvaluationOrder(conditions, MAX_LOGIC_CONDITIONS, order, &staleCount));
+    EXPECT_EQ(0, staleCount);
+}
+
+TEST_F(LogicConditionOrderTest, SkipsDisabledAndKeepsIndexOrder)
+{
+    enable(2);
+    enable(5, 2);
+    enable(9);
+    readLc(9, 5);
+
+    const uint8_t count = logicConditionBuildEvaluationOrder(conditions, MAX_LOGIC_CONDITIONS, order, &staleCount);
+
+    ASSERT_EQ(3, count);
+    EXPECT_EQ(2, order[0]);
+    EXPECT_EQ(5, order[1]);
+    EXPECT_EQ(9, order[2]);
+    EXPECT_EQ(0, staleCount);
+}
+
+TEST_F(LogicConditionOrderTest, ForwardReferencesComeFirst)
+{
+    // 0 reads 3 through its activator, 1 reads 4 through operand B, 3 reads 4 through operand A
+    enable(0, 3);
+    enable(1);
+    conditions[1].operandB.type = LOGIC_CONDITION_OPERAND_TYPE_LC;
+    conditions[1].operandB.value = 4;
+    enable(3);
+    readLc(3, 4);
+    enable(4);
+
+    const uint8_t count = logicConditionBuildEvaluationOrder(conditions, MAX_LOGIC_CONDITIONS, order, &staleCount);
+
+    ASSERT_EQ(4, count);
+    EXPECT_LT(position(4, count), position(3, count));
+    EXPECT_LT(position(4, count), position(1, count));
+    EXPECT_LT(position(3, count), position(0, count));
+    EXPECT_EQ(0, staleCount);
+}
+
+TEST_F(LogicConditionOrderTest, IgnoresSelfAndDisabledReferences)
+{
+    enable(0);
+    readLc(0, 0);       // Reads its own previous value, e.g. a counter
+    enable(1, 7);       // Activator is disabled, always false
+    enable(2);
+    readLc(2, 100);     // Out of range
+
+    const uint8_t count = logicConditionBuildEvaluationOrder(conditions, MAX_LOGIC_CONDITIONS, order, &staleCount);
+
+    ASSERT_EQ(3, count);
+    EXPECT_EQ(0, order[0]);
+    EXPECT_EQ(1, order[1]);
+    EXPECT_EQ(2, order[2]);
+    EXPECT_EQ(0, staleCount);
+}
+
+TEST_F(LogicConditionOrderTest, BreaksLoopsAtLowestIndex)
+{
+    enable(1);
+    readLc(1, 6);
+    enable(6, 1);
+    enable(8, 6);
+
+    const uint8_t count = logicConditionBuildEvaluationOrder(conditions, MAX_LOGIC_CONDITIONS, order, &staleCount);
+
+    ASSERT_EQ(3, count);
+    EXPECT_EQ(1, order[0]);
+    EXPECT_EQ(6, order[1]);
+    EXPECT_EQ(8, order[2]);
+    EXPECT_EQ(1, staleCount);
+}
+
+TEST_F(LogicConditionOrderTest, LongChainInReverseOrder)
+{
+    for (int i = 0; i < MAX_LOGIC_CONDITIONS; i++) {
+        enable(i, i + 1 < MAX_LOGIC_CONDITIONS ? i + 1 : -1);
+    }
+
+    const uint8_t count = logicConditionBuildEvaluationOrder(conditions, MAX_LOGIC_CONDITIONS, order, &staleCount);
+
+    ASSERT_EQ(MAX_LOGIC_CONDITIONS, count);
+    for (int i = 0; i < MAX_LOGIC_CONDITIONS; i++) {
+        EXPECT_EQ(MAX_LOGIC_CONDITIONS - 1 - i, order[i]);
+    }
+    EXPECT_EQ(0, staleCount);
+}
@@ -0,0 +1,149 @@
+/*
+ * This file is part of INAV.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+
+#include "gtest/gtest.h"
+#include "unittest_macros.h"
+
+#include "telemetry/crsf_scheduler.h"
+
+enum {
+    FRAME_ATTITUDE = 0,
+    FRAME_BATTERY,
+    FRAME_FLIGHT_MODE,
+    FRAME_COUNT
+};
+
+static void setupScheduler(crsfScheduler_t *scheduler)
+{
+    crsfSchedulerInit(scheduler, 0);
+    crsfSchedulerConfigureFrame(scheduler, FRAME_ATTITUDE, 200, CRSF_SCHEDULER_PRIORITY_HIGH);
+    crsfSchedulerConfigureFrame(scheduler, FRAME_BATTERY, 50, CRSF_SCHEDULER_PRIORITY_LOW);
+    crsfSchedulerConfigureFrame(scheduler, FRAME_FLIGHT_MODE, 20, CRSF_SCHEDULER_PRIORITY_LOW);
+}
+
+// Runs the scheduler for durationUs, polling every 1ms, and counts frames sent
+static void runScheduler(crsfScheduler_t *scheduler, timeUs_t *timeUs, timeUs_t durationUs, int counts[FRAME_COUNT])
+{
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        counts[i] = 0;
+    }
+
+    const timeUs_t endUs = *timeUs + durationUs;
+    while (*timeUs < endUs) {
+        *timeUs += 1000;
+        const int index = crsfSchedulerNext(scheduler, *timeUs);
+        if (index >= 0) {
+            ASSERT_LT(index, FRAME_COUNT);
+            counts[index]++;
+        }
+    }
+}
+
+TEST(CrsfSchedulerTest, SlotIntervalFollowsFramePeriod)
+{
+    // Crossfire 4Hz, 50Hz and 150Hz
+    EXPECT_EQ(CRSF_SCHEDULER_SLOT_US_MAX, crsfSchedulerSlotIntervalForFramePeriod(250000));
+    EXPECT_EQ(50000u, crsfSchedulerSlotIntervalForFramePeriod(20000));
+    EXPECT_EQ(CRSF_SCHEDULER_SLOT_US_MIN, crsfSchedulerSlotIntervalForFramePeriod(6667));
+
+    // ELRS 25Hz and 100Hz sit in between, 500Hz and F1000 are limited to the shortest spacing
+    EXPECT_EQ(100000u, crsfSchedulerSlotIntervalForFramePeriod(40000));
+    EXPECT_EQ(25000u, crsfSchedulerSlotIntervalForFramePeriod(10000));
+    EXPECT_EQ(CRSF_SCHEDULER_SLOT_US_MIN, crsfSchedulerSlotIntervalForFramePeriod(2000));
+    EXPECT_EQ(CRSF_SCHEDULER_SLOT_US_MIN, crsfSchedulerSlotIntervalForFramePeriod(1000));
+
+    // Nothing measured yet
+    EXPECT_EQ(CRSF_SCHEDULER_SLOT_US_MIN, crsfSchedulerSlotIntervalForFramePeriod(0));
+}
+
+TEST(CrsfSchedulerTest, TargetRatesMetWithFullLink)
+{
+    crsfScheduler_t scheduler;
+    timeUs_t timeUs = 0;
+    int counts[FRAME_COUNT];
+
+    setupScheduler(&scheduler);
+    runScheduler(&scheduler, &timeUs, 10000000, counts);
+
+    EXPECT_NEAR(200, counts[FRAME_ATTITUDE], 10);
+    EXPECT_NEAR(50, counts[FRAME_BATTERY], 3);
+    EXPECT_NEAR(20, counts[FRAME_FLIGHT_MODE], 2);
+}
+
+TEST(CrsfSchedulerTest, AttitudeKeepsMostSlotsOnSlowLink)
+{
+    crsfScheduler_t scheduler;
+    timeUs_t timeUs = 0;
+    int counts[FRAME_COUNT];
+
+    setupScheduler(&scheduler);
+    crsfSchedulerSetSlotInterval(&scheduler, crsfSchedulerSlotIntervalForFramePeriod(250000));
+    runScheduler(&scheduler, &timeUs, 20000000, counts);
+
+    // 4 slots per second, attitude gets the biggest share but the others still get through
+    const int total = counts[FRAME_ATTITUDE] + counts[FRAME_BATTERY] + counts[FRAME_FLIGHT_MODE];
+    EXPECT_NEAR(80, total, 1);
+    EXPECT_GT(counts[FRAME_ATTITUDE], counts[FRAME_BATTERY]);
+    EXPECT_GT(counts[FRAME_ATTITUDE], counts[FRAME_FLIGHT_MODE]);
+    EXPECT_GT(counts[FRAME_BATTERY], 0);
+    EXPECT_GT(counts[FRAME_FLIGHT_MODE], 0);
+}
+
+TEST(CrsfSchedulerTest, ChangedFrameSentFirst)
+{
+    crsfScheduler_t scheduler;
+    timeUs_t timeUs = 0;
+    int counts[FRAME_COUNT];
+
+    setupScheduler(&scheduler);
+    runScheduler(&scheduler, &timeUs, 1000000, counts);
+
+    crsfSchedulerMarkChanged(&scheduler, FRAME_FLIGHT_MODE);
+
+    int index = -1;
+    while (index < 0) {
+        timeUs += 1000;
+        index = crsfSchedulerNext(&scheduler, timeUs);
+    }
+    EXPECT_EQ(FRAME_FLIGHT_MODE, index);
+}
+
+TEST(CrsfSchedulerTest, SlotSpacingRespected)
+{
+    crsfScheduler_t scheduler;
+
+    setupScheduler(&scheduler);
+    EXPECT_GE(crsfSchedulerNext(&scheduler, CRSF_SCHEDULER_SLOT_US_MIN), 0);
+    EXPECT_EQ(-1, crsfSchedulerNext(&scheduler, CRSF_SCHEDULER_SLOT_US_MIN + 1000));
+    EXPECT_GE(crsfSchedulerNext(&scheduler, 2 * CRSF_SCHEDULER_SLOT_US_MIN), 0);
+}
+
+TEST(CrsfSchedulerTest, AchievedRateReported)
+{
+    crsfScheduler_t scheduler;
+    timeUs_t timeUs = 0;
+    int counts[FRAME_COUNT];
+
+    setupScheduler(&scheduler);
+    runScheduler(&scheduler, &timeUs, 3000000, counts);
+
+    EXPECT_NEAR(200, scheduler.frames[FRAME_ATTITUDE].achievedRateDeciHz, 10);
+    EXPECT_NEAR(50, scheduler.frames[FRAME_BATTERY].achievedRateDeciHz, 10);
+    EXPECT_EQ(0, scheduler.frames[FRAME_COUNT].achievedRateDeciHz);
+}